@@ -35,7 +35,7 @@
  * This typedef defines a function pointer type 'queries_func' used to represent query functions.
  * These functions represent the implementation of the query itself.
  */
-typedef void* (*queries_func)(MANAGER catalog, char** query_args);
+typedef RESULT (*queries_func)(MANAGER catalog, char** query_args);
 
 /**
  * @brief Parse and execute a query based on input line.
@@ -46,24 +46,36 @@ typedef void* (*queries_func)(MANAGER catalog, char** query_args);
  * @param stats The statistics data.
  * @param line The input line containing the query identifier and arguments.
  *
- * @return A pointer to the result data of the executed query function. The type of data returned may vary and should be cast to the appropriate type.
+ * @return The typed result of the executed query function, or NULL if there is nothing to output.
  *
  * @note This function allocates memory for the 'query_args' array, which should be freed after query execution. The query identifier is expected to be a single character ('1', '2', '3', etc.).
  */
 
-void* parser_query(MANAGER catalog,  char* line);
+RESULT parser_query(MANAGER catalog,  char* line);
+
+/**
+ * @brief Get the identifier of the output mode of a query line.
+ *
+ * @param line The input line containing the query identifier and arguments.
+ * @return The query number, plus 10 when the query has the flag 'F'.
+ */
+int get_query_id(char* line);
 
 /**
  * @brief Executes queries read from a file, writes results to output files, and frees resources.
  *
  * This function reads queries from a file, parses and executes them storing their result in a 
- * corresponding output file.
+ * corresponding output file, or in the packed archive, through an output sink that writes them in batches.
  * Frees any allocated memory.
+ * With flag 1, the time (and the hardware counters, when available) of each query family is appended to
+ * the analysis file; in a PERF=1 build this table is appended with flag 0 as well. The allocations of each subsystem are appended to it when they are being counted.
  *
  * @param manager_catalog The catalog manager containing a catalog for each entity type(users, flights, reservations and passengers).
  * @param path2 The path to the file containing queries to be executed.
- * @return 0 on success, -1 on failure.
+ * @param flag 1 to record the time of each query in the analysis file, 0 otherwise.
+ * @param mode The output mode.
+ * @return The number of commands plus one on success, -1 on failure.
  */
-int execute_queries(MANAGER manager_catalog, char* path2, int flag);
+int execute_queries(MANAGER manager_catalog, char* path2, int flag, OUTPUT_MODE mode);
 
 #endif
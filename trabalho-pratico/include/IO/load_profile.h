@@ -0,0 +1,117 @@
+/**
+ * @file load_profile.h
+ * @brief This file contains the definition of the dataset load profile.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef LOAD_PROFILE_H
+#define LOAD_PROFILE_H
+
+#include <stddef.h>
+
+/**
+ * @brief Path where the load profile is written.
+ */
+#define LOAD_PROFILE_PATH "Resultados/load_profile.json"
+
+/**
+ * @typedef LOAD_PROFILE
+ * @brief A pointer to the profile of a whole dataset load.
+ */
+typedef struct load_profile *LOAD_PROFILE;
+
+/**
+ * @typedef LOAD_PHASE
+ * @brief A pointer to one phase of a load, such as parsing one of the files or loading the snapshot.
+ */
+typedef struct load_phase *LOAD_PHASE;
+
+/**
+ * @enum load_step
+ * @brief The steps each row of a file goes through.
+ *
+ * Each row is only timed step by step in builds with LOAD_STEPS=1, the other builds time whole phases.
+ */
+typedef enum load_step {
+    LOAD_READ,     /**< Reading the line from the file. */
+    LOAD_TOKENIZE, /**< Splitting the line into fields. */
+    LOAD_VALIDATE, /**< Checking the fields. */
+    LOAD_BUILD,    /**< Building the entity and inserting it in the catalog, or writing the error line. */
+    LOAD_N_STEPS   /**< Number of steps. */
+} LOAD_STEP;
+
+/**
+ * @brief Create an empty load profile, starting its clock.
+ *
+ * @return The load profile.
+ */
+LOAD_PROFILE create_load_profile(void);
+
+/**
+ * @brief Start a new phase of a load.
+ *
+ * @param profile The load profile.
+ * @param name The name of the phase.
+ * @return The phase, owned by the profile.
+ */
+LOAD_PHASE begin_load_phase(LOAD_PROFILE profile, const char* name);
+
+/**
+ * @brief Add the time spent in one of the steps of a phase.
+ *
+ * @param phase The phase.
+ * @param step The step.
+ * @param seconds The time spent.
+ */
+void add_load_step_time(LOAD_PHASE phase, LOAD_STEP step, double seconds);
+
+/**
+ * @brief Add rows read in a phase.
+ *
+ * @param phase The phase.
+ * @param accepted The number of rows inserted in the catalogs.
+ * @param rejected The number of rows written to the error file.
+ * @param bytes The number of bytes read.
+ */
+void add_load_rows(LOAD_PHASE phase, long accepted, long rejected, size_t bytes);
+
+/**
+ * @brief End a phase, recording its total time, its hardware counters (when available) and the peak RSS
+ * of the process at that point.
+ *
+ * @param phase The phase.
+ */
+void end_load_phase(LOAD_PHASE phase);
+
+/**
+ * @brief Write a load profile as JSON.
+ *
+ * @param profile The load profile.
+ * @param path The path of the file.
+ * @return 0 on success, -1 if the file could not be written.
+ */
+int write_load_profile(LOAD_PROFILE profile, const char* path);
+
+/**
+ * @brief Free a load profile and its phases.
+ *
+ * @param profile The load profile.
+ */
+void free_load_profile(LOAD_PROFILE profile);
+
+#endif
@@ -23,229 +23,115 @@
 #define OUTPUT_H
 
 #include "utils/utils.h"
+#include "IO/result.h"
 
 #include <stdio.h>
 
 /**
- * @typedef output_query_func
- * @brief Function pointer type for outputting query results to a file.
- *
- * This typedef defines a function pointer type 'output_query_func'
- * that represents a function used to output query results to a file.
+ * @brief Number of buffered bytes after which the outputs are written to disk.
  */
-typedef void (*output_query_func)(FILE*, void*);
+#define OUTPUT_BATCH_SIZE (1 << 20)
 
 /**
- * @brief Output the result of a specific query to a file.
- *
- * This function outputs the result of a specific query to a file based on the provided query identifier.
- *
- * @param output_file The file where the query result will be written.
- * @param output A pointer to the query result data.
- * @param query_id The identifier of the query to determine which output function to use.
- *
- * @note If the 'output' parameter is NULL, no output is performed.
+ * @brief Number of buffered commands after which the outputs are written to disk.
  */
-void output_query(FILE* output_file, void* output, int query_id);
+#define OUTPUT_BATCH_COMMANDS 32
 
 /**
- * @brief Output the result of query 1 to a file.
- *
- * This function is responsible for outputting the result of query 1 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @brief Path of the archive written in packed output mode.
  */
-void output_query1(FILE* file, void* output);
+#define OUTPUT_PACK_PATH "Resultados/outputs.pack"
 
 /**
- * @brief Output the result of query 1 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 1 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @brief Magic number at the start of a packed output archive.
  */
-void output_query1F(FILE* file, void* output);
+#define OUTPUT_PACK_MAGIC "FQSPACK1"
 
 /**
- * @brief Output the result of query 2 to a file.
- *
- * This function is responsible for outputting the result of query 2 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @typedef OUTPUT_SINK
+ * @brief A pointer to the destination of the outputs of a sequence of commands.
  */
-void output_query2(FILE* file, void* output);
+typedef struct output_sink *OUTPUT_SINK;
 
 /**
- * @brief Output the result of query 2 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 2 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @enum output_mode
+ * @brief Where the outputs of the commands end up.
  */
-void output_query2F(FILE* file, void* output);
+typedef enum output_mode {
+    OUTPUT_FILES,  /**< One Resultados/commandN_output.txt file per command. */
+    OUTPUT_PACKED  /**< A single indexed archive, see unpack_outputs. */
+} OUTPUT_MODE;
 
 /**
- * @brief Output the result of query 3 to a file.
- *
- * This function is responsible for outputting the result of query 3 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query3(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 3 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 3 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query3F(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 4 to a file.
- *
- * This function is responsible for outputting the result of query 4 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query4(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 4 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 4 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query4F(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 5 to a file.
- *
- * This function is responsible for outputting the result of query 5 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query5(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 5 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 5 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query5F(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 6 to a file.
- *
- * This function is responsible for outputting the result of query 6 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query6(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 6 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 6 to a specified file, with format 'field: value'.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query6F(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 7 to a file.
- *
- * This function is responsible for outputting the result of query 7 to a specified file.
+ * @typedef output_query_func
+ * @brief Function pointer type for outputting query results to a file.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * This typedef defines a function pointer type 'output_query_func'
+ * that represents a function used to output query results to a file.
+ * There is one per output mode, every query shares it.
  */
-void output_query7(FILE* file, void* output);
+typedef void (*output_query_func)(FILE*, RESULT);
 
 /**
- * @brief Output the result of query 7 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 7 to a specified file, with format 'field: value'.
+ * @brief Output the result of a specific query to a file.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
- */
-void output_query7F(FILE* file, void* output);
-
-/**
- * @brief Output the result of query 8 to a file.
+ * This function outputs the result of a specific query to a file based on the provided query identifier.
+ * Identifiers above 10 are the queries with flag 'F', written as "--- n ---" blocks with "field: value" lines,
+ * the others are written as one line per row with fields separated by ';'.
  *
- * This function is responsible for outputting the result of query 8 to a specified file.
+ * @param output_file The file where the query result will be written.
+ * @param output The query result.
+ * @param query_id The identifier of the query to determine which output mode to use.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @note If the 'output' parameter is NULL, no output is performed.
  */
-void output_query8(FILE* file, void* output);
+void output_query(FILE* output_file, RESULT output, int query_id);
 
 /**
- * @brief Output the result of query 8 with flag 'F' to a file.
+ * @brief Create a sink for the outputs of a sequence of commands.
  *
- * This function is responsible for outputting the result of query 8 to a specified file, with format 'field: value'.
+ * Outputs are kept in a single memory buffer, reused by every batch, and written to disk once
+ * OUTPUT_BATCH_COMMANDS commands or OUTPUT_BATCH_SIZE bytes are buffered, and when the sink is closed.
+ * A crash loses at most the outputs of the batch being buffered.
+ * In packed mode the archive is created at OUTPUT_PACK_PATH and has the layout:
+ * magic (8 bytes), number of commands and table offset (8 bytes each), the payload
+ * and, at the table offset, one (offset, length) pair of 8 byte integers per command.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @param mode The output mode.
+ * @return The new sink, or NULL if the archive could not be created.
  */
-void output_query8F(FILE* file, void* output);
+OUTPUT_SINK create_output_sink(OUTPUT_MODE mode);
 
 /**
- * @brief Output the result of query 9 to a file.
+ * @brief Start the output of the next command.
  *
- * This function is responsible for outputting the result of query 9 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @param sink The output sink.
+ * @return The stream where the output of the command must be written, valid until end_output.
  */
-void output_query9(FILE* file, void* output);
+FILE* begin_output(OUTPUT_SINK sink);
 
 /**
- * @brief Output the result of query 9 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 9 to a specified file, with format 'field: value'.
+ * @brief Finish the output of the current command, writing the batch to disk if it is full.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @param sink The output sink.
  */
-void output_query9F(FILE* file, void* output);
+void end_output(OUTPUT_SINK sink);
 
 /**
- * @brief Output the result of query 10 to a file.
+ * @brief Write every pending output, close the sink and free it.
  *
- * This function is responsible for outputting the result of query 10 to a specified file.
- *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @param sink The output sink.
+ * @return 0 on success, -1 if any output could not be written.
  */
-void output_query10(FILE* file, void* output);
+int close_output_sink(OUTPUT_SINK sink);
 
 /**
- * @brief Output the result of query 10 with flag 'F' to a file.
- *
- * This function is responsible for outputting the result of query 10 to a specified file, with format 'field: value'.
+ * @brief Split a packed output archive into Resultados/commandN_output.txt files.
  *
- * @param file The file where the query result will be written.
- * @param output A pointer to the query result data.
+ * @param archive_path The path of the archive.
+ * @param command The command to extract (starting at 1), or 0 to extract all of them.
+ * @return The number of files written, or -1 if the archive is not valid.
  */
-void output_query10F(FILE* file, void* output);
+int unpack_outputs(const char* archive_path, int command);
 
 #endif
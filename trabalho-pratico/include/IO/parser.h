@@ -24,6 +24,8 @@
 
 #include <stdio.h>
 
+#include "IO/load_profile.h"
+
 typedef int (*void_function)(char**, void*);
 
 /**
@@ -31,14 +33,17 @@ typedef int (*void_function)(char**, void*);
  *
  * This function reads data from a file, writes to the error csv,
  * separates the line into fields and verifies for any errors.
+ * The time spent reading, tokenizing, verifying and building is added to the load phase.
  *
  * @param f Pointer to given file
  * @param max_fields Number of attributes of the csv file
- * @param func Function that loads the data into the structs
+ * @param verify Function that verifies the fields of a line
+ * @param build Function that loads the verified data into the structs
  * @param catalog The catalog of the respective file
  * @param error_f Pointer to the error file
+ * @param phase The load phase of the file
 */
-void parseF (FILE* f, int max_fields, void_function func, void *catalog, FILE* error_f);
+void parseF (FILE* f, int max_fields, void_function verify, void_function build, void *catalog, FILE* error_f, LOAD_PHASE phase);
 
 /**
  * @brief Function to parse a line
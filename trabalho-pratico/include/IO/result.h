@@ -0,0 +1,250 @@
+/**
+ * @file result.h
+ * @brief This file contains the definition of the typed query result and its formatters.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+*/
+
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <stdio.h>
+
+/**
+ * @typedef RESULT
+ * @brief A pointer to a typed query result (a table of rows sharing one schema).
+ */
+typedef struct result *RESULT;
+
+/**
+ * @enum field_type
+ * @brief Type of the value stored in a result field.
+ */
+typedef enum field_type {
+    FIELD_INT,      /**< Integer value, written with "%lld". */
+    FIELD_DOUBLE,   /**< Real value, written with three decimal places. */
+    FIELD_STRING,   /**< String owned by the result, freed with it. */
+    FIELD_REF,      /**< String owned by someone else (catalog or literal), never freed. */
+    FIELD_DATE,     /**< Date packed as YYYYMMDD, written as "YYYY/MM/DD". */
+    FIELD_DATETIME  /**< Date and time packed as YYYYMMDDhhmmss, written as "YYYY/MM/DD hh:mm:ss". */
+} FIELD_TYPE;
+
+/**
+ * @brief Create a new empty result.
+ *
+ * The field names are not copied, they must outlive the result (string literals are expected).
+ *
+ * @param n_fields Number of fields of each row.
+ * @param names Names of the fields, used by the 'F' formatter.
+ * @return A new result with no rows.
+ */
+RESULT create_result(int n_fields, const char** names);
+
+/**
+ * @brief Change the name of one field of the result schema.
+ *
+ * @param result The result.
+ * @param field The field index.
+ * @param name The new name (not copied).
+ */
+void set_result_name(RESULT result, int field, const char* name);
+
+/**
+ * @brief Append a new row to the result.
+ *
+ * Every field of the new row starts as a NULL reference.
+ *
+ * @param result The result.
+ * @return The index of the new row.
+ */
+int add_result_row(RESULT result);
+
+/**
+ * @brief Store an integer in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value The value.
+ */
+void set_result_int(RESULT result, int row, int field, long long value);
+
+/**
+ * @brief Store a real number in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value The value.
+ */
+void set_result_double(RESULT result, int row, int field, double value);
+
+/**
+ * @brief Store a string in a field, taking ownership of it.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value A dynamically allocated string, freed together with the result.
+ */
+void set_result_string(RESULT result, int row, int field, char* value);
+
+/**
+ * @brief Store a reference to a string that outlives the result.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value The string, which is never freed by the result.
+ */
+void set_result_ref(RESULT result, int row, int field, const char* value);
+
+/**
+ * @brief Store a packed date (YYYYMMDD) in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value The packed date.
+ */
+void set_result_date(RESULT result, int row, int field, long long value);
+
+/**
+ * @brief Store a packed date and time (YYYYMMDDhhmmss) in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param value The packed date and time.
+ */
+void set_result_datetime(RESULT result, int row, int field, long long value);
+
+/**
+ * @brief Get the number of rows of a result.
+ *
+ * @param result The result.
+ * @return The number of rows (0 if the result is NULL).
+ */
+int get_result_rows(RESULT result);
+
+/**
+ * @brief Get the number of fields of each row.
+ *
+ * @param result The result.
+ * @return The number of fields.
+ */
+int get_result_fields(RESULT result);
+
+/**
+ * @brief Get the name of a field.
+ *
+ * @param result The result.
+ * @param field The field index.
+ * @return The field name.
+ */
+const char* get_result_name(RESULT result, int field);
+
+/**
+ * @brief Get the type of a field of a given row.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @return The field type.
+ */
+FIELD_TYPE get_result_type(RESULT result, int row, int field);
+
+/**
+ * @brief Get the integer (or packed date) stored in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @return The stored integer.
+ */
+long long get_result_int(RESULT result, int row, int field);
+
+/**
+ * @brief Get the real number stored in a field.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @return The stored number.
+ */
+double get_result_double(RESULT result, int row, int field);
+
+/**
+ * @brief Get the string stored in a field, without copying it.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @return The stored string (may be NULL).
+ */
+const char* get_result_string(RESULT result, int row, int field);
+
+/**
+ * @brief Format a single field into a buffer.
+ *
+ * A NULL string is formatted as "False", which is what the outputs expect for missing values.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @param buffer The destination buffer.
+ * @param size The size of the buffer.
+ * @return The number of characters the complete value needs (as snprintf).
+ */
+int format_result_field(RESULT result, int row, int field, char* buffer, int size);
+
+/**
+ * @brief Format a row with its fields separated by ';'.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @return A dynamically allocated string with the formatted row.
+ */
+char* format_result_row(RESULT result, int row);
+
+/**
+ * @brief Write every row of a result, one per line, with fields separated by ';'.
+ *
+ * @param file The destination file.
+ * @param result The result.
+ */
+void write_result(FILE* file, RESULT result);
+
+/**
+ * @brief Write every row of a result in the 'F' format.
+ *
+ * Each row is written as a "--- n ---" block with one "name: value" line per field,
+ * blocks being separated by an empty line.
+ *
+ * @param file The destination file.
+ * @param result The result.
+ */
+void write_result_F(FILE* file, RESULT result);
+
+/**
+ * @brief Free a result and every string it owns.
+ *
+ * @param result The result to be freed (may be NULL).
+ */
+void free_result(RESULT result);
+
+#endif
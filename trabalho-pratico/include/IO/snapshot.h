@@ -0,0 +1,211 @@
+/**
+ * @file snapshot.h
+ * @brief This file contains the definition of the binary catalog snapshot and of its primitives.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <glib.h>
+
+/**
+ * @brief Path of the catalog snapshot.
+ */
+#define SNAPSHOT_PATH "Resultados/catalog.snapshot"
+
+/**
+ * @brief Format version of the snapshot, to be increased whenever the layout of any entity or catalog changes.
+ */
+#define SNAPSHOT_VERSION 3
+
+/**
+ * @brief Number of dataset files a snapshot depends on.
+ */
+#define SNAPSHOT_N_FILES 4
+
+/**
+ * @brief Names of the dataset files a snapshot depends on, in the order they are keyed.
+ */
+#define SNAPSHOT_FILES {"users.csv", "flights.csv", "reservations.csv", "passengers.csv"}
+
+/**
+ * @typedef SNAPSHOT
+ * @brief A pointer to a snapshot mapped in memory, read sequentially.
+ */
+typedef struct snapshot *SNAPSHOT;
+
+/**
+ * @struct snapshot_key
+ * @brief Identifies the contents of a dataset file.
+ */
+typedef struct snapshot_key {
+    int64_t size; /**< File size, -1 if the file does not exist. */
+    int64_t mtime_sec; /**< Modification time, seconds. */
+    int64_t mtime_nsec; /**< Modification time, nanoseconds. */
+    uint64_t hash; /**< FNV-1a hash of the contents, only computed when needed. */
+} SNAPSHOT_KEY;
+
+/**
+ * @brief Turn the catalog snapshot on or off for the rest of the process.
+ *
+ * With the snapshot off, set_catalogs neither restores the catalogs from SNAPSHOT_PATH nor writes
+ * it, so benchmarks and tests always measure a load from the CSV files and leave the snapshot of
+ * the dataset as it was. It is on by default.
+ *
+ * @param enabled 1 to use the snapshot, 0 not to.
+ */
+void set_snapshot_enabled(int enabled);
+
+/**
+ * @brief Whether the catalog snapshot is in use.
+ *
+ * @return 1 if it is, 0 otherwise.
+ */
+int is_snapshot_enabled(void);
+
+/**
+ * @brief Compute the key of each dataset file (size and modification time, hash only if asked for).
+ *
+ * @param path The dataset directory.
+ * @param keys Array of SNAPSHOT_N_FILES keys to fill.
+ * @param with_hash Whether to hash the contents of the files.
+ */
+void get_snapshot_keys(char* path, SNAPSHOT_KEY* keys, int with_hash);
+
+/**
+ * @brief Create a snapshot file, writing its header.
+ *
+ * The snapshot is written to a temporary file, renamed over SNAPSHOT_PATH by close_snapshot_file.
+ *
+ * @param keys The keys of the dataset files (with hashes).
+ * @return The file where the catalogs must be written, or NULL on failure.
+ */
+FILE* create_snapshot_file(SNAPSHOT_KEY* keys);
+
+/**
+ * @brief Finish a snapshot file and make it visible.
+ *
+ * The size of the snapshot and a checksum of everything written after the header are stored in the header.
+ *
+ * @param file The file returned by create_snapshot_file.
+ * @return 0 on success, -1 on failure.
+ */
+int close_snapshot_file(FILE* file);
+
+/**
+ * @brief Map the snapshot in memory if it exists, has the current version and matches the dataset.
+ *
+ * @param path The dataset directory.
+ * @return The snapshot, positioned after the header, or NULL if there is no usable snapshot.
+ */
+SNAPSHOT open_snapshot(char* path);
+
+/**
+ * @brief Check the contents of a snapshot against the checksum in its header.
+ *
+ * @param snapshot The snapshot, just opened.
+ * @return 0 if they match, -1 if the snapshot is corrupted.
+ */
+int verify_snapshot(SNAPSHOT snapshot);
+
+/**
+ * @brief Unmap a snapshot and free it.
+ *
+ * @param snapshot The snapshot.
+ * @return 0 if every read was inside the snapshot, -1 otherwise.
+ */
+int close_snapshot(SNAPSHOT snapshot);
+
+/**
+ * @brief Write an integer to a snapshot file.
+ *
+ * @param file The snapshot file.
+ * @param value The value.
+ */
+void write_snapshot_int(FILE* file, int value);
+
+/**
+ * @brief Write a real number to a snapshot file.
+ *
+ * @param file The snapshot file.
+ * @param value The value.
+ */
+void write_snapshot_double(FILE* file, double value);
+
+/**
+ * @brief Write a string (which may be NULL) to a snapshot file.
+ *
+ * @param file The snapshot file.
+ * @param value The string.
+ */
+void write_snapshot_string(FILE* file, const char* value);
+
+/**
+ * @brief Write a block of bytes to a snapshot file.
+ *
+ * @param file The snapshot file.
+ * @param data The bytes.
+ * @param size The number of bytes.
+ */
+void write_snapshot_bytes(FILE* file, const char* data, size_t size);
+
+/**
+ * @brief Read the next integer of a snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @return The value, 0 past the end of the snapshot.
+ */
+int read_snapshot_int(SNAPSHOT snapshot);
+
+/**
+ * @brief Read the next real number of a snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @return The value, 0 past the end of the snapshot.
+ */
+double read_snapshot_double(SNAPSHOT snapshot);
+
+/**
+ * @brief Read the next string of a snapshot, without copying it.
+ *
+ * @param snapshot The snapshot.
+ * @return A pointer into the mapped snapshot, valid until it is closed, or NULL.
+ */
+const char* read_snapshot_string(SNAPSHOT snapshot);
+
+/**
+ * @brief Read the next string of a snapshot into a new dynamically allocated string.
+ *
+ * @param snapshot The snapshot.
+ * @return The copy of the string, or NULL.
+ */
+char* read_snapshot_strdup(SNAPSHOT snapshot);
+
+/**
+ * @brief Read the next block of bytes of a snapshot, without copying it.
+ *
+ * @param snapshot The snapshot.
+ * @param size Where the number of bytes is stored.
+ * @return A pointer into the mapped snapshot, valid until it is closed.
+ */
+const char* read_snapshot_bytes(SNAPSHOT snapshot, size_t* size);
+
+#endif
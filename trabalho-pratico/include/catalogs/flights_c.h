@@ -31,6 +31,9 @@
 typedef struct flights_catalog *FLIGHTS_C;
 
 #include "entities/flights.h"
+#include "IO/snapshot.h"
+#include "utils/memory_report.h"
+#include "utils/id_map.h"
 
 /**
  * @brief Create a new instance of FLIGHTS_C.
@@ -79,12 +82,12 @@ int* get_flightNumber_c(FLIGHTS_C catalog, char* key);
 FLIGHT get_flight_by_id(FLIGHTS_C catalog, char* id);
 
 /**
- * @brief Retrieves the hash table of flights from the flights catalog.
+ * @brief Retrieves the map of flights from the flights catalog.
  *
  * @param catalog The flights catalog.
- * @return The hash table of flights.
+ * @return The map of flight IDs to flights.
  */
-GHashTable* get_hash_table_flight(FLIGHTS_C catalog);
+ID_MAP get_hash_table_flight(FLIGHTS_C catalog);
 
 /**
  * @brief Updates the number of passengers for a given flight in the flights catalog.
@@ -95,16 +98,61 @@ GHashTable* get_hash_table_flight(FLIGHTS_C catalog);
  */
 void update_flight_c(FLIGHTS_C catalog, char* id);
 
+/**
+ * @brief Gets the scheduled departure day of a flight, even if it was removed for overbooking.
+ *
+ * @param catalog The flights catalog.
+ * @param id The ID of the flight.
+ * @return The day packed as YYYYMMDD, or 0 if the flight was never in the catalog.
+ */
+int get_flight_day_by_id(FLIGHTS_C catalog, char* id);
+
 /**
  * @brief Removes a flight from the flights catalog.
  *
  * This function removes a flight identified by its ID from the flights catalog.
+ * Its departure day is kept, since it was already counted in the daily statistics.
  *
  * @param flights A pointer to the flights catalog.
  * @param flight_id The ID of the flight to be removed.
  */
 void remove_flight_from_hash_table(FLIGHTS_C flights, char* flight_id);
 
+/**
+ * @brief Write the flight catalog to a catalog snapshot.
+ *
+ * @param catalog The flight catalog.
+ * @param file The snapshot file.
+ */
+void save_flights_c(FLIGHTS_C catalog, FILE* file);
+
+/**
+ * @brief Fill an empty flight catalog from a catalog snapshot.
+ *
+ * @param catalog The flight catalog.
+ * @param snapshot The snapshot.
+ * @return 0 on success, -1 if the snapshot is corrupted.
+ */
+int load_flights_c(FLIGHTS_C catalog, SNAPSHOT snapshot);
+
+/**
+ * @brief Add the memory used by the flight catalog to a memory report, building its lazy indexes first.
+ *
+ * @param catalog The flight catalog.
+ * @param report The memory report.
+ */
+void report_flights_c_memory(FLIGHTS_C catalog, MEMORY_REPORT report);
+
+/**
+ * @brief Freeze the non-canonical flight IDs, which no longer change after the load, into a perfect hash.
+ *
+ * Canonical IDs are already looked up by their number. Inserting or removing a flight with
+ * another ID afterwards drops the perfect hash and goes back to the fallback map.
+ *
+ * @param catalog The flight catalog.
+ */
+void freeze_flights_c(FLIGHTS_C catalog);
+
 /**
  * @brief Free the allocated memory for the flight catalog.
  *
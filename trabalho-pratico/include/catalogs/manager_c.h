@@ -31,6 +31,31 @@ typedef struct manager_catalog *MANAGER;
 #include "catalogs/users_c.h"
 #include "catalogs/passengers_c.h"
 #include "catalogs/reservations_c.h"
+#include "utils/memory_report.h"
+
+/**
+ * @brief Type of the entity an ID belongs to.
+ */
+typedef enum entity_type {
+    ENTITY_USER,        /**< A user. */
+    ENTITY_FLIGHT,      /**< A flight. */
+    ENTITY_RESERVATION  /**< A reservation. */
+} ENTITY_TYPE;
+
+/**
+ * @brief The numeric fields of an entity shown by query 1, computed once when the entity directory is built.
+ */
+typedef struct entity_profile {
+    int active;          /**< Whether a user's account is active, always 1 for the other entities. */
+    int age;             /**< Age of a user. */
+    int flights;         /**< Flights of a user, or passengers of a flight. */
+    int reservations;    /**< Reservations of a user. */
+    int delay;           /**< Delay of a flight, in seconds. */
+    int nights;          /**< Nights of a reservation. */
+    double total;        /**< Total spent by a user, or total price of a reservation. */
+    long long begin;     /**< Packed schedule departure of a flight, or begin date of a reservation. */
+    long long end;       /**< Packed schedule arrival of a flight, or end date of a reservation. */
+} ENTITY_PROFILE;
 
 /**
  * @brief Create a new manager catalog.
@@ -75,6 +100,62 @@ RESERV_C get_reserv_c(MANAGER catalog);
  */
 PASS_C get_pass_c(MANAGER catalog);
 
+/**
+ * @brief Resolve any ID to its entity with a single lookup in the entity directory.
+ *
+ * The directory is built the first time it is needed, after the catalogs are loaded. Following
+ * query 1, an ID made only of digits is a flight and one starting with "Book" is a reservation, and
+ * these take precedence over a user with the same ID.
+ *
+ * @param catalog The manager catalog.
+ * @param id The ID.
+ * @param type Where the type of the entity is stored.
+ * @param handle Where the entity (USER, FLIGHT or RESERV) is stored.
+ * @return The profile of the entity, owned by the catalog, or NULL if no entity has the ID.
+ */
+const ENTITY_PROFILE* get_entity_c(MANAGER catalog, char* id, ENTITY_TYPE* type, void** handle);
+
+/**
+ * @brief Freeze the IDs of the user, flight and reservation catalogs into perfect hashes once they are loaded.
+ *
+ * @param catalog The manager catalog.
+ */
+void freeze_manager_c(MANAGER catalog);
+
+/**
+ * @brief Write every catalog of a manager catalog to a catalog snapshot.
+ *
+ * @param catalog The manager catalog.
+ * @param file The snapshot file.
+ */
+void save_manager_c(MANAGER catalog, FILE* file);
+
+/**
+ * @brief Fill the (empty) catalogs of a manager catalog from a catalog snapshot.
+ *
+ * @param catalog The manager catalog.
+ * @param snapshot The snapshot.
+ * @return 0 on success, -1 if the snapshot is corrupted.
+ */
+int load_manager_c(MANAGER catalog, SNAPSHOT snapshot);
+
+/**
+ * @brief Replace the catalogs of a manager catalog with empty ones, dropping whatever they held.
+ *
+ * Used when a snapshot turns out to be corrupted halfway through being loaded.
+ *
+ * @param catalog The manager catalog.
+ */
+void reset_manager_c(MANAGER catalog);
+
+/**
+ * @brief Add the memory used by every catalog of a manager catalog to a memory report.
+ *
+ * @param catalog The manager catalog.
+ * @param report The memory report.
+ */
+void report_manager_c_memory(MANAGER catalog, MEMORY_REPORT report);
+
 /**
  * @brief Free the memory allocated for a manager catalog.
  *
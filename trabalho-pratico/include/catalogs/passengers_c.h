@@ -24,6 +24,7 @@
 
 
 #include <glib.h>
+#include <stdint.h>
 
 /**
  * @typedef PASS_C
@@ -32,6 +33,8 @@
 typedef struct passengers_catalog *PASS_C;
 
 #include "utils/utils.h"
+#include "IO/snapshot.h"
+#include "utils/memory_report.h"
 
 /**
  * @brief Creates a new passengers catalog.
@@ -40,50 +43,101 @@ typedef struct passengers_catalog *PASS_C;
 PASS_C create_passengers_c(void);
 
 /**
- * @brief Inserts a flight ID into the array of flights associated with a user in the passengers catalog.
+ * @brief Inserts a passenger, a user on a flight, into the passengers catalog.
  *
- * @param flight_id The flight ID to be inserted.
+ * Each user and flight ID is copied only the first time it is seen.
+ *
+ * @param flight_id The flight ID.
  * @param catalog The passengers catalog.
- * @param key The key (user ID) to associate with the flight in the hash table.
+ * @param key The user ID.
  */
 void insert_pass_user_c(char* flight_id, PASS_C catalog, char* key);
 
 /**
- * @brief Inserts a passenger into the passengers catalog for a given key.
+ * @brief Retrieves the users that flew on a given day.
+ *
+ * The users of each day are built from the flights of each user the first time they are used.
  *
  * @param catalog The passengers catalog structure.
- * @param key The key under which the passenger should be stored in the catalog.
- * @param user The user to be added to the catalog.
+ * @param flights The flights catalog, used to find the day of each flight.
+ * @param key The day, as YYYYMMDD.
+ * @param count Where the number of passengers of the day is stored.
+ * @return The index of the user of each passenger, owned by the catalog (see get_pass_user_id_c).
+ *         Returns NULL if nobody flew on that day.
  */
-void insert_passengers_c(PASS_C catalog, char* key, char* user);
+const uint32_t* get_passengers_c(PASS_C catalog, FLIGHTS_C flights, char* key, uint32_t* count);
 
 /**
- * @brief Retrieves the array of passengers for a given key from the passengers catalog.
+ * @brief Retrieves the flights of a user.
  *
- * @param catalog The passengers catalog structure.
- * @param key The key for which the array of passengers should be retrieved.
- * @return A pointer to a GPtrArray representing the array of passengers.
- *         Returns NULL if the key is not found in the catalog.
+ * @param catalog The passengers catalog.
+ * @param id The user ID.
+ * @param count Where the number of flights is stored.
+ * @return The index of each flight, owned by the catalog (see get_pass_flight_id_c).
+ *         Returns NULL if the user has no flights.
  */
-GPtrArray* get_passengers_c(PASS_C catalog, char* key);
+const uint32_t* get_user_flights_c(PASS_C catalog, char* id, uint32_t* count);
 
 /**
- * @brief Retrieves the array of user IDs associated with a flight by flight ID.
+ * @brief Retrieves the number of flights of a user.
  *
  * @param catalog The passengers catalog.
- * @param id The flight ID.
- * @return The array of user IDs if found, or NULL if not found.
+ * @param id The user ID.
+ * @return The number of flights, 0 if the user has none.
  */
-GPtrArray* get_user_array_by_id(PASS_C catalog, char* id);
+int get_user_array_number_id(PASS_C catalog, char* id);
 
 /**
- * @brief Retrieves the number of user IDs associated with a flight by flight ID.
+ * @brief Retrieves the ID of a user index.
  *
  * @param catalog The passengers catalog.
- * @param id The flight ID.
- * @return The number of user IDs if found, or 0 if not found.
+ * @param user The user index.
+ * @return The user ID, owned by the catalog.
  */
-int get_user_array_number_id(PASS_C catalog, char* id);
+char* get_pass_user_id_c(PASS_C catalog, uint32_t user);
+
+/**
+ * @brief Retrieves the ID of a flight index.
+ *
+ * @param catalog The passengers catalog.
+ * @param flight The flight index.
+ * @return The flight ID, owned by the catalog.
+ */
+char* get_pass_flight_id_c(PASS_C catalog, uint32_t flight);
+
+/**
+ * @brief Retrieves the number of user indexes, which are all below it.
+ *
+ * @param catalog The passengers catalog.
+ * @return The number of users with flights.
+ */
+uint32_t get_pass_n_users_c(PASS_C catalog);
+
+/**
+ * @brief Write the passenger catalog to a catalog snapshot.
+ *
+ * @param catalog The passenger catalog.
+ * @param file The snapshot file.
+ */
+void save_passengers_c(PASS_C catalog, FILE* file);
+
+/**
+ * @brief Fill an empty passenger catalog from a catalog snapshot.
+ *
+ * @param catalog The passenger catalog.
+ * @param snapshot The snapshot.
+ * @return 0 on success, -1 if the snapshot is corrupted.
+ */
+int load_passengers_c(PASS_C catalog, SNAPSHOT snapshot);
+
+/**
+ * @brief Add the memory used by the passenger catalog to a memory report, building its lazy indexes first.
+ *
+ * @param catalog The passenger catalog.
+ * @param flights The flight catalog, where the departure days of the passengers index are looked up.
+ * @param report The memory report.
+ */
+void report_passengers_c_memory(PASS_C catalog, FLIGHTS_C flights, MEMORY_REPORT report);
 
 /**
  * @brief Frees the memory used by the passengers catalog.
@@ -22,9 +22,18 @@
 #define RESERVATIONS_C_H
 
 #include "entities/reservations.h"
+#include "IO/snapshot.h"
+#include "utils/memory_report.h"
+#include "utils/id_map.h"
+#include "utils/index_builder.h"
 
 #include <glib.h>
 
+/**
+ * @brief Highest rating of a reservation.
+ */
+#define HOTEL_MAX_RATING 5
+
 /**
  * @typedef RESERV_C
  * @brief A pointer to a reservations catalog.
@@ -47,22 +56,22 @@ RESERV_C create_reservations_c(void);
 void insert_reservations_c(RESERV reserv, RESERV_C catalog, char* key);
 
 /**
- * @brief Inserts a reservation ID into the user's reservations array in the reservations catalog.
+ * @brief Records a reservation of a user while the user index is being built.
  *
- * @param reserv_id The reservation ID to be inserted.
+ * @param reserv The position of the reservation (see get_reservation_at_c).
  * @param catalog The reservations catalog.
- * @param key The key (user ID) to associate with the reservation in the hash table.
+ * @param key The user ID, borrowed from the reservation.
  */
-void insert_usersReservations_c(char* reserv_id, RESERV_C catalog, char* key);
+void insert_usersReservations_c(uint32_t reserv, RESERV_C catalog, char* key);
 
 /**
- * @brief Inserts a hotel reservation ID into the hotel reservations catalog for a given key.
+ * @brief Records a reservation of a hotel while the hotel index is being built.
  *
- * @param reserv_id The ID of the hotel reservation to be inserted.
- * @param catalog The hotel reservations catalog structure.
- * @param key The key under which the reservation ID should be stored in the catalog.
+ * @param reserv The position of the reservation (see get_reservation_at_c).
+ * @param catalog The reservations catalog.
+ * @param key The hotel ID, borrowed from the reservation.
  */
-void insert_hotelsReservations_c(char* reserv_id, RESERV_C catalog, char* key);
+void insert_hotelsReservations_c(uint32_t reserv, RESERV_C catalog, char* key);
 
 /**
  * @brief Inserts or updates the count of reservations for a given reservation number on a specific day.
@@ -73,6 +82,17 @@ void insert_hotelsReservations_c(char* reserv_id, RESERV_C catalog, char* key);
  */
 void insert_reservNumber_c(RESERV_C catalog, char* key, char* day);
 
+/**
+ * @brief Adds the rating of a reservation to the running aggregates of its hotel.
+ *
+ * Ratings outside 1..HOTEL_MAX_RATING, such as a missing one, register the hotel without being counted.
+ *
+ * @param catalog The reservations catalog.
+ * @param hotel_id The hotel ID, borrowed from the reservation.
+ * @param rating The rating.
+ */
+void insert_hotel_rating_c(RESERV_C catalog, char* hotel_id, int rating);
+
 /**
  * @brief Retrieves the count of reservations for a given reservation number in the reservations catalog.
  *
@@ -102,24 +122,54 @@ RESERV get_reservations_by_id(RESERV_C catalog, char* id);
 RESERV get_reservations_by_id(RESERV_C catalog, char* id);
 
 /**
- * @brief Retrieves the array of reservation IDs associated with a user by user ID.
+ * @brief Retrieves the reservation at a position of the user and hotel indexes.
  *
+ * The positions order every reservation by begin date (most recent first) and then by ID.
+ *
+ * @param catalog The reservations catalog.
+ * @param reserv The position.
+ * @return The reservation.
+ */
+RESERV get_reservation_at_c(RESERV_C catalog, uint32_t reserv);
+
+/**
+ * @brief Retrieves the reservations of a user.
  *
  * @param catalog The reservations catalog.
  * @param user_id The user ID.
- * @return The array of reservation IDs if found, or NULL if not found.
+ * @param count Where the number of reservations is stored.
+ * @return The position of each reservation, owned by the catalog, or NULL if the user has none.
  */
-GPtrArray* get_user_reserv_array_by_id(RESERV_C catalog, char* user_id);
+const uint32_t* get_user_reservations_c(RESERV_C catalog, char* user_id, uint32_t* count);
 
 /**
- * @brief Retrieves the array of hotel reservation IDs for a given hotel ID from the hotel reservations catalog.
+ * @brief Retrieves the reservations of a hotel, sorted by begin date (most recent first) and then by ID.
  *
  * @param catalog The hotel reservations catalog structure.
- * @param hotel_id The ID of the hotel for which the array of reservation IDs should be retrieved.
- * @return A pointer to a GPtrArray representing the array of hotel reservation IDs.
- *         Returns NULL if the hotel ID is not found in the catalog.
+ * @param hotel_id The ID of the hotel for which the reservations should be retrieved.
+ * @param count Where the number of reservations is stored.
+ * @return The position of each reservation, owned by the catalog, or NULL if the hotel has none.
  */
-GPtrArray* get_hotel_reserv_array_by_id(RESERV_C catalog, char* hotel_id);
+const uint32_t* get_hotel_reservations_c(RESERV_C catalog, char* hotel_id, uint32_t* count);
+
+/**
+ * @brief Retrieves the average rating of a hotel from its running aggregates.
+ *
+ * @param catalog The reservations catalog.
+ * @param hotel_id The hotel ID.
+ * @return The average rating, or 0 if the hotel has no rated reservations.
+ */
+double get_hotel_average_rating_c(RESERV_C catalog, char* hotel_id);
+
+/**
+ * @brief Retrieves the number of reservations of a hotel with each rating.
+ *
+ * @param catalog The reservations catalog.
+ * @param hotel_id The hotel ID.
+ * @param histogram Where the counts are stored, HOTEL_MAX_RATING + 1 of them indexed by rating.
+ * @return The number of rated reservations of the hotel.
+ */
+int get_hotel_rating_histogram_c(RESERV_C catalog, char* hotel_id, int* histogram);
 
 /**
  * @brief Retrieves the number of reservation IDs associated with a user by user ID.
@@ -139,12 +189,47 @@ int get_user_array_reserv_id(RESERV_C catalog, char* id);
 int get_number_reserv_id(RESERV_C catalog);
 
 /**
- * @brief Retrieves the hash table containing the reservations catalog.
+ * @brief Retrieves the map containing the reservations catalog.
  *
  * @param catalog The reservations catalog.
- * @return The hash table containing reservation records.
+ * @return The map of reservation IDs to reservation records.
+ */
+ID_MAP get_hash_table_reserv(RESERV_C catalog);
+
+/**
+ * @brief Write the reservation catalog to a catalog snapshot.
+ *
+ * @param catalog The reservation catalog.
+ * @param file The snapshot file.
+ */
+void save_reservations_c(RESERV_C catalog, FILE* file);
+
+/**
+ * @brief Fill an empty reservation catalog from a catalog snapshot.
+ *
+ * @param catalog The reservation catalog.
+ * @param snapshot The snapshot.
+ * @return 0 on success, -1 if the snapshot is corrupted.
+ */
+int load_reservations_c(RESERV_C catalog, SNAPSHOT snapshot);
+
+/**
+ * @brief Add the memory used by the reservation catalog to a memory report, building its lazy indexes first.
+ *
+ * @param catalog The reservation catalog.
+ * @param report The memory report.
+ */
+void report_reservations_c_memory(RESERV_C catalog, MEMORY_REPORT report);
+
+/**
+ * @brief Freeze the non-canonical reservation IDs, which no longer change after the load, into a perfect hash.
+ *
+ * Canonical IDs are already looked up by their number. Inserting a reservation with another ID
+ * afterwards drops the perfect hash and goes back to the fallback map.
+ *
+ * @param catalog The reservation catalog.
  */
-GHashTable* get_hash_table_reserv(RESERV_C catalog);
+void freeze_reservations_c(RESERV_C catalog);
 
 /**
  * @brief Frees the memory used by the reservations catalog.
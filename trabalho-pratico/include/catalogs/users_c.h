@@ -23,6 +23,9 @@
 #define USERS_C_H
 
 #include "entities/users.h"
+#include "IO/snapshot.h"
+#include "utils/memory_report.h"
+#include "utils/perfect_hash.h"
 #include "utils/utils.h"
 
 #include <glib.h>
@@ -87,6 +90,41 @@ USER get_user_by_id(USERS_C catalog, char* id);
  */
 void update_user_c(USERS_C catalog, char* id, double cost);
 
+/**
+ * @brief Write the user catalog to a catalog snapshot.
+ *
+ * @param catalog The user catalog.
+ * @param file The snapshot file.
+ */
+void save_users_c(USERS_C catalog, FILE* file);
+
+/**
+ * @brief Fill an empty user catalog from a catalog snapshot.
+ *
+ * @param catalog The user catalog.
+ * @param snapshot The snapshot.
+ * @return 0 on success, -1 if the snapshot is corrupted.
+ */
+int load_users_c(USERS_C catalog, SNAPSHOT snapshot);
+
+/**
+ * @brief Add the memory used by the user catalog to a memory report, building its lazy indexes first.
+ *
+ * @param catalog The user catalog.
+ * @param report The memory report.
+ */
+void report_users_c_memory(USERS_C catalog, MEMORY_REPORT report);
+
+/**
+ * @brief Freeze the user IDs, which no longer change after the load, into a perfect hash.
+ *
+ * Lookups by ID then take a single probe and key comparison. Inserting or removing a user
+ * afterwards drops the perfect hash and goes back to the hash table.
+ *
+ * @param catalog The user catalog.
+ */
+void freeze_users_c(USERS_C catalog);
+
 /**
  * @brief Free the allocated memory for the user catalog.
  *
@@ -100,8 +138,8 @@ void free_user_c(USERS_C catalog);
  * @brief Retrieves the hash table containing user information from the users catalog.
  *
  * @param catalog The users catalog structure.
- * @return A pointer to the GHashTable containing user information.
+ * @return A pointer to the map containing user information.
  */
-GHashTable* get_hash_table_users(USERS_C catalog);
+STRING_MAP get_hash_table_users(USERS_C catalog);
 
 #endif
@@ -29,6 +29,7 @@
 typedef struct flight *FLIGHT;
 
 #include "IO/input.h"
+#include "IO/snapshot.h"
 #include "utils/utils.h"
 #include <glib.h>
 
@@ -192,6 +193,15 @@ char* get_flight_real_arrival_date(FLIGHT flight);
  */
 int get_flight_nPassengers(FLIGHT flight);
 
+/**
+ * @brief Get the memory used by a flight.
+ *
+ * @param flight The flight.
+ * @param strings Where the bytes of its string payloads are added, except the id, which is the catalog key.
+ * @return The size of its struct.
+ */
+size_t get_flight_memory(FLIGHT flight, size_t* strings);
+
 /**
  * @brief Frees memory associated with a flight struct.
  * @param flight A pointer to the flight struct.
@@ -201,12 +211,13 @@ void free_flight(FLIGHT flight);
 /**
  * @brief Verifies the validity of flight data.
  * @param fields An array of flight data fields.
+ * @param catalog A pointer to the flight catalog (unused).
  * @return 1 if the flight data is valid, 0 otherwise.
  */
-int verify_flight(char** fields);
+int verify_flight(char** fields, void* catalog);
 
 /**
- * @brief Builds a flight struct from flight data fields.
+ * @brief Builds a flight struct from flight data fields already checked by verify_flight.
  * @param flight_fields An array of flight data fields.
  * @param catalog A pointer to the flight catalog.
  * @param stats A pointer to the statistics.
@@ -215,4 +226,27 @@ int verify_flight(char** fields);
  */
 int build_flight(char **flight_fields, void *catalog);
 
+/**
+ * @brief Gets the scheduled departure day of a flight.
+ * @param flight The flight.
+ * @return The day, packed as YYYYMMDD.
+ */
+int get_flight_departure_day(FLIGHT flight);
+
+/**
+ * @brief Writes a flight to a catalog snapshot.
+ * @param flight The flight.
+ * @param file The snapshot file.
+ */
+void save_flight(FLIGHT flight, FILE* file);
+
+/**
+ * @brief Reads the next flight of a catalog snapshot and adds it to the catalog.
+ * @param snapshot The snapshot.
+ * @param catalog A pointer to the respective catalog.
+ *
+ * @return 1 if the flight is added to the catalog 0 if the snapshot is corrupted
+ */
+int load_flight(SNAPSHOT snapshot, void* catalog);
+
 #endif
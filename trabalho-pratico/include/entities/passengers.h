@@ -29,12 +29,15 @@
 /**
  * @brief Verifies the validity of passenger data.
  * @param passengers_fields An array of passenger data fields.
+ * @param catalog A pointer to the manager catalog, whose users and flights are looked up.
  * @return 1 if the passenger data is valid, 0 otherwise.
  */
-int verify_passengers(char** passengers_fields, USERS_C users, FLIGHTS_C flights);
+int verify_passengers(char** passengers_fields, void* catalog);
 
 /**
- * @brief Builds a passenger struct from passenger data fields.
+ * @brief Builds a passenger struct from passenger data fields already checked by verify_passengers.
+ *
+ * The passenger is still rejected if it overbooks its flight, which is then removed.
  * @param passengers_fields An array of passenger data fields.
  * @param catalog A pointer to the manager catalog.
  *
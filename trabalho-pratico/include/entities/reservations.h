@@ -28,9 +28,22 @@
  */
 typedef struct reservations *RESERV;
 
+/**
+ * @enum reserv_index
+ * @brief The secondary indexes of the reservation catalog, built independently on demand.
+ */
+typedef enum reserv_index {
+    RESERV_BY_USER,  /**< Reservations of each user. */
+    RESERV_BY_HOTEL, /**< Reservations of each hotel. */
+    RESERV_BY_DAY,   /**< Number of reservations starting on each day. */
+    RESERV_N_INDEXES /**< Number of indexes. */
+} RESERV_INDEX;
+
 typedef struct users_catalog *USERS_C;
 
+#include "IO/snapshot.h"
 #include <glib.h>
+#include <stdint.h>
 
 /**
  * @brief Creates a new reservation struct with default values.
@@ -192,6 +205,15 @@ double get_cost(RESERV res);
  */
 int get_price_per_night(RESERV res);
 
+/**
+ * @brief Get the memory used by a reservation.
+ *
+ * @param res The reservation.
+ * @param strings Where the bytes of its string payloads are added, except the id, which is the catalog key.
+ * @return The size of its struct.
+ */
+size_t get_reservation_memory(RESERV res, size_t* strings);
+
 /**
  * @brief Frees memory associated with a reserv struct.
  * @param res A pointer to the reservation struct.
@@ -201,13 +223,13 @@ void free_reservations(RESERV res);
 /**
  * @brief Verifies the validity of reservation data.
  * @param fields An array of reserv data fields.
- * @param users Catalog of users.
+ * @param catalog A pointer to the manager catalog, whose users are looked up.
  * @return 1 if the user data is valid, 0 otherwise.
  */
-int verify_reservations(char** fields, USERS_C users);
+int verify_reservations(char** fields, void* catalog);
 
 /**
- * @brief Builds a reservation struct from reservation data fields.
+ * @brief Builds a reservation struct from reservation data fields already checked by verify_reservations.
  * @param reservations_fields An array of reservation data fields.
  * @param catalog A pointer to the manager catalog.
  * @param stats A pointer to the statistics.
@@ -216,4 +238,40 @@ int verify_reservations(char** fields, USERS_C users);
  */
 int build_reservations(char** reservations_fields, void* catalog);
 
+/**
+ * @brief Adds a reservation to one of the secondary indexes of the catalog.
+ * @param res The reservation.
+ * @param position The position of the reservation in the user and hotel indexes.
+ * @param catalog A pointer to the respective catalog.
+ * @param index The index to be updated.
+ */
+void index_reservation(RESERV res, uint32_t position, void* catalog, RESERV_INDEX index);
+
+/**
+ * @brief Sorts reservations by begin date, most recent first, and then by ID.
+ *
+ * The begin dates and canonical IDs are packed into radix sort keys, so no keys are compared.
+ * When an ID isn't canonical, the packed dates are compared instead, with the IDs breaking ties.
+ *
+ * @param reservations The reservations.
+ * @param n Number of reservations.
+ */
+void sort_reservations_by_begin(RESERV* reservations, size_t n);
+
+/**
+ * @brief Writes a reservation to a catalog snapshot.
+ * @param reservation The reservation.
+ * @param file The snapshot file.
+ */
+void save_reservation(RESERV reservation, FILE* file);
+
+/**
+ * @brief Reads the next reservation of a catalog snapshot and adds it to the catalog.
+ * @param snapshot The snapshot.
+ * @param catalog A pointer to the respective catalog.
+ *
+ * @return 1 if the reservation is added to the catalog 0 if the snapshot is corrupted
+ */
+int load_reservation(SNAPSHOT snapshot, void* catalog);
+
 #endif
@@ -29,6 +29,7 @@
 typedef struct user *USER;
 
 #include "IO/input.h"
+#include "IO/snapshot.h"
 #include "utils/utils.h"
 #include "catalogs/users_c.h"
 
@@ -153,6 +154,15 @@ char* get_user_account_status(USER user);
  */
 double get_user_total_spent(USER user);
 
+/**
+ * @brief Get the memory used by a user.
+ *
+ * @param user The user.
+ * @param strings Where the bytes of its string payloads are added, except the id, which is the catalog key.
+ * @return The size of its struct.
+ */
+size_t get_user_memory(USER user, size_t* strings);
+
 /**
  * @brief Frees memory associated with a user struct.
  * @param user A pointer to the user struct.
@@ -162,12 +172,13 @@ void free_user(USER user);
 /**
  * @brief Verifies the validity of user data.
  * @param fields An array of user data fields.
+ * @param catalog A pointer to the user catalog (unused).
  * @return 1 if the user data is valid, 0 otherwise.
  */
-int verify_user(char** fields);
+int verify_user(char** fields, void* catalog);
 
 /**
- * @brief Builds a user struct from user data fields.
+ * @brief Builds a user struct from user data fields already checked by verify_user.
  * @param user_fields An array of user data fields.
  * @param catalog A pointer to the respective catalog.
  *
@@ -175,4 +186,27 @@ int verify_user(char** fields);
  */
 int build_user(char **user_fields, void *catalog);
 
+/**
+ * @brief Adds a user to the secondary indexes of the catalog (number of accounts created per day).
+ * @param user The user.
+ * @param catalog A pointer to the respective catalog.
+ */
+void index_user(USER user, void* catalog);
+
+/**
+ * @brief Writes a user to a catalog snapshot.
+ * @param user The user.
+ * @param file The snapshot file.
+ */
+void save_user(USER user, FILE* file);
+
+/**
+ * @brief Reads the next user of a catalog snapshot and adds it to the catalog.
+ * @param snapshot The snapshot.
+ * @param catalog A pointer to the respective catalog.
+ *
+ * @return 1 if the user is added to the catalog 0 if the snapshot is corrupted
+ */
+int load_user(SNAPSHOT snapshot, void* catalog);
+
 #endif
@@ -44,7 +44,8 @@
  *
  * @param path1 The path containing input CSV files.
  * @param path2 The path to the file containing queries to be executed.
+ * @param mode Whether to write one file per command or a single packed archive.
  */
-void batch(char* path1, char* path2);
+void batch(char* path1, char* path2, OUTPUT_MODE mode);
 
 #endif
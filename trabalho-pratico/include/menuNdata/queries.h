@@ -30,17 +30,9 @@
 #include "entities/reservations.h"
 #include "utils/utils.h"
 #include "IO/input.h"
+#include "IO/result.h"
 
 
-/**
- * @typedef free_queries_func
- * @brief Function pointer type for free_query functions.
- *
- * This typedef defines a function pointer type 'free_queries_func' used to represent free_query functions.
- * These functions free the memory allocated to the result of the corresponding executed query-.
- */
-typedef void (*free_queries_func)(void* result);
-
 /**
  * @typedef flight_table_getters
  * @brief Function pointer type for get_flight functions.
@@ -77,7 +69,7 @@ typedef char* (*user_table_getters)(USER user);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query1(MANAGER manager, char** args);
+RESULT query1(MANAGER manager, char** args);
 
 /**
  * Executes Query 2: Retrieve reservations or flights for a given user.
@@ -86,7 +78,7 @@ void* query1(MANAGER manager, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query2(MANAGER manager, char** args);
+RESULT query2(MANAGER manager, char** args);
 
 /**
  * @brief Execute query 3
@@ -97,18 +89,19 @@ void* query2(MANAGER manager, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query3(MANAGER catalog, char** args);
+RESULT query3(MANAGER catalog, char** args);
 
 /**
  * @brief Execute query 4
  *
- * Lists reservations for a given hotel, sorted by their begin date.
+ * Lists reservations for a given hotel, sorted by their begin date. An optional offset and
+ * limit after the hotel ID select a page of the list.
  *
  * @param manager Catalog manager.
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query4(MANAGER manager, char** args);
+RESULT query4(MANAGER manager, char** args);
 
 /**
  * @brief Executes Query 5
@@ -120,7 +113,7 @@ void* query4(MANAGER manager, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query5(MANAGER manager, char** args);
+RESULT query5(MANAGER manager, char** args);
 
 /**
  * @brief Executes Query 6
@@ -132,7 +125,7 @@ void* query5(MANAGER manager, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query6(MANAGER catalog, char** args);
+RESULT query6(MANAGER catalog, char** args);
 
 /**
  * @brief Executes Query 7
@@ -145,7 +138,7 @@ void* query6(MANAGER catalog, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query7(MANAGER catalog, char** args);
+RESULT query7(MANAGER catalog, char** args);
 
 /**
  * @brief Executes Query 8
@@ -156,7 +149,7 @@ void* query7(MANAGER catalog, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query8(MANAGER catalog, char** args);
+RESULT query8(MANAGER catalog, char** args);
 
 /**
  * @brief Executes Query 9
@@ -168,7 +161,7 @@ void* query8(MANAGER catalog, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query9(MANAGER catalog, char** args);
+RESULT query9(MANAGER catalog, char** args);
 
 /**
  * @brief Executes Query 10
@@ -182,107 +175,6 @@ void* query9(MANAGER catalog, char** args);
  * @param args    Array of arguments for the query.
  * @return        The result of the query.
  */
-void* query10(MANAGER catalog, char** args);
-
-
-/**
- * @brief Frees the memory allocated for the result of a specific query.
- *
- * Executes the corrresponding function to free the memory allocated of the result of a given query.
- *
- * @param result The result of the query to be freed.
- * @param query_id The identifier of the query.
- */
-void free_query(void* result, int query_id);
-
-/**
- * @brief Frees the memory allocated for the result of Query 1.
- *
- * This function frees the memory allocated during the execution of Query 1.
- *
- * @param result The result of Query 1.
- */
-void free_query1(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 2.
- *
- * This function frees the memory allocated during the execution of Query 2.
- *
- * @param result The result of Query 2.
- */
-void free_query2(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 3.
- *
- * This function frees the memory allocated during the execution of Query 3.
- *
- * @param result The result of Query 3.
- */
-void free_query3(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 4.
- *
- * This function frees the memory allocated during the execution of Query 4.
- *
- * @param result The result of Query 4.
- */
-void free_query4(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 5.
- *
- * This function frees the memory allocated during the execution of Query 5.
- *
- * @param result The result of Query 5.
- */
-void free_query5(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 6.
- *
- * This function frees the memory allocated during the execution of Query 6.
- *
- * @param result The result of Query 6.
- */
-void free_query6(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 7.
- *
- * This function frees the memory allocated during the execution of Query 7.
- *
- * @param result The result of Query 7.
- */
-void free_query7(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 8.
- *
- * This function frees the memory allocated during the execution of Query 8.
- *
- * @param result The result of Query 8.
- */
-void free_query8(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 9.
- *
- * This function frees the memory allocated during the execution of Query 9.
- *
- * @param result The result of Query 9.
- */
-void free_query9(void* result);
-
-/**
- * @brief Frees the memory allocated for the result of Query 10.
- *
- * This function frees the memory allocated during the execution of Query 10.
- *
- * @param result The result of Query 10.
- */
-void free_query10(void* result);
+RESULT query10(MANAGER catalog, char** args);
 
 #endif
@@ -0,0 +1,64 @@
+/**
+ * @file server.h
+ * @brief Module that contains the functions of the query server mode and of its client.
+ *
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "catalogs/manager_c.h"
+#include "menuNdata/queries.h"
+#include "IO/output.h"
+#include "IO/interpreter.h"
+#include "utils/utils.h"
+
+/**
+ * @brief Default path of the server socket.
+ */
+#define SERVER_SOCKET_PATH "/tmp/programa-principal.sock"
+
+/**
+ * @brief Loads the catalogs once and answers query lines sent through a Unix-domain socket.
+ *
+ * Every line sent by a client is a command in the same grammar of the input file of the batch mode.
+ * The answer is a header line, "OK <n>" or "ERR <n>", followed by the n bytes of the formatted output
+ * (exactly what would be written to the command output file) or of the error message.
+ * Each client is served by its own thread, all of them reading the same catalogs, which are never
+ * modified after being loaded. The server stops on SIGINT or SIGTERM.
+ *
+ * @param path1 The path containing input CSV files.
+ * @param socket_path The path of the socket.
+ * @return 0 on success, -1 if the socket could not be created.
+ */
+int server(char* path1, char* socket_path);
+
+/**
+ * @brief Sends query lines to a running server and prints the answers.
+ *
+ * Outputs are written to stdout and errors to stderr.
+ *
+ * @param socket_path The path of the server socket.
+ * @param queries The query lines to send, or NULL to read them from stdin.
+ * @param n_queries The number of query lines.
+ * @return 0 if every query was answered successfully, 1 otherwise.
+ */
+int client(char* socket_path, char** queries, int n_queries);
+
+#endif
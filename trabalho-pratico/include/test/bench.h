@@ -0,0 +1,66 @@
+/**
+ * @file bench.h
+ * @brief Benchmark runner for the query scenarios.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "catalogs/manager_c.h"
+#include "menuNdata/queries.h"
+#include "IO/interpreter.h"
+#include "utils/utils.h"
+#include "utils/alloc_stats.h"
+
+/**
+ * @brief Default number of measured runs of each scenario.
+ */
+#define BENCH_ITERATIONS 200
+
+/**
+ * @brief Default number of unmeasured runs of each scenario before the measured ones.
+ */
+#define BENCH_WARMUP 10
+
+/**
+ * @brief Path of the JSON report.
+ */
+#define BENCH_JSON_PATH "Resultados/bench.json"
+
+/**
+ * @brief Path of the CSV report.
+ */
+#define BENCH_CSV_PATH "Resultados/bench.csv"
+
+/**
+ * @brief Runs every query scenario repeatedly and reports its latency and allocations.
+ *
+ * Each scenario runs 'warmup' times unmeasured (which also builds the lazy indexes it needs)
+ * and then 'iterations' times, each one timed with CLOCK_MONOTONIC. The min, median, p99 and
+ * mean latency and the allocations per run are printed and written to BENCH_JSON_PATH and
+ * BENCH_CSV_PATH, so that runs can be compared.
+ *
+ * @param pathD Path to the dataset.
+ * @param iterations Number of measured runs of each scenario.
+ * @param warmup Number of unmeasured runs of each scenario.
+ * @return 0 on success, -1 if the dataset is not valid.
+ */
+int bench(char* pathD, int iterations, int warmup);
+
+#endif
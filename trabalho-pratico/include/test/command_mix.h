@@ -0,0 +1,73 @@
+/**
+ * @file command_mix.h
+ * @brief Command files loaded into memory to be run repeatedly by the benchmarks.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef COMMAND_MIX_H
+#define COMMAND_MIX_H
+
+/**
+ * @typedef COMMAND_MIX
+ * @brief The commands of a command file, in the order of the file.
+ */
+typedef struct command_mix *COMMAND_MIX;
+
+/**
+ * @brief Read a command file into memory, skipping empty lines.
+ *
+ * @param path Path of the command file.
+ * @return The commands, or NULL if the file can't be read.
+ */
+COMMAND_MIX read_command_mix(char* path);
+
+/**
+ * @brief Get the number of commands.
+ */
+int get_mix_size(COMMAND_MIX mix);
+
+/**
+ * @brief Get a command, without its line break.
+ *
+ * @param mix The commands.
+ * @param i The command index, from 0.
+ */
+char* get_mix_command(COMMAND_MIX mix, int i);
+
+/**
+ * @brief Get the query family of a command, from 1 to 10.
+ *
+ * @param mix The commands.
+ * @param i The command index, from 0.
+ */
+int get_mix_family(COMMAND_MIX mix, int i);
+
+/**
+ * @brief Whether a command has the 'F' output format.
+ *
+ * @param mix The commands.
+ * @param i The command index, from 0.
+ */
+int get_mix_formatted(COMMAND_MIX mix, int i);
+
+/**
+ * @brief Free the commands.
+ */
+void free_command_mix(COMMAND_MIX mix);
+
+#endif
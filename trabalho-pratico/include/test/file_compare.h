@@ -24,15 +24,32 @@
 
 #include "utils/utils.h"
 
+/**
+ * @brief Path of the report with the discrepancies.
+ */
+#define INCONGRUITIES_PATH "Resultados/incongruities.txt"
+
+/**
+ * @brief Number of unchanged lines shown around each discrepancy.
+ */
+#define COMPARE_CONTEXT 2
+
+/**
+ * @brief Maximum number of threads comparing files.
+ */
+#define COMPARE_MAX_THREADS 16
+
 /**
  * @brief Compare output files with expected results.
  *
- * This function compares the contents of the generated output files with the expected results.
- * If any discrepancies are found, the function writes the details to the incongruities.txt file.
+ * Every commandN_output.txt file in the expected folder is compared, line by line, with the one
+ * obtained in the Resultados folder. The files are mapped into memory and compared by a pool of
+ * threads. Every line that differs is written to INCONGRUITIES_PATH, with COMPARE_CONTEXT lines
+ * of context, and the reports follow the order of the commands.
  *
  * @param pathO The path to the folder containing the expected output files.
- * @param n The number of tests to run.
+ * @return The number of files with discrepancies, or -1 if the report can't be written.
  */
-void compare_files(char* pathO, int n);
+int compare_files(char* pathO);
 
 #endif
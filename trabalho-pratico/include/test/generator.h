@@ -0,0 +1,94 @@
+/**
+ * @file generator.h
+ * @brief Synthetic dataset generator for load and query benchmarks.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief Number of users at scale 1, the size of the provided dataset.
+ */
+#define GENERATOR_USERS 10000
+
+/**
+ * @brief Number of flights at scale 1.
+ */
+#define GENERATOR_FLIGHTS 1000
+
+/**
+ * @brief Number of reservations at scale 1.
+ */
+#define GENERATOR_RESERVATIONS 40000
+
+/**
+ * @brief Number of hotels at scale 1.
+ */
+#define GENERATOR_HOTELS 100
+
+/**
+ * @brief Default seed.
+ */
+#define GENERATOR_SEED 42
+
+/**
+ * @brief Default percentage of invalid rows.
+ */
+#define GENERATOR_INVALID 2.0
+
+/**
+ * @brief Weight of each query family in generated command files, the share each one has in the
+ * provided input file.
+ */
+#define GENERATOR_MIX {37, 14, 8, 7, 6, 6, 4, 12, 8, 9}
+
+/**
+ * @brief Writes users.csv, flights.csv, passengers.csv and reservations.csv to a folder.
+ *
+ * The files follow the column layout the parsers expect, and the same seed and scale always
+ * produce the same files. Scale 1 has the size of the provided dataset (plus reservations),
+ * every entity grows linearly with it. A share of the rows of every file is invalid, each one
+ * failing a single validation rule (or, for flights, being overbooked); passengers and
+ * reservations of invalid users and flights are rejected as well.
+ *
+ * @param path The folder, created along with its parents if it doesn't exist.
+ * @param scale The scale factor.
+ * @param seed The seed.
+ * @param invalid The percentage of invalid rows, from 0 to 100.
+ * @return 0 on success, -1 if a file could not be created.
+ */
+int generate_dataset(char* path, double scale, uint64_t seed, double invalid);
+
+/**
+ * @brief Writes a command file for the dataset generated with the same scale and seed.
+ *
+ * Query families are drawn with the weights of GENERATOR_MIX, half of them with the 'F' format,
+ * and their arguments are ids, hotels, airports, dates and names of the generated dataset.
+ *
+ * @param path Path of the command file.
+ * @param scale The scale factor of the dataset.
+ * @param seed The seed of the dataset.
+ * @param n Number of commands.
+ * @return 0 on success, -1 if the file could not be created.
+ */
+int generate_commands(char* path, double scale, uint64_t seed, long n);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file latency_check.h
+ * @brief Comparison of the latency of each query family with a stored baseline.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef LATENCY_CHECK_H
+#define LATENCY_CHECK_H
+
+/**
+ * @brief Default path of the latency baseline.
+ */
+#define LATENCY_BASELINE_PATH "Resultados/latency.baseline"
+
+/**
+ * @brief Ratio to the baseline above which a query family has regressed.
+ */
+#define LATENCY_THRESHOLD 1.5
+
+/**
+ * @brief Increase, in seconds, below which a query family is never considered regressed,
+ * so that the noise of the fastest families isn't reported.
+ */
+#define LATENCY_MIN_DELTA 0.01
+
+/**
+ * @brief Compare the time spent in each query family with a baseline.
+ *
+ * The time of each command is read from the analysis file written by execute_queries and summed
+ * by query family. When the baseline doesn't exist yet, it is created with these times; otherwise
+ * every family that ran the same number of commands and is more than LATENCY_THRESHOLD times
+ * (and LATENCY_MIN_DELTA seconds) slower than its baseline is reported as a regression.
+ *
+ * @param analysis_path Path to the analysis file with the time of each command.
+ * @param baseline_path Path to the baseline.
+ * @return The number of regressed families, or -1 if the files can't be read or written.
+ */
+int check_latency(char* analysis_path, char* baseline_path);
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file map_bench.h
+ * @brief Benchmark of the string map of the catalogs against a GHashTable.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef MAP_BENCH_H
+#define MAP_BENCH_H
+
+/**
+ * @brief Default number of keys.
+ */
+#define MAP_BENCH_KEYS 1000000
+
+/**
+ * @brief Path of the CSV report.
+ */
+#define MAP_BENCH_CSV_PATH "Resultados/map_bench.csv"
+
+/**
+ * @brief Compare the string map used by the catalogs with a GHashTable using g_str_hash and g_str_equal.
+ *
+ * Both get the same keys, shaped like the user, reservation and flight IDs, and are measured
+ * inserting them, looking them up in a random order, looking up as many missing keys and iterating
+ * over them. The nanoseconds per operation and the estimated memory of each structure are printed
+ * and written to MAP_BENCH_CSV_PATH.
+ *
+ * @param keys Number of keys.
+ * @return 0 on success, -1 if the report can't be written.
+ */
+int map_bench(long keys);
+
+#endif
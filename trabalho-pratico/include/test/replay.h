@@ -0,0 +1,61 @@
+/**
+ * @file replay.h
+ * @brief Replay of a command file against loaded catalogs, measuring the throughput.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+/**
+ * @brief Default duration of a replay, in seconds.
+ */
+#define REPLAY_DURATION 10
+
+/**
+ * @brief Number of latency histogram buckets, the last one being [2^(n-2), inf) microseconds.
+ */
+#define REPLAY_BUCKETS 24
+
+/**
+ * @brief Path of the CSV report.
+ */
+#define REPLAY_CSV_PATH "Resultados/replay.csv"
+
+/**
+ * @brief Replays a command file against the catalogs of a dataset.
+ *
+ * The dataset is loaded once and the commands are run, without writing their outputs, until
+ * 'seconds' have passed or 'commands' commands have run, whichever is given. They run in the
+ * order of the file, starting over at its end, or, with 'mix', drawn at random with the weights
+ * of GENERATOR_MIX among the commands of each query family in the file.
+ *
+ * The sustained queries per second and, for each query identifier (1 to 10 and 1F to 10F), the
+ * number of commands, the mean, median, p99 and maximum latency and a histogram of power of two
+ * microsecond buckets are printed and written to REPLAY_CSV_PATH.
+ *
+ * @param pathD Path to the dataset.
+ * @param pathI Path to the command file.
+ * @param seconds Duration of the replay, used when 'commands' is 0.
+ * @param commands Number of commands to run, or 0 to run for 'seconds'.
+ * @param mix 1 to draw the commands with the weights of each family, 0 to follow the file.
+ * @return 0 on success, -1 if the dataset or the command file can't be read.
+ */
+int replay(char* pathD, char* pathI, double seconds, long commands, int mix);
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file scaling.h
+ * @brief Benchmark of how the load and the queries scale with the dataset size and thread count.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SCALING_H
+#define SCALING_H
+
+/**
+ * @brief Smallest scale of the matrix, each following one doubles it.
+ */
+#define SCALING_MIN_SCALE 0.25
+
+/**
+ * @brief Default largest scale of the matrix.
+ */
+#define SCALING_MAX_SCALE 4
+
+/**
+ * @brief Default largest number of query threads.
+ */
+#define SCALING_MAX_THREADS 8
+
+/**
+ * @brief Number of commands of the generated command mix.
+ */
+#define SCALING_COMMANDS 500
+
+/**
+ * @brief Seed of the generated datasets.
+ */
+#define SCALING_SEED 7
+
+/**
+ * @brief Path of the CSV report.
+ */
+#define SCALING_CSV_PATH "Resultados/scaling.csv"
+
+/**
+ * @brief Measures the load and the queries over generated datasets of increasing size.
+ *
+ * For each scale, from SCALING_MIN_SCALE up to max_scale, a dataset and a command mix of
+ * SCALING_COMMANDS commands are generated in a subfolder of 'dir'. A child process then loads the
+ * dataset with set_catalogs, with the snapshot turned off so that the load time covers the CSV
+ * files only and the snapshot of the user's dataset is left alone, runs the mix once to build the lazy indexes and
+ * runs it again from 1, 2, 4, ... up to max_threads threads at the same time, the way the server
+ * answers its clients. Each row has the load time, the peak memory, the throughput and the mean
+ * latency of each query family; rows are printed and written to SCALING_CSV_PATH.
+ *
+ * @param dir Folder where the datasets are generated, created if it doesn't exist.
+ * @param max_scale Largest scale.
+ * @param max_threads Largest number of query threads.
+ * @return 0 on success, -1 if a dataset can't be generated or loaded.
+ */
+int scaling_bench(char* dir, double max_scale, int max_threads);
+
+#endif
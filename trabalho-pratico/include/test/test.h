@@ -36,6 +36,7 @@
 #include "menuNdata/batch.h"
 
 #include "test/file_compare.h"
+#include "test/latency_check.h"
 #include "test/query1_test.h"
 #include "test/query2_test.h"
 #include "test/query3_test.h"
@@ -60,12 +61,15 @@ typedef void (*queries_test)(MANAGER catalog);
 /**
  * @brief Function to perform the test of the application.
  *
- * This function sets up the necessary data structures, executes queries, and performs tests for each query.
+ * This function sets up the necessary data structures, executes queries, compares their outputs
+ * with the expected ones and the time of each query family with a baseline, and performs tests for each query.
  *
  * @param pathD Path to the dataset.
  * @param pathI Path to the input queries file.
  * @param pathO Path to the expected output file for file comparison.
+ * @param pathB Path to the latency baseline, created when it doesn't exist.
+ * @return 0 when the outputs match and no query family regressed, -1 otherwise.
  */
-void test(char* pathD, char* pathI, char* pathO);
+int test(char* pathD, char* pathI, char* pathO, char* pathB);
 
 #endif
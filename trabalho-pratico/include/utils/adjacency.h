@@ -0,0 +1,101 @@
+/**
+ * @file adjacency.h
+ * @brief Compressed sparse row adjacency between dense entity indexes.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @typedef ADJACENCY
+ * @brief A pointer to an adjacency.
+ *
+ * The neighbors of every row are stored one after the other in a single flat array, and an array
+ * of offsets gives where the neighbors of each row start, so iterating over a row reads contiguous
+ * memory and no row has an allocation of its own.
+ */
+typedef struct adjacency *ADJACENCY;
+
+/**
+ * @struct adjacency_edge
+ * @brief An edge from a row to one of its neighbors.
+ */
+typedef struct adjacency_edge {
+    uint32_t row; /**< The row. */
+    uint32_t neighbor; /**< The neighbor. */
+} ADJACENCY_EDGE;
+
+/**
+ * @brief Build an adjacency from a list of edges.
+ *
+ * The edges are counted per row, the neighbors allocated once and then scattered to their rows,
+ * keeping the order of the edges within each row.
+ *
+ * @param rows Number of rows, every edge's row must be below it.
+ * @param edges The edges.
+ * @param n_edges Number of edges.
+ * @return The adjacency.
+ */
+ADJACENCY create_adjacency(size_t rows, const ADJACENCY_EDGE* edges, size_t n_edges);
+
+/**
+ * @brief Get the neighbors of a row.
+ *
+ * @param adjacency The adjacency.
+ * @param row The row.
+ * @param degree Where the number of neighbors is stored.
+ * @return The neighbors, owned by the adjacency.
+ */
+const uint32_t* get_adjacency_row(ADJACENCY adjacency, uint32_t row, uint32_t* degree);
+
+/**
+ * @brief Get the number of rows of an adjacency.
+ *
+ * @param adjacency The adjacency.
+ * @return The number of rows.
+ */
+size_t get_adjacency_rows(ADJACENCY adjacency);
+
+/**
+ * @brief Get the number of edges of an adjacency.
+ *
+ * @param adjacency The adjacency.
+ * @return The number of edges.
+ */
+size_t get_adjacency_edges(ADJACENCY adjacency);
+
+/**
+ * @brief Get the memory used by an adjacency.
+ *
+ * @param adjacency The adjacency.
+ * @return The memory in bytes.
+ */
+size_t adjacency_memory(ADJACENCY adjacency);
+
+/**
+ * @brief Free an adjacency.
+ *
+ * @param adjacency The adjacency, may be NULL.
+ */
+void free_adjacency(ADJACENCY adjacency);
+
+#endif
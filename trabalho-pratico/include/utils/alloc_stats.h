@@ -0,0 +1,115 @@
+/**
+ * @file alloc_stats.h
+ * @brief This file contains the allocation accounting by subsystem.
+ *
+ * Allocations are counted by the allocator hooks in src/utils/alloc_hooks.c, which are linked into
+ * programa-bench and, with make ALLOC_STATS=1, into every executable. Every allocation is charged
+ * to the subsystem tag of the innermost ALLOC_TAG_SCOPE of its thread; without the hooks the
+ * scopes only set a thread local variable.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/**
+ * @enum alloc_tag
+ * @brief The subsystems allocations are charged to.
+ */
+typedef enum alloc_tag {
+    ALLOC_OTHER,       /**< Anything outside a tagged scope. */
+    ALLOC_PARSER,      /**< Reading and splitting the dataset files. */
+    ALLOC_ENTITIES,    /**< Validating rows and building the entities. */
+    ALLOC_CATALOGS,    /**< Inserting in the catalogs and building their indexes. */
+    ALLOC_QUERIES,     /**< Running the queries. */
+    ALLOC_OUTPUT,      /**< Formatting and writing the results. */
+    ALLOC_INTERACTIVE, /**< The interactive mode. */
+    ALLOC_N_TAGS       /**< Number of tags. */
+} ALLOC_TAG;
+
+/**
+ * @brief Whether the allocator hooks are linked, set by the hooks before main runs.
+ */
+extern int alloc_accounting;
+
+/**
+ * @brief The tag allocations of the calling thread are charged to.
+ */
+extern __thread ALLOC_TAG alloc_current_tag;
+
+/**
+ * @brief Charge a new allocation to a tag.
+ *
+ * @param tag The tag.
+ * @param size The size of the allocation.
+ */
+void count_alloc(ALLOC_TAG tag, size_t size);
+
+/**
+ * @brief Release an allocation from the tag it was charged to.
+ *
+ * @param tag The tag.
+ * @param size The size of the allocation.
+ */
+void count_free(ALLOC_TAG tag, size_t size);
+
+/**
+ * @brief Set the tag of the calling thread.
+ *
+ * @param tag The new tag.
+ * @return The previous tag.
+ */
+ALLOC_TAG set_alloc_tag(ALLOC_TAG tag);
+
+/**
+ * @brief Restore a previous tag, used as a cleanup function.
+ *
+ * @param previous The previous tag.
+ */
+void restore_alloc_tag(ALLOC_TAG* previous);
+
+/**
+ * @brief Get the number of allocations and of bytes requested so far, over every tag.
+ *
+ * @param count Where the number of allocations is stored.
+ * @param bytes Where the number of bytes is stored.
+ */
+void get_alloc_totals(long* count, long* bytes);
+
+/**
+ * @brief Write the allocations, bytes and peak live bytes of each tag.
+ *
+ * Writes nothing when the allocator hooks aren't linked.
+ *
+ * @param file The file, usually the analysis file.
+ */
+void write_alloc_stats(FILE* file);
+
+#define ALLOC_CONCAT_(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_(a, b)
+
+/**
+ * @brief Charge the allocations of the rest of the enclosing block to a tag.
+ */
+#define ALLOC_TAG_SCOPE(tag) \
+    ALLOC_TAG ALLOC_CONCAT(alloc_tag_, __LINE__) __attribute__((cleanup(restore_alloc_tag))) = set_alloc_tag(tag)
+
+#endif
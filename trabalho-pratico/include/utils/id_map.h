@@ -0,0 +1,150 @@
+/**
+ * @file id_map.h
+ * @brief Map from entity IDs to values, indexed by number when the ID is canonical.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include "utils/string_map.h"
+#include "utils/perfect_hash.h"
+
+/**
+ * @brief Number of digits of a canonical ID, after its prefix.
+ */
+#define ID_KEY_DIGITS 10
+
+/**
+ * @typedef ID_MAP
+ * @brief A pointer to a map from entity IDs to values.
+ *
+ * Canonical IDs, a fixed prefix followed by ID_KEY_DIGITS digits (such as the flight "0000000001"
+ * or the reservation "Book0000000001"), are encoded as their number and kept in a flat array of
+ * slots indexed by it, so that looking them up hashes nothing. Any other ID, or a number too far
+ * past the ones already in the map to keep the array dense, falls back to a string map. Like a
+ * string map, it owns its keys and values only when it is given functions to free them.
+ */
+typedef struct id_map *ID_MAP;
+
+/**
+ * @struct id_map_iter
+ * @brief Position of an iteration over an ID map.
+ */
+typedef struct id_map_iter {
+    ID_MAP map; /**< The map. */
+    size_t index; /**< The next slot of the array. */
+    STRING_MAP_ITER fallback; /**< The iteration over the fallback map, once the array is over. */
+} ID_MAP_ITER;
+
+/**
+ * @brief Encode a canonical ID as its number.
+ *
+ * @param id The ID.
+ * @param prefix The prefix of the canonical IDs, "" when they are only digits.
+ * @param key Where the number is stored.
+ * @return 1 if the ID is canonical, 0 otherwise.
+ */
+int encode_id_key(const char* id, const char* prefix, uint64_t* key);
+
+/**
+ * @brief Create an empty ID map.
+ *
+ * @param prefix The prefix of the canonical IDs, borrowed.
+ * @param free_key Function that frees a key, or NULL when the keys are borrowed.
+ * @param free_value Function that frees a value, or NULL when the values are borrowed.
+ * @return The ID map.
+ */
+ID_MAP create_id_map(const char* prefix, GDestroyNotify free_key, GDestroyNotify free_value);
+
+/**
+ * @brief Insert a value, with the semantics of string_map_insert.
+ *
+ * @param map The map.
+ * @param key The ID.
+ * @param value The value.
+ */
+void id_map_insert(ID_MAP map, char* key, void* value);
+
+/**
+ * @brief Look an ID up.
+ *
+ * @param map The map.
+ * @param key The ID.
+ * @return The value, or NULL if the ID isn't in the map.
+ */
+void* id_map_lookup(ID_MAP map, const char* key);
+
+/**
+ * @brief Remove an ID, freeing it and its value.
+ *
+ * @param map The map.
+ * @param key The ID.
+ * @return 1 if the ID was in the map, 0 otherwise.
+ */
+int id_map_remove(ID_MAP map, const char* key);
+
+/**
+ * @brief Get the number of IDs in the map.
+ *
+ * @param map The map.
+ * @return The number of IDs.
+ */
+size_t id_map_size(ID_MAP map);
+
+/**
+ * @brief Build a perfect hash over the IDs of the fallback map, which must not change until the next insert or remove.
+ *
+ * @param map The map.
+ */
+void freeze_id_map(ID_MAP map);
+
+/**
+ * @brief Start an iteration over a map, which must not change until it ends.
+ *
+ * @param iter The iteration.
+ * @param map The map.
+ */
+void id_map_iter_init(ID_MAP_ITER* iter, ID_MAP map);
+
+/**
+ * @brief Advance an iteration.
+ *
+ * @param iter The iteration.
+ * @param key Where the next ID is stored.
+ * @param value Where its value is stored.
+ * @return 1 if there was a next ID, 0 when the iteration is over.
+ */
+int id_map_iter_next(ID_MAP_ITER* iter, void** key, void** value);
+
+/**
+ * @brief Get the memory used by the array, the fallback map and its perfect hash.
+ *
+ * @param map The map.
+ * @return The memory in bytes.
+ */
+size_t id_map_memory(ID_MAP map);
+
+/**
+ * @brief Free a map, with its keys and values when it owns them.
+ *
+ * @param map The map.
+ */
+void free_id_map(ID_MAP map);
+
+#endif
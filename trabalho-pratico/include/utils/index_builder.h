@@ -0,0 +1,176 @@
+/**
+ * @file index_builder.h
+ * @brief Two phase builder of reverse indexes from string keys to dense values.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef INDEX_BUILDER_H
+#define INDEX_BUILDER_H
+
+#include "utils/string_map.h"
+#include "utils/adjacency.h"
+#include "utils/memory_report.h"
+
+#include <glib.h>
+
+/**
+ * @typedef INDEX_BUILDER
+ * @brief A pointer to a reverse index being built.
+ *
+ * Each (key, value) edge is only recorded while the data is read: its key is given the next
+ * row the first time it is seen, and the edge appended to a flat list. Building the index then
+ * counts the edges of each row, allocates every row at once and scatters the values to them,
+ * so no row is ever grown one value at a time.
+ */
+typedef struct index_builder *INDEX_BUILDER;
+
+/**
+ * @typedef REVERSE_INDEX
+ * @brief A pointer to a reverse index, from each key to the values recorded with it in order.
+ */
+typedef struct reverse_index *REVERSE_INDEX;
+
+/**
+ * @brief Create an empty index builder.
+ *
+ * @param copy_keys Whether each key is copied the first time it is seen, otherwise keys are
+ *                  borrowed and must outlive the index.
+ * @return The index builder.
+ */
+INDEX_BUILDER create_index_builder(int copy_keys);
+
+/**
+ * @brief Record an edge from a key to a value.
+ *
+ * @param builder The index builder.
+ * @param key The key.
+ * @param value The value.
+ * @return The row of the key.
+ */
+uint32_t add_index_edge(INDEX_BUILDER builder, char* key, uint32_t value);
+
+/**
+ * @brief Get the row of a key, giving it the next one the first time it is seen, without recording an edge.
+ *
+ * @param builder The index builder.
+ * @param key The key.
+ * @return The row of the key.
+ */
+uint32_t add_index_key(INDEX_BUILDER builder, char* key);
+
+/**
+ * @brief Record an edge from the row of a key already seen to a value.
+ *
+ * @param builder The index builder.
+ * @param row The row, as given by add_index_key.
+ * @param value The value.
+ */
+void add_index_row_edge(INDEX_BUILDER builder, uint32_t row, uint32_t value);
+
+/**
+ * @brief Get the number of keys recorded so far, which are the rows below it.
+ *
+ * @param builder The index builder.
+ * @return The number of keys.
+ */
+uint32_t get_index_builder_keys(INDEX_BUILDER builder);
+
+/**
+ * @brief Build the reverse index of the edges recorded, freeing the builder.
+ *
+ * @param builder The index builder.
+ * @return The reverse index.
+ */
+REVERSE_INDEX build_reverse_index(INDEX_BUILDER builder);
+
+/**
+ * @brief Turn a reverse index back into a builder with the same edges, freeing the index.
+ *
+ * @param index The reverse index.
+ * @return The index builder.
+ */
+INDEX_BUILDER thaw_reverse_index(REVERSE_INDEX index);
+
+/**
+ * @brief Free an index builder without building its index.
+ *
+ * @param builder The index builder, may be NULL.
+ */
+void free_index_builder(INDEX_BUILDER builder);
+
+/**
+ * @brief Get the values of a key.
+ *
+ * @param index The reverse index.
+ * @param key The key.
+ * @param count Where the number of values is stored.
+ * @return The values, owned by the index, or NULL if the key has none.
+ */
+const uint32_t* get_reverse_index_values(REVERSE_INDEX index, const char* key, uint32_t* count);
+
+/**
+ * @brief Get the values of a row.
+ *
+ * @param index The reverse index.
+ * @param row The row.
+ * @param count Where the number of values is stored.
+ * @return The values, owned by the index.
+ */
+const uint32_t* get_reverse_index_row(REVERSE_INDEX index, uint32_t row, uint32_t* count);
+
+/**
+ * @brief Get the key of a row.
+ *
+ * @param index The reverse index.
+ * @param row The row.
+ * @return The key.
+ */
+char* get_reverse_index_key(REVERSE_INDEX index, uint32_t row);
+
+/**
+ * @brief Get the number of keys of a reverse index, which are the rows below it.
+ *
+ * @param index The reverse index.
+ * @return The number of keys.
+ */
+uint32_t get_reverse_index_keys(REVERSE_INDEX index);
+
+/**
+ * @brief Get the number of edges of a reverse index.
+ *
+ * @param index The reverse index.
+ * @return The number of edges.
+ */
+size_t get_reverse_index_edges(REVERSE_INDEX index);
+
+/**
+ * @brief Add the memory used by a reverse index to the current catalog of a memory report.
+ *
+ * @param index The reverse index.
+ * @param report The memory report.
+ */
+void report_reverse_index_memory(REVERSE_INDEX index, MEMORY_REPORT report);
+
+/**
+ * @brief Free a reverse index, with its keys when it copied them.
+ *
+ * @param index The reverse index, may be NULL.
+ */
+void free_reverse_index(REVERSE_INDEX index);
+
+#endif
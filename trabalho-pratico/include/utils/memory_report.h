@@ -0,0 +1,131 @@
+/**
+ * @file memory_report.h
+ * @brief Breakdown of the memory used by the catalogs after a load.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <glib.h>
+
+/**
+ * @brief Path where the memory report is written.
+ */
+#define MEMORY_REPORT_PATH "Resultados/memory_report.txt"
+
+/**
+ * @typedef MEMORY_REPORT
+ * @brief A pointer to the memory used by each catalog.
+ */
+typedef struct memory_report *MEMORY_REPORT;
+
+/**
+ * @enum memory_kind
+ * @brief What the memory of a catalog is used for.
+ */
+typedef enum memory_kind {
+    MEMORY_BUCKETS,    /**< Hash table buckets. */
+    MEMORY_STRUCTS,    /**< Entity structs. */
+    MEMORY_STRINGS,    /**< String payloads, including the keys owned by the tables. */
+    MEMORY_ARRAYS,     /**< GPtrArrays, their struct and their storage. */
+    MEMORY_DAY_COUNTS, /**< Arrays with a count per day of a month. */
+    MEMORY_N_KINDS     /**< Number of kinds. */
+} MEMORY_KIND;
+
+/**
+ * @brief Create an empty memory report.
+ *
+ * @return The memory report.
+ */
+MEMORY_REPORT create_memory_report(void);
+
+/**
+ * @brief Start the row of a catalog, to which the following memory is added.
+ *
+ * @param report The memory report.
+ * @param name The name of the catalog.
+ * @param entities The number of entities, which the average bytes are relative to.
+ */
+void begin_memory_catalog(MEMORY_REPORT report, const char* name, long entities);
+
+/**
+ * @brief Add memory to the current catalog.
+ *
+ * @param report The memory report.
+ * @param kind What the memory is used for.
+ * @param bytes The number of bytes.
+ */
+void add_memory(MEMORY_REPORT report, MEMORY_KIND kind, size_t bytes);
+
+/**
+ * @brief Get the memory of a string payload.
+ *
+ * @param string The string, or NULL.
+ * @return Its length plus the terminator, 0 for NULL.
+ */
+size_t string_memory(const char* string);
+
+/**
+ * @brief Estimate the bucket memory of a GHashTable.
+ *
+ * GLib keeps a power of two number of buckets, about a third more than the entries, each one with
+ * a key, a value and a hash.
+ *
+ * @param table The hash table.
+ * @return The estimated number of bytes.
+ */
+size_t hash_table_memory(GHashTable* table);
+
+/**
+ * @brief Estimate the memory of a GPtrArray, whose storage GLib grows in powers of two.
+ *
+ * @param array The array.
+ * @return The estimated number of bytes.
+ */
+size_t ptr_array_memory(GPtrArray* array);
+
+/**
+ * @brief Write the report, a row per catalog with the bytes of each kind and per entity.
+ *
+ * @param report The memory report.
+ * @param file The file.
+ */
+void write_memory_report(MEMORY_REPORT report, FILE* file);
+
+/**
+ * @brief Free a memory report.
+ *
+ * @param report The memory report.
+ */
+void free_memory_report(MEMORY_REPORT report);
+
+/**
+ * @brief Loads a dataset and reports the memory used by each catalog.
+ *
+ * Every lazy index is built first, so that the report covers the catalogs as queries leave them.
+ * The report is printed and written to MEMORY_REPORT_PATH, next to the peak resident memory.
+ *
+ * @param pathD Path to the dataset.
+ * @return 0 on success, -1 if the dataset is not valid.
+ */
+int memory_report(char* pathD);
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters around the queries and the load phases.
+ *
+ * The counters are read through perf_event_open when the program is built with make PERF=1 and the
+ * kernel allows it; otherwise, or for the events the hardware doesn't have, samples only hold the
+ * elapsed time and the reports say so. The counters follow the thread that first takes a sample.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @enum perf_event_kind
+ * @brief The events counted.
+ */
+typedef enum perf_event_kind {
+    PERF_CYCLES,        /**< CPU cycles. */
+    PERF_INSTRUCTIONS,  /**< Instructions retired. */
+    PERF_CACHE_MISSES,  /**< Last level cache misses. */
+    PERF_BRANCH_MISSES, /**< Mispredicted branches. */
+    PERF_N_EVENTS       /**< Number of events. */
+} PERF_EVENT;
+
+/**
+ * @struct perf_sample
+ * @brief The time and the events of a measured section, or the sum of several of them.
+ */
+typedef struct perf_sample {
+    struct timespec start; /**< When the section started. */
+    double seconds; /**< Elapsed time. */
+    uint64_t values[PERF_N_EVENTS]; /**< Events counted, only meaningful for the available ones. */
+} PERF_SAMPLE;
+
+/**
+ * @brief Whether an event can be counted, opening the counters the first time.
+ *
+ * @param event The event.
+ * @return 1 if it is counted, 0 otherwise.
+ */
+int perf_event_available(PERF_EVENT event);
+
+/**
+ * @brief Why the counters are unavailable.
+ *
+ * @return A description, or NULL when at least one event is counted.
+ */
+const char* perf_counters_unavailable(void);
+
+/**
+ * @brief Start measuring a section.
+ *
+ * @param sample The sample.
+ */
+void start_perf_sample(PERF_SAMPLE* sample);
+
+/**
+ * @brief Finish measuring a section, leaving in the sample its time and events.
+ *
+ * @param sample The sample, started with start_perf_sample.
+ */
+void end_perf_sample(PERF_SAMPLE* sample);
+
+/**
+ * @brief Add a finished sample to a total.
+ *
+ * @param total The total, zeroed before the first sample.
+ * @param sample The sample.
+ */
+void add_perf_sample(PERF_SAMPLE* total, const PERF_SAMPLE* sample);
+
+/**
+ * @brief Write a table with the time and the events of each row, and their ratios.
+ *
+ * Only the time is written when the counters are unavailable, after a line saying why.
+ *
+ * @param file The file.
+ * @param title The title of the table.
+ * @param names The name of each row.
+ * @param samples The total of each row.
+ * @param counts The number of samples of each row; rows without samples are skipped.
+ * @param n The number of rows.
+ */
+void write_perf_table(FILE* file, const char* title, const char** names, const PERF_SAMPLE* samples,
+                      const int* counts, int n);
+
+/**
+ * @brief Write the events of a sample as JSON members, null for the unavailable ones.
+ *
+ * @param file The file.
+ * @param sample The sample.
+ */
+void write_perf_json(FILE* file, const PERF_SAMPLE* sample);
+
+#endif
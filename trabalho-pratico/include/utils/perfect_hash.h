@@ -0,0 +1,71 @@
+/**
+ * @file perfect_hash.h
+ * @brief Minimal perfect hash over the string keys of a map that no longer changes.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include "utils/string_map.h"
+
+/**
+ * @typedef PERFECT_HASH
+ * @brief A pointer to a minimal perfect hash.
+ */
+typedef struct perfect_hash *PERFECT_HASH;
+
+/**
+ * @brief Build a minimal perfect hash over the keys of a string map.
+ *
+ * The keys are spread over as many buckets as there are keys. Starting from the largest buckets,
+ * each one is given the first seed that sends all of its keys to free slots, and buckets with a
+ * single key are given a free slot directly, so a lookup is always one hash, one probe of a flat,
+ * cache-aligned array of slots and one key comparison. The keys and values are borrowed from the
+ * map, which must outlive the hash and not change while it is in use.
+ *
+ * @param table The map.
+ * @return The perfect hash.
+ */
+PERFECT_HASH create_perfect_hash(STRING_MAP table);
+
+/**
+ * @brief Look a key up in a perfect hash.
+ *
+ * @param hash The perfect hash.
+ * @param key The key.
+ * @return The value of the key, or NULL if it isn't one of the keys of the hash.
+ */
+void* lookup_perfect_hash(PERFECT_HASH hash, const char* key);
+
+/**
+ * @brief Get the memory used by a perfect hash, without the keys and values it borrows.
+ *
+ * @param hash The perfect hash.
+ * @return The memory in bytes.
+ */
+size_t perfect_hash_memory(PERFECT_HASH hash);
+
+/**
+ * @brief Free a perfect hash.
+ *
+ * @param hash The perfect hash, may be NULL.
+ */
+void free_perfect_hash(PERFECT_HASH hash);
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file radix_sort.h
+ * @brief Stable LSD radix sort of packed two word keys, used to order query results.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct radix_key
+ * @brief A sort key, packed into two words, and the element it belongs to.
+ */
+typedef struct radix_key {
+    uint64_t primary; /**< The most significant word of the key. */
+    uint64_t secondary; /**< The least significant word, which breaks ties of the primary. */
+    uint32_t index; /**< Position of the element in the array being sorted. */
+} RADIX_KEY;
+
+/**
+ * @brief Sort keys by their primary and then their secondary word, in ascending order.
+ *
+ * The sort is stable. Small arrays are sorted by insertion. Larger ones are sorted by one
+ * counting pass per byte, from the least significant byte of the secondary word to the most
+ * significant of the primary. The counts of all the bytes are taken in a single read of the keys,
+ * and a byte that is the same in every key is skipped. Apart from one scratch array of the same
+ * size as the keys, nothing is allocated and no keys are compared.
+ *
+ * @param keys The keys.
+ * @param n Number of keys.
+ */
+void radix_sort(RADIX_KEY* keys, size_t n);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file selection.h
+ * @brief Partial selection: the first K elements of an order and the median, without a full sort.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <stddef.h>
+
+/**
+ * @brief Move the k first elements of an order to the start of an array, sorted.
+ *
+ * The array is partitioned around the k-th element (introselect: quickselect with a median of
+ * three pivot, falling back to sorting when the partitions keep coming out unbalanced), and then
+ * only the first k elements are sorted, so the cost is O(n + k log k) instead of O(n log n). The
+ * remaining elements are left in no particular order.
+ *
+ * @param base The array.
+ * @param n Number of elements.
+ * @param size Size of an element.
+ * @param k Number of elements wanted, all of them are sorted when it is n or more.
+ * @param compare Comparison of two elements, as for qsort.
+ */
+void select_top_k(void* base, size_t n, size_t size, size_t k, int (*compare)(const void*, const void*));
+
+/**
+ * @brief Median of an array of integers, in linear expected time.
+ *
+ * With an even number of values, it is the mean of the two middle ones, rounded towards zero.
+ * The values are reordered.
+ *
+ * @param values The values.
+ * @param n Number of values.
+ * @return The median, 0 when there are no values.
+ */
+int median_of_ints(int* values, size_t n);
+
+#endif
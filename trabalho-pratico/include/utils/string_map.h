@@ -0,0 +1,147 @@
+/**
+ * @file string_map.h
+ * @brief Open addressing hash map with string keys, used by the catalogs.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef STRING_MAP_H
+#define STRING_MAP_H
+
+#include <glib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @typedef STRING_MAP
+ * @brief A pointer to a string map.
+ *
+ * The keys and values live in one flat array of slots. Next to it, a control byte per slot holds
+ * either a 7 bit fingerprint of the key's hash or a mark of an empty or deleted slot, and a lookup
+ * compares the fingerprints of a whole group of 16 slots at once (with SSE2 when available) before
+ * comparing any key. Like a GHashTable, the map owns its keys and values only when it is given
+ * functions to free them.
+ */
+typedef struct string_map *STRING_MAP;
+
+/**
+ * @struct string_map_iter
+ * @brief Position of an iteration over a string map.
+ */
+typedef struct string_map_iter {
+    STRING_MAP map; /**< The map. */
+    size_t index; /**< The next slot. */
+} STRING_MAP_ITER;
+
+/**
+ * @brief Hash a string key, eight bytes at a time, followed by the splitmix64 finalizer.
+ *
+ * @param key The key.
+ * @return The hash.
+ */
+uint64_t hash_string_key(const char* key);
+
+/**
+ * @brief Create an empty string map.
+ *
+ * @param free_key Function that frees a key, or NULL when the keys are borrowed.
+ * @param free_value Function that frees a value, or NULL when the values are borrowed.
+ * @return The string map.
+ */
+STRING_MAP create_string_map(GDestroyNotify free_key, GDestroyNotify free_value);
+
+/**
+ * @brief Insert a value, with the semantics of g_hash_table_insert.
+ *
+ * When the key is already in the map, its value is replaced (and the old one freed) and the
+ * given key is freed, so that the map keeps the key it already had.
+ *
+ * @param map The map.
+ * @param key The key.
+ * @param value The value.
+ */
+void string_map_insert(STRING_MAP map, char* key, void* value);
+
+/**
+ * @brief Look a key up.
+ *
+ * @param map The map.
+ * @param key The key.
+ * @return The value, or NULL if the key isn't in the map.
+ */
+void* string_map_lookup(STRING_MAP map, const char* key);
+
+/**
+ * @brief Whether a key is in the map.
+ *
+ * @param map The map.
+ * @param key The key.
+ * @return 1 if it is, 0 otherwise.
+ */
+int string_map_contains(STRING_MAP map, const char* key);
+
+/**
+ * @brief Remove a key, freeing it and its value.
+ *
+ * @param map The map.
+ * @param key The key.
+ * @return 1 if the key was in the map, 0 otherwise.
+ */
+int string_map_remove(STRING_MAP map, const char* key);
+
+/**
+ * @brief Get the number of keys in the map.
+ *
+ * @param map The map.
+ * @return The number of keys.
+ */
+size_t string_map_size(STRING_MAP map);
+
+/**
+ * @brief Start an iteration over a map, which must not change until it ends.
+ *
+ * @param iter The iteration.
+ * @param map The map.
+ */
+void string_map_iter_init(STRING_MAP_ITER* iter, STRING_MAP map);
+
+/**
+ * @brief Advance an iteration.
+ *
+ * @param iter The iteration.
+ * @param key Where the next key is stored.
+ * @param value Where its value is stored.
+ * @return 1 if there was a next key, 0 when the iteration is over.
+ */
+int string_map_iter_next(STRING_MAP_ITER* iter, void** key, void** value);
+
+/**
+ * @brief Get the memory used by the slots and control bytes of a map.
+ *
+ * @param map The map.
+ * @return The memory in bytes.
+ */
+size_t string_map_memory(STRING_MAP map);
+
+/**
+ * @brief Free a map, with its keys and values when it owns them.
+ *
+ * @param map The map.
+ */
+void free_string_map(STRING_MAP map);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file trace.h
+ * @brief This file contains the tracing scopes and the Chrome trace export.
+ *
+ * Tracing is only compiled in when TRACE is defined (make TRACE=1), otherwise the macros expand
+ * to nothing and cost nothing.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Path where the trace is written.
+ */
+#define TRACE_PATH "Resultados/trace.json"
+
+/**
+ * @brief Number of events kept by each thread, older events are overwritten.
+ *
+ * Enough for a whole load of the provided dataset, one event per row.
+ */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 262144
+#endif
+
+/**
+ * @struct trace_scope
+ * @brief A scope being traced.
+ */
+struct trace_scope {
+    const char* name; /**< Name of the scope, must outlive the trace. */
+    uint64_t start; /**< When the scope was entered, in nanoseconds. */
+};
+
+/**
+ * @brief Read the monotonic clock.
+ *
+ * @return The current time, in nanoseconds.
+ */
+uint64_t trace_now(void);
+
+/**
+ * @brief Record a finished scope in the buffer of the calling thread.
+ *
+ * @param name Name of the scope.
+ * @param start When the scope was entered, in nanoseconds.
+ * @param end When the scope was left, in nanoseconds.
+ */
+void record_trace_event(const char* name, uint64_t start, uint64_t end);
+
+/**
+ * @brief Record a scope when it goes out of scope, used as a cleanup function.
+ *
+ * @param scope The scope.
+ */
+void end_trace_scope(struct trace_scope* scope);
+
+/**
+ * @brief Write the events of every thread as a Chrome/Perfetto JSON trace.
+ *
+ * @param path The path of the file.
+ * @return 0 on success, -1 if the file could not be written.
+ */
+int write_trace(const char* path);
+
+#ifdef TRACE
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing block under the given name.
+ */
+#define TRACE_SCOPE(name) \
+    struct trace_scope TRACE_CONCAT(trace_scope_, __LINE__) __attribute__((cleanup(end_trace_scope))) = {(name), trace_now()}
+
+/**
+ * @brief Write the trace to a file.
+ */
+#define TRACE_DUMP(path) write_trace(path)
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_DUMP(path) do {} while (0)
+
+#endif
+
+/**
+ * @brief Trace the rest of the enclosing function.
+ */
+#define TRACE_FUNCTION() TRACE_SCOPE(__func__)
+
+#endif
@@ -28,9 +28,11 @@
 #include "entities/users.h"
 #include "entities/reservations.h"
 #include "IO/parser.h"
+#include "IO/snapshot.h"
 
 #include <glib.h>
 #include <stdio.h>
+#include <time.h>
 
 #define SYSTEM_DATE "2023/10/01"
 
@@ -40,6 +42,11 @@
  * This function initializes the catalog and statistics, reads and parses data from CSV files,
  * and write the information to each catalog.
  * It also checks for errors during parsing and creates error files if needed.
+ * When the catalog snapshot matches the dataset, the catalogs and the error files are restored from it
+ * instead, otherwise a new snapshot is saved after parsing. A corrupted snapshot is removed and the
+ * CSV files are loaded into fresh catalogs. Nothing of this happens when the snapshot is turned off
+ * with set_snapshot_enabled.
+ * The time, rows, bytes and peak RSS of each phase of the load are written to LOAD_PROFILE_PATH.
  *
  * @param manager_catalog The catalog manager conataing a catalog for each entity type(users, flights, reservations and passengers).
  * @param path1 The path  to the folder containing input CSV files.
@@ -47,6 +54,47 @@
  */
 int set_catalogs(MANAGER manager_catalog, char* path1);
 
+/**
+ * @brief Record that a secondary index was built on demand.
+ *
+ * @param index The name of the index.
+ * @param elapsed The time the build took, in seconds.
+ */
+void log_index_build(const char* index, double elapsed);
+
+/**
+ * @brief Write the index builds recorded since the last call to the analysis file.
+ *
+ * @param file The analysis file.
+ */
+void write_index_builds(FILE* file);
+
+/**
+ * @brief Get the seconds elapsed since a given instant of the monotonic clock.
+ *
+ * @param start The instant.
+ * @return The elapsed time in seconds.
+ */
+double elapsed_since(struct timespec start);
+
+/**
+ * @brief Save the catalogs and the error files to the catalog snapshot, keyed by the dataset files.
+ *
+ * @param manager_catalog The loaded catalog manager.
+ * @param path1 The path to the folder containing input CSV files.
+ * @return 0 on success, -1 on failure.
+ */
+int save_snapshot(MANAGER manager_catalog, char* path1);
+
+/**
+ * @brief Restore the catalogs and the error files from the catalog snapshot, if it matches the dataset.
+ *
+ * @param manager_catalog The empty catalog manager.
+ * @param path1 The path to the folder containing input CSV files.
+ * @return 0 on success, -1 if there is no usable snapshot, -2 if it is corrupted.
+ */
+int load_snapshot(MANAGER manager_catalog, char* path1);
+
 /**
  * @brief Verifies if a character is a digit
  *
@@ -187,6 +235,22 @@ int dates_timespan ( char* begin, char* end);
  */
 int get_number_of_nights(RESERV reserv);
 
+/**
+ * @brief Packs a date into an integer that keeps the chronological order.
+ *
+ * @param date The date string in the format "YYYY/MM/DD" (only the first 10 characters are read).
+ * @return The date as YYYYMMDD.
+ */
+long long pack_date(char* date);
+
+/**
+ * @brief Packs a date and time into an integer that keeps the chronological order.
+ *
+ * @param date The date string in the format "YYYY/MM/DD hh:mm:ss".
+ * @return The date as YYYYMMDDhhmmss.
+ */
+long long pack_datetime(char* date);
+
 /**
  * @brief Converts an integer to a string.
  *
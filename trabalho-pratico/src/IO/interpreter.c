@@ -20,15 +20,18 @@
 */
 
 #include "IO/interpreter.h"
+#include "utils/alloc_stats.h"
+#include "utils/perf_counters.h"
 
 #include <time.h>
 #include <stdio.h>
 
-void* parser_query(MANAGER catalog,char* line){
+RESULT parser_query(MANAGER catalog,char* line){
     int i = 0;
     char** args = malloc(sizeof(char*) * MAX_ARGS);
     char* copy = strdup(line);
-    char* token = strtok(copy, " ");
+    char* saveptr;
+    char* token = strtok_r(copy, " ", &saveptr);
 
     while (token != NULL && i < MAX_ARGS) {
         if (token[0] == '"') {
@@ -36,7 +39,7 @@ void* parser_query(MANAGER catalog,char* line){
             strcpy(temp, token);
             removeQuotes(temp);
 
-            token = strtok(NULL,"\"");
+            token = strtok_r(NULL, "\"", &saveptr);
             char* temp1;
             if (temp[strlen(temp)-2] == '\"') {
                 temp[strlen(temp)-2] = '\0';
@@ -50,13 +53,12 @@ void* parser_query(MANAGER catalog,char* line){
             i++;
         }
 
-        token = strtok(NULL, " ");
+        token = strtok_r(NULL, " ", &saveptr);
     }
 
     args[i] = NULL;
 
     free(copy);
-    if (token != NULL) free(token);
 
     int query;
     if(args[0][1] != '0') query = args[0][0] - '0';
@@ -66,7 +68,7 @@ void* parser_query(MANAGER catalog,char* line){
                                     query4, query5, query6,
                                     query7, query8, query9, query10};
 
-    void* result = queries[query-1](catalog, args+1);
+    RESULT result = queries[query-1](catalog, args+1);
 
     for (int k = 0; k < i; k++) free(args[k]);
 
@@ -75,52 +77,66 @@ void* parser_query(MANAGER catalog,char* line){
     return result;
 }
 
-int execute_queries(MANAGER manager_catalog, char* path2, int flag){
+int get_query_id(char* line){
+    if(line[1] == ' ') return line[0] - '0';
+    else if (line[1] == 'F') return (line[0] - '0') + 10;
+    else if (line[2] == 'F' && line[1] == '0') return 20;
+    return 10;
+}
+
+int execute_queries(MANAGER manager_catalog, char* path2, int flag, OUTPUT_MODE mode){
 
     char *line = NULL;
     size_t lsize = 0;
     int cmd_n = 1;
-    void* result;
+    RESULT result;
 
     FILE* queries_file = fopen(path2, "r");
-    FILE* output_file;
-    struct timespec start, end;
-    double elapsed;
+    OUTPUT_SINK sink = create_output_sink(mode);
+    if (sink == NULL) return -1;
+    PERF_SAMPLE sample, families[10] = {0};
+    int family_counts[10] = {0};
     FILE* analysis_file = fopen("Resultados/analysis.txt", "w");
+#ifdef PERF
+    // Built with PERF=1, the batch runs sample the counters of their queries as the tests do
+    int sampled = 1;
+#else
+    int sampled = flag == 1;
+#endif
 
     while(getline(&line,&lsize, queries_file) != -1){
-        int query_id;
         line[strlen(line)-1] = '\0';
-        if (flag == 1){
-            clock_gettime(CLOCK_REALTIME, &start);
+        if (sampled){
+            start_perf_sample(&sample);
         }
         result = parser_query(manager_catalog, line);
-        if (flag == 1){
-            clock_gettime(CLOCK_REALTIME, &end);
-            elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
-            fprintf(analysis_file, "Query: %s\n",line);
-            fprintf(analysis_file,"Elapsed time: %.6f seconds\n\n", elapsed);
-        }
-        output_file = create_output_file(cmd_n);
-        if (output_file == NULL) return -1;
-
-        if(line[1] == ' ') query_id = line[0] - '0';
-        else if (line[1] == 'F') {query_id = (line[0] - '0') + 10;}
-        else if (line[2] == 'F' && line[1] == '0') query_id = 20;
-        else query_id = 10;
-
-        if(result != NULL){
-            output_query(output_file, result, query_id);
-            if (query_id > 10){
-                free_query(result, query_id-10);
+        if (sampled){
+            end_perf_sample(&sample);
+            if (flag == 1){
+                fprintf(analysis_file, "Query: %s\n",line);
+                fprintf(analysis_file,"Elapsed time: %.6f seconds\n\n", sample.seconds);
             }
-            else free_query(result,query_id);
+
+            int id = get_query_id(line);
+            int family = id == 20 ? 10 : id > 10 ? id - 10 : id;
+            add_perf_sample(&families[family - 1], &sample);
+            family_counts[family - 1]++;
         }
-        fclose(output_file);
+        write_index_builds(analysis_file);
+        output_query(begin_output(sink), result, get_query_id(line));
+        end_output(sink);
+        free_result(result);
         cmd_n++;
     }
     free(line);
     fclose(queries_file);
+    int failed = close_output_sink(sink) == -1;
+    if (sampled){
+        static const char* names[] = {"Q1", "Q2", "Q3", "Q4", "Q5", "Q6", "Q7", "Q8", "Q9", "Q10"};
+        write_perf_table(analysis_file, "Counters by query family", names, families, family_counts, 10);
+    }
+    write_alloc_stats(analysis_file);
     fclose(analysis_file);
+    if (failed) return -1;
     return cmd_n;
 }
@@ -0,0 +1,133 @@
+/**
+ * @file load_profile.c
+ * @brief This file contains the implementation of the dataset load profile.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "IO/load_profile.h"
+#include "utils/utils.h"
+#include "utils/perf_counters.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/**
+ * @brief Maximum number of phases of a load.
+ */
+#define MAX_LOAD_PHASES 8
+
+/**
+ * @struct load_phase
+ * @brief The measurements of a phase.
+ */
+struct load_phase {
+    const char* name; /**< Name of the phase. */
+    struct timespec start; /**< When the phase started. */
+    double total; /**< Total time of the phase, in seconds. */
+    double steps[LOAD_N_STEPS]; /**< Time spent in each step, in seconds. */
+    long accepted; /**< Rows inserted in the catalogs. */
+    long rejected; /**< Rows written to the error file. */
+    size_t bytes; /**< Bytes read. */
+    long peak_rss; /**< Peak RSS at the end of the phase, in KB. */
+    PERF_SAMPLE counters; /**< Hardware counters of the phase. */
+};
+
+/**
+ * @struct load_profile
+ * @brief The phases of a load.
+ */
+struct load_profile {
+    struct timespec start; /**< When the load started. */
+    struct load_phase phases[MAX_LOAD_PHASES]; /**< The phases. */
+    int n_phases; /**< Number of phases. */
+};
+
+LOAD_PROFILE create_load_profile(void){
+    LOAD_PROFILE new = calloc(1, sizeof(struct load_profile));
+    clock_gettime(CLOCK_MONOTONIC, &new->start);
+    return new;
+}
+
+LOAD_PHASE begin_load_phase(LOAD_PROFILE profile, const char* name){
+    // Extra phases share the last slot rather than failing the load
+    if (profile->n_phases < MAX_LOAD_PHASES) profile->n_phases++;
+
+    LOAD_PHASE phase = &profile->phases[profile->n_phases - 1];
+    memset(phase, 0, sizeof(struct load_phase));
+    phase->name = name;
+    clock_gettime(CLOCK_MONOTONIC, &phase->start);
+    start_perf_sample(&phase->counters);
+
+    return phase;
+}
+
+void add_load_step_time(LOAD_PHASE phase, LOAD_STEP step, double seconds){
+    phase->steps[step] += seconds;
+}
+
+void add_load_rows(LOAD_PHASE phase, long accepted, long rejected, size_t bytes){
+    phase->accepted += accepted;
+    phase->rejected += rejected;
+    phase->bytes += bytes;
+}
+
+void end_load_phase(LOAD_PHASE phase){
+    end_perf_sample(&phase->counters);
+    phase->total = elapsed_since(phase->start);
+
+    struct rusage r_usage;
+    getrusage(RUSAGE_SELF, &r_usage);
+    phase->peak_rss = r_usage.ru_maxrss;
+}
+
+int write_load_profile(LOAD_PROFILE profile, const char* path){
+#ifdef LOAD_STEPS
+    static const char* steps[] = {"read", "tokenize", "validate", "build"};
+#endif
+
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return -1;
+
+    fprintf(file, "{\n  \"unit\": \"s\",\n  \"total\": %.6f,\n  \"phases\": [\n", elapsed_since(profile->start));
+
+    for (int i = 0; i < profile->n_phases; i++){
+        LOAD_PHASE phase = &profile->phases[i];
+        long rows = phase->accepted + phase->rejected;
+
+        fprintf(file, "    {\"name\": \"%s\", \"total\": %.6f", phase->name, phase->total);
+#ifdef LOAD_STEPS
+        for (int j = 0; j < LOAD_N_STEPS; j++) fprintf(file, ", \"%s\": %.6f", steps[j], phase->steps[j]);
+#endif
+        fprintf(file, ", \"rows\": %ld, \"accepted\": %ld, \"rejected\": %ld, \"bytes\": %zu, \"bytes_per_row\": %.1f, \"peak_rss_kb\": %ld",
+                rows, phase->accepted, phase->rejected, phase->bytes, rows > 0 ? (double)phase->bytes / rows : 0.0,
+                phase->peak_rss);
+        write_perf_json(file, &phase->counters);
+        fprintf(file, "}%s\n", i + 1 < profile->n_phases ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+void free_load_profile(LOAD_PROFILE profile){
+    free(profile);
+}
@@ -20,407 +20,227 @@
  */
 
 #include "IO/output.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 
-void output_query(FILE* output_file, void* output, int query_id) {
+void output_query(FILE* output_file, RESULT output, int query_id) {
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_OUTPUT);
 
     if (output == NULL){
         return;
     }
 
-    static output_query_func output_queries[] = {
-        output_query1, output_query2, output_query3,
-        output_query4, output_query5, output_query6,
-        output_query7, output_query8, output_query9,
-        output_query10, output_query1F, output_query2F, output_query3F,
-        output_query4F, output_query5F, output_query6F, output_query7F,
-        output_query8F, output_query9F, output_query10F};
+    static output_query_func output_modes[] = {write_result, write_result_F};
 
-    output_queries[query_id - 1](output_file, output);
+    output_modes[query_id > 10](output_file, output);
 }
 
-void output_query1(FILE* file, void* output){
-    char** result = (char**) output;
-    for (int i = 0; i < 8; i++) {
-        if(result[i] == NULL) fprintf(file, "False");
-        else if(strcmp(result[i],"T") == 0) fprintf(file, "True");
-        else fprintf(file, "%s", result[i]);
+/**
+ * @struct output_sink
+ * @brief Memory buffer holding the outputs of the commands not yet written to disk.
+ */
+struct output_sink {
+    OUTPUT_MODE mode; /**< Output mode. */
+    FILE* stream; /**< Memory stream where the current batch is written, reused by every batch. */
+    char* buffer; /**< Contents of the memory stream. */
+    size_t size; /**< Size of the contents of the memory stream. */
+    size_t ends[OUTPUT_BATCH_COMMANDS]; /**< End offset, inside the batch, of the output of each buffered command. */
+    int n_batch; /**< Number of buffered commands. */
+    int n_written; /**< Number of commands already written to disk. */
+    FILE* archive; /**< Archive file, packed mode only. */
+    uint64_t* table; /**< (offset, length) pairs of every written command, packed mode only. */
+    int table_capacity; /**< Number of pairs that fit in 'table', packed mode only. */
+    uint64_t payload_end; /**< Offset of the end of the payload in the archive, packed mode only. */
+    int failed; /**< Whether any output could not be written. */
+};
+
+/**
+ * @brief Write a buffer to Resultados/commandN_output.txt with a single write.
+ *
+ * @param command The command number.
+ * @param data The output of the command.
+ * @param length The size of the output.
+ * @return 0 on success, -1 on failure.
+ */
+static int write_command_file(int command, const char* data, size_t length){
+    char path[64];
+    snprintf(path, sizeof(path), "Resultados/command%d_output.txt", command);
 
-        if (i != 7) {
-            fprintf(file, ";");
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) return -1;
+
+    while (length > 0){
+        ssize_t n = write(fd, data, length);
+        if (n <= 0){
+            close(fd);
+            return -1;
         }
+        data += n;
+        length -= n;
     }
-    fprintf(file,"\n");
-}
 
-void output_query1F(FILE* file, void* output){
-    char** result = (char**) output;
-    if (strcmp(result[8],"user") == 0){
-        fprintf(file,"--- 1 ---\n");
-        fprintf(file,"name: %s\n", result[0]);
-        fprintf(file,"sex: %s\n", result[1]);
-        fprintf(file,"age: %s\n",result[2]);
-        fprintf(file,"country_code: %s\n", result[3]);
-        fprintf(file,"passport: %s\n", result[4]);
-        fprintf(file,"number_of_flights: %s\n", result[5]);
-        fprintf(file,"number_of_reservations: %s\n", result[6]);
-        fprintf(file,"total_spent: %s\n", result[7]);
-    }
-    else if (strcmp(result[8],"flight") == 0){
-        fprintf(file,"--- 1 ---\n");
-        fprintf(file,"airline: %s\n", result[0]);
-        fprintf(file,"plane_model: %s\n", result[1]);
-        fprintf(file,"origin: %s\n",result[2]);
-        fprintf(file,"destination: %s\n", result[3]);
-        fprintf(file,"schedule_departure_date: %s\n", result[4]);
-        fprintf(file,"schedule_arrival_date: %s\n", result[5]);
-        fprintf(file,"passengers: %s\n", result[6]);
-        fprintf(file,"delay: %s\n", result[7]);
-    }
-    else if (strcmp(result[8],"reservation") == 0){
-        fprintf(file,"--- 1 ---\n");
-        fprintf(file,"hotel_id: %s\n", result[0]);
-        fprintf(file,"hotel_name: %s\n", result[1]);
-        fprintf(file,"hotel_stars: %s\n",result[2]);
-        fprintf(file,"begin_date: %s\n", result[3]);
-        fprintf(file,"end_date: %s\n", result[4]);
-        if(result[5] == NULL) fprintf(file,"includes_breakfast: False\n");
-        else if(strcmp(result[5],"T") == 0) fprintf(file, "includes_breakfast: True\n");
-        else fprintf(file,"includes_breakfast: %s\n", result[5]);
-        fprintf(file,"nights: %s\n", result[6]);
-        fprintf(file,"total_price: %s\n", result[7]);
-    }
+    return close(fd);
 }
 
-void output_query2(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    char* type = result_array[1];
-    if (!type){
-        for (int i = 2; i < length + 2; i++) {
-            if (i != (length + 1)) {
-                if (result_array[i][0] == 'B'){
-                    fprintf(file, "%s;reservation\n", result_array[i]);
-                }
-                else fprintf(file, "%s;flight\n", result_array[i]);
-            }
-            else {
-                if (result_array[i][0] == 'B'){
-                    fprintf(file, "%s;reservation\n", result_array[i]);
-                }
-                else fprintf(file, "%s;flight\n", result_array[i]);
-            }
-        }
-    }
-    else {
-        for (int i = 2; i < length + 2; i++) {
-            if (i != (length + 1)) {
-                fprintf(file, "%s\n", result_array[i]);
-            }
-            else {
-                result_array[i][strlen(result_array[i])] ='\0';
-                char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-                fprintf(file,"%s\n",truncatedString);
-                free(truncatedString);
-            }
+/**
+ * @brief Write the buffered batch to disk and start a new one.
+ *
+ * @param sink The output sink.
+ */
+static void flush_output_sink(OUTPUT_SINK sink){
+    if (sink->n_batch == 0) return;
+    fflush(sink->stream);
+    size_t batch_size = sink->ends[sink->n_batch - 1];
+
+    if (sink->mode == OUTPUT_PACKED){
+        if (sink->n_written + sink->n_batch > sink->table_capacity){
+            sink->table_capacity = sink->table_capacity == 0 ? 256 : sink->table_capacity * 2;
+            sink->table = realloc(sink->table, sizeof(uint64_t) * 2 * sink->table_capacity);
         }
-        free(type);
+        if (batch_size > 0 && fwrite(sink->buffer, 1, batch_size, sink->archive) != batch_size) sink->failed = 1;
     }
-}
 
-void output_query2F(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    char* type = result_array[1];
-    if (!type){
-        for (int i = 2; i < length + 2; i++) {
-            char* id = strtok(result_array[i], ";");
-            char* dateTime = strtok(NULL, ";");
-            fprintf(file, "--- %d ---\n", i-1);
-            fprintf(file, "id: %s\n",id);
-            fprintf(file,"date: %s\n",dateTime);
-            if (i != (length+1)){
-                if (id[0] == 'B'){
-                    fprintf(file, "type: reservation\n\n");
-                }
-                else fprintf(file, "type: flight\n\n");
-            }
-            else {
-                if (id[0] == 'B'){
-                    fprintf(file, "type: reservation\n");
-                }
-                else fprintf(file, "type: flight\n");
-            }
+    size_t start = 0;
+    for (int i = 0; i < sink->n_batch; i++){
+        int command = ++sink->n_written;
+        size_t length = sink->ends[i] - start;
+
+        if (sink->mode == OUTPUT_PACKED){
+            sink->table[2 * (command - 1)] = sink->payload_end + start;
+            sink->table[2 * (command - 1) + 1] = length;
         }
-    }
-    else {
-        for (int i = 2; i < length + 2; i++) {
-            char* id = strtok(result_array[i], ";");
-            char* dateTime = strtok(NULL, ";");
-            fprintf(file, "--- %d ---\n", i-1);
-            fprintf(file, "id: %s\n",id);
-            if (i != (length+1)){
-                fprintf(file,"date: %s\n",dateTime);
-                fprintf(file,"\n");
-            }
-            else {
-                dateTime[strlen(dateTime)] = '\0';
-                char *truncatedString = strndup(dateTime, strlen(dateTime));
-                fprintf(file,"date: %s\n",truncatedString);
-                free(truncatedString);
-            }
+        else if (write_command_file(command, sink->buffer + start, length) == -1){
+            sink->failed = 1;
         }
-        free(type);
+
+        start = sink->ends[i];
     }
-}
 
-void output_query3(FILE* file, void* output){
-    char* rating = (char*) output;
-    fprintf(file,"%s\n",rating);
-}
+    sink->payload_end += batch_size;
+    sink->n_batch = 0;
 
-void output_query3F(FILE* file, void* output){
-    char* rating = (char*) output;
-    fprintf(file,"--- 1 ---\n");
-    fprintf(file,"rating: %s\n",rating);
+    // The next batch overwrites the buffer from its start
+    rewind(sink->stream);
 }
 
-void output_query4(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 1; i < length + 1; i++) {
-        fprintf(file, "%s\n", result_array[i]);
-    }
-}
+OUTPUT_SINK create_output_sink(OUTPUT_MODE mode){
+    OUTPUT_SINK new = malloc(sizeof(struct output_sink));
 
-void output_query4F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 1; i < length + 1; i++){
-        char *token = strtok(result[i], ";");
-
-        fprintf(file, "--- %d ---\n", i);
-        if(token != NULL) fprintf(file, "id: %s\n", token);
-        token = strtok(NULL, ";");
-        if(token != NULL) fprintf(file, "begin_date: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "end_date: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "user_id: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "rating: %s\n", token);
-        token = strtok(NULL,";");
-        if(i != length){ fprintf(file, "total_price: %s\n\n", token);
-        }
-        else{
-            token[strlen(token)] = '\0';
-            char *truncatedString = strndup(token, strlen(token));
-            fprintf(file,"total_price: %s\n",truncatedString);
-            free(truncatedString);
+    new->mode = mode;
+    new->archive = NULL;
+    new->table = NULL;
+    new->table_capacity = 0;
+    new->payload_end = 0;
+
+    if (mode == OUTPUT_PACKED){
+        new->archive = fopen(OUTPUT_PACK_PATH, "wb");
+        if (new->archive == NULL){
+            free(new);
+            return NULL;
         }
 
+        // Header placeholder, rewritten when the sink is closed
+        uint64_t header[3] = {0, 0, 0};
+        fwrite(header, sizeof(uint64_t), 3, new->archive);
+        new->payload_end = sizeof(header);
     }
-}
 
-void output_query5(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 1; i < length + 1; i++) {
-        if (i != length) fprintf(file, "%s\n", result_array[i]);
-        else {
-            result_array[i][strlen(result_array[i])] ='\0';
-            char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-            fprintf(file,"%s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
-}
+    new->stream = open_memstream(&new->buffer, &new->size);
+    new->n_batch = 0;
+    new->n_written = 0;
+    new->failed = 0;
 
-void output_query5F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 1; i < length + 1; i++){
-        char *token = strtok(result[i], ";");
-
-        fprintf(file, "--- %d ---\n", i);
-        if(token != NULL) fprintf(file, "id: %s\n", token);
-        token = strtok(NULL, ";");
-        if(token != NULL) fprintf(file, "schedule_departure_date: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "destination: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "airline: %s\n", token);
-        token = strtok(NULL,";");
-        if (i != length){
-                fprintf(file,"plane_model: %s\n",token);
-                fprintf(file,"\n");
-        } else {
-            token[strlen(token)] = '\0';
-            char *truncatedString = strndup(token, strlen(token));
-            fprintf(file,"plane_model: %s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
+    return new;
 }
 
-void output_query6(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 1; i < length + 1; i++) {
-        if (i != length) fprintf(file, "%s\n", result_array[i]);
-        else {
-            result_array[i][strlen(result_array[i])] ='\0';
-            char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-            fprintf(file,"%s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
+FILE* begin_output(OUTPUT_SINK sink){
+    return sink->stream;
 }
 
-void output_query6F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 1; i < length + 1; i++){
-        char *token = strtok(result[i], ";");
-
-        fprintf(file, "--- %d ---\n", i);
-        if(token != NULL) fprintf(file, "name: %s\n", token);
-        token = strtok(NULL, ";");
-        if (i != length){
-                fprintf(file, "passengers: %s\n", token);
-                fprintf(file,"\n");
-        } else {
-            token[strlen(token)] = '\0';
-            char *truncatedString = strndup(token, strlen(token));
-            fprintf(file,"passengers: %s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
-}
+void end_output(OUTPUT_SINK sink){
+    ALLOC_TAG_SCOPE(ALLOC_OUTPUT);
+    size_t end = (size_t)ftell(sink->stream);
+    sink->ends[sink->n_batch++] = end;
 
-void output_query7(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 1; i < length + 1; i++) {
-        if (i != length) fprintf(file, "%s\n", result_array[i]);
-        else {
-            result_array[i][strlen(result_array[i])] ='\0';
-            char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-            fprintf(file,"%s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
+    if (sink->n_batch == OUTPUT_BATCH_COMMANDS || end >= OUTPUT_BATCH_SIZE) flush_output_sink(sink);
 }
 
-void output_query7F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 1; i < length + 1; i++){
-        char *token = strtok(result[i], ";");
-
-        fprintf(file, "--- %d ---\n", i);
-        if(token != NULL) fprintf(file, "name: %s\n", token);
-        token = strtok(NULL, ";");
-        if (i != length){
-                fprintf(file, "median: %s\n", token);
-                fprintf(file,"\n");
-        } else {
-            token[strlen(token)] = '\0';
-            char *truncatedString = strndup(token, strlen(token));
-            fprintf(file,"median: %s\n",truncatedString);
-            free(truncatedString);
+int close_output_sink(OUTPUT_SINK sink){
+    ALLOC_TAG_SCOPE(ALLOC_OUTPUT);
+    flush_output_sink(sink);
+    fclose(sink->stream);
+    free(sink->buffer);
+
+    if (sink->mode == OUTPUT_PACKED){
+        uint64_t header[3];
+        memcpy(header, OUTPUT_PACK_MAGIC, sizeof(uint64_t));
+        header[1] = sink->n_written;
+        header[2] = sink->payload_end;
+
+        if (sink->n_written > 0 &&
+            fwrite(sink->table, sizeof(uint64_t), 2 * sink->n_written, sink->archive) != (size_t)(2 * sink->n_written)){
+            sink->failed = 1;
         }
+        fseek(sink->archive, 0, SEEK_SET);
+        if (fwrite(header, sizeof(uint64_t), 3, sink->archive) != 3) sink->failed = 1;
+        if (fclose(sink->archive) != 0) sink->failed = 1;
     }
-}
 
-void output_query8(FILE* file, void* output){
-    char* result = (char*) output;
-    fprintf(file, "%s\n", result);
-}
+    int failed = sink->failed;
+    free(sink->table);
+    free(sink);
 
-void output_query8F(FILE* file, void* output){
-    char* result = (char*) output;
-    fprintf(file,"--- 1 ---\n");
-    fprintf(file,"revenue: %s\n",result);
+    return failed ? -1 : 0;
 }
 
-void output_query9(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 1; i < length + 1; i++) {
-        if (i != length) fprintf(file, "%s\n", result_array[i]);
-        else {
-            result_array[i][strlen(result_array[i])] ='\0';
-            char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-            fprintf(file,"%s\n",truncatedString);
-            free(truncatedString);
-        }
-    }
-}
+int unpack_outputs(const char* archive_path, int command){
+    FILE* archive = fopen(archive_path, "rb");
+    if (archive == NULL) return -1;
 
-void output_query9F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 1; i < length + 1; i++){
-        char *token = strtok(result[i], ";");
-
-        fprintf(file, "--- %d ---\n", i);
-        if(token != NULL) fprintf(file, "id: %s\n", token);
-        token = strtok(NULL, ";");
-        if (i != length){
-                fprintf(file, "name: %s\n", token);
-                fprintf(file,"\n");
-        } else {
-            token[strlen(token)] = '\0';
-            char *truncatedString = strndup(token, strlen(token));
-            fprintf(file,"name: %s\n",truncatedString);
-            free(truncatedString);
-        }
+    uint64_t header[3];
+    if (fread(header, sizeof(uint64_t), 3, archive) != 3 ||
+        memcmp(header, OUTPUT_PACK_MAGIC, sizeof(uint64_t)) != 0 ||
+        (uint64_t)command > header[1]){
+        fclose(archive);
+        return -1;
     }
-}
 
-void output_query10(FILE* file, void* output){
-    char** result_array = (char**)output;
-    int length = ourAtoi(result_array[0]);
-    for (int i = 2; i < length + 2; i++) {
-        if (i != (length+1)) fprintf(file, "%s\n", result_array[i]);
-        else {
-            result_array[i][strlen(result_array[i])] ='\0';
-            char *truncatedString = strndup(result_array[i], strlen(result_array[i]));
-            fprintf(file,"%s\n",truncatedString);
-            free(truncatedString);
-        }
+    int first = command == 0 ? 1 : command;
+    int last = command == 0 ? (int)header[1] : command;
+
+    uint64_t* table = malloc(sizeof(uint64_t) * 2 * (header[1] + 1));
+    fseek(archive, (long)header[2], SEEK_SET);
+    if (fread(table, sizeof(uint64_t), 2 * header[1], archive) != 2 * header[1]){
+        free(table);
+        fclose(archive);
+        return -1;
     }
-}
 
-void output_query10F(FILE* file, void* output){
-    char** result = (char**)output;
-    int length = ourAtoi(result[0]);
-    for(int i = 2; i < length + 2; i++){
-        char *token = strtok(result[i], ";");
+    int written = 0;
+    char* data = NULL;
+    for (int i = first; i <= last; i++){
+        uint64_t offset = table[2 * (i - 1)];
+        uint64_t length = table[2 * (i - 1) + 1];
 
-        fprintf(file, "--- %d ---\n", i-1);
-        if(token != NULL) {
-            fprintf(file, "%s: %s\n", result[1], token);
-        }
-        token = strtok(NULL, ";");
-        if(token != NULL) fprintf(file, "users: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "flights: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "passengers: %s\n", token);
-        token = strtok(NULL,";");
-        if(token != NULL) fprintf(file, "unique_passengers: %s\n", token);
-        token = strtok(NULL,";");
-        if (i != (length+1)){
-                fprintf(file,"reservations: %s\n",token);
-                fprintf(file,"\n");
-        } else {
-            fprintf(file,"reservations: %s\n",token);
-        }
+        data = realloc(data, length + 1);
+        fseek(archive, (long)offset, SEEK_SET);
+        if (fread(data, 1, length, archive) != length) break;
+        if (write_command_file(i, data, length) == -1) break;
+        written++;
     }
-}
 
+    free(data);
+    free(table);
+    fclose(archive);
+
+    return written;
+}
@@ -20,15 +20,46 @@
 */
 
 #include "IO/parser.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 
-void parseF (FILE* f, int max_fields, void_function func, void *catalog, FILE* error_f){
-    int verify = 0;
+#ifdef LOAD_STEPS
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return The current time, in seconds.
+ */
+static double now(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Reads the clock into a new variable, to time the steps of a row.
+ */
+#define STEP_CLOCK(t) double t = now()
+#else
+#define STEP_CLOCK(t)
+#endif
+
+void parseF (FILE* f, int max_fields, void_function verify, void_function build, void *catalog, FILE* error_f, LOAD_PHASE phase){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_PARSER);
+    int valid = 0;
     char* line = NULL;
     size_t lsize = 0;
+    ssize_t length;
+#ifdef LOAD_STEPS
+    double steps[LOAD_N_STEPS] = {0};
+#endif
+    long accepted = 0, rejected = 0;
+    size_t bytes = 0;
 
     // Check if file is opened successfully
     if (f == NULL) {
@@ -37,7 +68,8 @@ void parseF (FILE* f, int max_fields, void_function func, void *catalog, FILE* e
     }
 
     // Write first line of the error csv
-    if (getline(&line, &lsize, f) != -1) {
+    if ((length = getline(&line, &lsize, f)) != -1) {
+        bytes += length;
         fprintf(error_f, "%s", line);
     } else {
         fprintf(stderr, "Error reading first line from file\n");
@@ -45,22 +77,48 @@ void parseF (FILE* f, int max_fields, void_function func, void *catalog, FILE* e
         return;
     }
 
-    while(getline(&line,&lsize,f) != -1){
+    // Rows are only timed step by step with LOAD_STEPS=1
+    STEP_CLOCK(t0);
+    while((length = getline(&line,&lsize,f)) != -1){
+        STEP_CLOCK(t1);
+        bytes += length;
+
         // Replace \n for \0
         line[strlen(line)-1] = '\0';
         char* temp;
         temp = strdup(line);
 
         char **fields = parseL(line, max_fields);
-        verify = func(fields,catalog);
+        STEP_CLOCK(t2);
+
+        valid = verify(fields,catalog);
+        STEP_CLOCK(t3);
 
-        if (verify == 0) {
+        if (valid) valid = build(fields,catalog);
+
+        if (valid == 0) {
             fprintf(error_f,"%s\n",temp);
+            rejected++;
         }
+        else accepted++;
         free(temp);
         free(fields);
+
+#ifdef LOAD_STEPS
+        STEP_CLOCK(t4);
+        steps[LOAD_READ] += t1 - t0;
+        steps[LOAD_TOKENIZE] += t2 - t1;
+        steps[LOAD_VALIDATE] += t3 - t2;
+        steps[LOAD_BUILD] += t4 - t3;
+        t0 = t4;
+#endif
     }
     free(line);
+
+#ifdef LOAD_STEPS
+    for (int i = 0; i < LOAD_N_STEPS; i++) add_load_step_time(phase, i, steps[i]);
+#endif
+    add_load_rows(phase, accepted, rejected, bytes);
 }
 
 char** parseL(char* line, int max_fields) {
@@ -0,0 +1,263 @@
+/**
+ * @file result.c
+ * @brief This file contains the implementation of the typed query result and its formatters.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+*/
+
+#include "IO/result.h"
+#include "utils/trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct field
+ * @brief A single typed value of a result row.
+ */
+struct field {
+    FIELD_TYPE type; /**< Type of the stored value. */
+    union {
+        long long i;   /**< Integer, packed date or packed date and time. */
+        double d;      /**< Real number. */
+        char* s;       /**< Owned string. */
+        const char* r; /**< Borrowed string. */
+    } value; /**< The stored value. */
+};
+
+/**
+ * @struct result
+ * @brief A table of typed rows that share one schema.
+ */
+struct result {
+    int n_fields; /**< Number of fields of each row. */
+    const char** names; /**< Names of the fields. */
+    int n_rows; /**< Number of rows. */
+    int capacity; /**< Number of rows that fit in the allocated storage. */
+    struct field* fields; /**< Row-major storage, n_fields values per row. */
+};
+
+RESULT create_result(int n_fields, const char** names){
+    RESULT new = malloc(sizeof(struct result));
+
+    new->n_fields = n_fields;
+    new->names = malloc(sizeof(char*) * n_fields);
+    memcpy(new->names, names, sizeof(char*) * n_fields);
+    new->n_rows = 0;
+    new->capacity = 0;
+    new->fields = NULL;
+
+    return new;
+}
+
+void set_result_name(RESULT result, int field, const char* name){
+    result->names[field] = name;
+}
+
+int add_result_row(RESULT result){
+    if (result->n_rows == result->capacity){
+        result->capacity = result->capacity == 0 ? 16 : result->capacity * 2;
+        result->fields = realloc(result->fields, sizeof(struct field) * result->capacity * result->n_fields);
+    }
+
+    struct field* row = result->fields + (size_t)result->n_rows * result->n_fields;
+    for (int i = 0; i < result->n_fields; i++){
+        row[i].type = FIELD_REF;
+        row[i].value.r = NULL;
+    }
+
+    return result->n_rows++;
+}
+
+/**
+ * @brief Get a field of a row.
+ *
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ * @return A pointer to the field.
+ */
+static struct field* get_field(RESULT result, int row, int field){
+    return result->fields + (size_t)row * result->n_fields + field;
+}
+
+void set_result_int(RESULT result, int row, int field, long long value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_INT;
+    f->value.i = value;
+}
+
+void set_result_double(RESULT result, int row, int field, double value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_DOUBLE;
+    f->value.d = value;
+}
+
+void set_result_string(RESULT result, int row, int field, char* value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_STRING;
+    f->value.s = value;
+}
+
+void set_result_ref(RESULT result, int row, int field, const char* value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_REF;
+    f->value.r = value;
+}
+
+void set_result_date(RESULT result, int row, int field, long long value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_DATE;
+    f->value.i = value;
+}
+
+void set_result_datetime(RESULT result, int row, int field, long long value){
+    struct field* f = get_field(result, row, field);
+    f->type = FIELD_DATETIME;
+    f->value.i = value;
+}
+
+int get_result_rows(RESULT result){
+    if (result == NULL) return 0;
+    return result->n_rows;
+}
+
+int get_result_fields(RESULT result){
+    return result->n_fields;
+}
+
+const char* get_result_name(RESULT result, int field){
+    return result->names[field];
+}
+
+FIELD_TYPE get_result_type(RESULT result, int row, int field){
+    return get_field(result, row, field)->type;
+}
+
+long long get_result_int(RESULT result, int row, int field){
+    return get_field(result, row, field)->value.i;
+}
+
+double get_result_double(RESULT result, int row, int field){
+    return get_field(result, row, field)->value.d;
+}
+
+const char* get_result_string(RESULT result, int row, int field){
+    struct field* f = get_field(result, row, field);
+    if (f->type == FIELD_STRING) return f->value.s;
+    if (f->type == FIELD_REF) return f->value.r;
+    return NULL;
+}
+
+int format_result_field(RESULT result, int row, int field, char* buffer, int size){
+    struct field* f = get_field(result, row, field);
+    long long v = f->value.i;
+
+    switch (f->type){
+        case FIELD_INT:
+            return snprintf(buffer, size, "%lld", v);
+        case FIELD_DOUBLE:
+            return snprintf(buffer, size, "%.3f", f->value.d);
+        case FIELD_DATE:
+            return snprintf(buffer, size, "%04lld/%02lld/%02lld", v / 10000, (v / 100) % 100, v % 100);
+        case FIELD_DATETIME:
+            return snprintf(buffer, size, "%04lld/%02lld/%02lld %02lld:%02lld:%02lld",
+                            v / 10000000000LL, (v / 100000000) % 100, (v / 1000000) % 100,
+                            (v / 10000) % 100, (v / 100) % 100, v % 100);
+        default:
+            return snprintf(buffer, size, "%s", get_result_string(result, row, field) ? get_result_string(result, row, field) : "False");
+    }
+}
+
+/**
+ * @brief Write a single field to a file.
+ *
+ * @param file The destination file.
+ * @param result The result.
+ * @param row The row index.
+ * @param field The field index.
+ */
+static void write_field(FILE* file, RESULT result, int row, int field){
+    struct field* f = get_field(result, row, field);
+
+    if (f->type == FIELD_STRING || f->type == FIELD_REF){
+        const char* s = get_result_string(result, row, field);
+        fputs(s ? s : "False", file);
+    }
+    else {
+        char buffer[32];
+        format_result_field(result, row, field, buffer, sizeof(buffer));
+        fputs(buffer, file);
+    }
+}
+
+char* format_result_row(RESULT result, int row){
+    int total_size = 1;
+    for (int i = 0; i < result->n_fields; i++){
+        total_size += format_result_field(result, row, i, NULL, 0) + 1;
+    }
+
+    char* line = malloc(total_size);
+    int pos = 0;
+    for (int i = 0; i < result->n_fields; i++){
+        if (i != 0) line[pos++] = ';';
+        pos += format_result_field(result, row, i, line + pos, total_size - pos);
+    }
+    line[pos] = '\0';
+
+    return line;
+}
+
+void write_result(FILE* file, RESULT result){
+    if (result == NULL) return;
+
+    for (int row = 0; row < result->n_rows; row++){
+        for (int i = 0; i < result->n_fields; i++){
+            if (i != 0) fputc(';', file);
+            write_field(file, result, row, i);
+        }
+        fputc('\n', file);
+    }
+}
+
+void write_result_F(FILE* file, RESULT result){
+    if (result == NULL) return;
+
+    for (int row = 0; row < result->n_rows; row++){
+        if (row != 0) fputc('\n', file);
+        fprintf(file, "--- %d ---\n", row + 1);
+        for (int i = 0; i < result->n_fields; i++){
+            fprintf(file, "%s: ", result->names[i]);
+            write_field(file, result, row, i);
+            fputc('\n', file);
+        }
+    }
+}
+
+void free_result(RESULT result){
+    TRACE_FUNCTION();
+    if (result == NULL) return;
+
+    int total = result->n_rows * result->n_fields;
+    for (int i = 0; i < total; i++){
+        if (result->fields[i].type == FIELD_STRING) free(result->fields[i].value.s);
+    }
+
+    free(result->fields);
+    free(result->names);
+    free(result);
+}
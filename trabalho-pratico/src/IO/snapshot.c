@@ -0,0 +1,349 @@
+/**
+ * @file snapshot.c
+ * @brief This file contains the implementation of the binary catalog snapshot and of its primitives.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+*/
+
+#include "IO/snapshot.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Magic number at the start of a snapshot.
+ */
+#define SNAPSHOT_MAGIC "FQSSNAP"
+
+/**
+ * @brief Length written in place of the length of a NULL string.
+ */
+#define SNAPSHOT_NULL_STRING UINT32_MAX
+
+/**
+ * @brief Temporary path where a snapshot is written before being renamed.
+ */
+#define SNAPSHOT_TMP_PATH SNAPSHOT_PATH ".tmp"
+
+/**
+ * @struct snapshot_header
+ * @brief The header at the start of every snapshot.
+ */
+struct snapshot_header {
+    char magic[8]; /**< SNAPSHOT_MAGIC. */
+    uint32_t version; /**< SNAPSHOT_VERSION. */
+    uint32_t n_files; /**< SNAPSHOT_N_FILES. */
+    uint64_t size; /**< Size of the whole snapshot, written when it is closed. */
+    uint64_t checksum; /**< Checksum of everything after the header, written when it is closed. */
+    SNAPSHOT_KEY keys[SNAPSHOT_N_FILES]; /**< Keys of the dataset files the snapshot was built from. */
+};
+
+/**
+ * @struct snapshot
+ * @brief A snapshot mapped in memory and the position of the next read.
+ */
+struct snapshot {
+    const char* data; /**< The mapped file. */
+    size_t size; /**< Size of the mapped file. */
+    size_t position; /**< Offset of the next read. */
+    int failed; /**< Whether a read went past the end of the file. */
+    uint64_t checksum; /**< The checksum stored in the header. */
+};
+
+/**
+ * @brief Whether set_catalogs uses the snapshot.
+ */
+static int snapshot_enabled = 1;
+
+void set_snapshot_enabled(int enabled){
+    snapshot_enabled = enabled;
+}
+
+int is_snapshot_enabled(void){
+    return snapshot_enabled;
+}
+
+/**
+ * @brief Checksum of a block of memory, eight bytes at a time.
+ *
+ * @param data The memory.
+ * @param size Its size in bytes.
+ * @return The checksum.
+ */
+static uint64_t checksum_bytes(const unsigned char* data, size_t size){
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8){
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        h = (h ^ word) * 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, data + i, size - i);
+    h = (h ^ tail) * 0x94d049bb133111ebULL;
+
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief Hash the contents of a file with 64 bit FNV-1a.
+ *
+ * @param path The file path.
+ * @param size The file size.
+ * @return The hash.
+ */
+static uint64_t hash_file(const char* path, int64_t size){
+    uint64_t hash = 14695981039346656037ULL;
+    if (size <= 0) return hash;
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return 0;
+
+    const unsigned char* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+
+    for (int64_t i = 0; i < size; i++){
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    munmap((void*)data, size);
+
+    return hash;
+}
+
+void get_snapshot_keys(char* path, SNAPSHOT_KEY* keys, int with_hash){
+    static const char* files[] = SNAPSHOT_FILES;
+    char file_path[4096];
+
+    for (int i = 0; i < SNAPSHOT_N_FILES; i++){
+        snprintf(file_path, sizeof(file_path), "%s/%s", path, files[i]);
+        memset(&keys[i], 0, sizeof(SNAPSHOT_KEY));
+
+        struct stat st;
+        if (stat(file_path, &st) == -1){
+            keys[i].size = -1;
+            continue;
+        }
+
+        keys[i].size = st.st_size;
+        keys[i].mtime_sec = st.st_mtim.tv_sec;
+        keys[i].mtime_nsec = st.st_mtim.tv_nsec;
+        if (with_hash) keys[i].hash = hash_file(file_path, keys[i].size);
+    }
+}
+
+FILE* create_snapshot_file(SNAPSHOT_KEY* keys){
+    // Opened for reading too, so that the checksum can be taken from the written file
+    FILE* file = fopen(SNAPSHOT_TMP_PATH, "w+b");
+    if (file == NULL) return NULL;
+
+    struct snapshot_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.n_files = SNAPSHOT_N_FILES;
+    memcpy(header.keys, keys, sizeof(header.keys));
+
+    fwrite(&header, sizeof(header), 1, file);
+
+    return file;
+}
+
+int close_snapshot_file(FILE* file){
+    uint64_t size = ftell(file);
+    uint64_t checksum = 0;
+    int failed = fflush(file) != 0;
+
+    const unsigned char* data = failed ? MAP_FAILED : mmap(NULL, size, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (data != MAP_FAILED){
+        checksum = checksum_bytes(data + sizeof(struct snapshot_header), size - sizeof(struct snapshot_header));
+        munmap((void*)data, size);
+    }
+    else failed = 1;
+
+    fseek(file, offsetof(struct snapshot_header, size), SEEK_SET);
+    fwrite(&size, sizeof(size), 1, file);
+    fwrite(&checksum, sizeof(checksum), 1, file);
+
+    failed |= ferror(file);
+    if (fclose(file) != 0 || failed){
+        remove(SNAPSHOT_TMP_PATH);
+        return -1;
+    }
+
+    return rename(SNAPSHOT_TMP_PATH, SNAPSHOT_PATH);
+}
+
+SNAPSHOT open_snapshot(char* path){
+    int fd = open(SNAPSHOT_PATH, O_RDONLY);
+    if (fd == -1) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(struct snapshot_header)){
+        close(fd);
+        return NULL;
+    }
+
+    const char* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    struct snapshot_header header;
+    memcpy(&header, data, sizeof(header));
+
+    SNAPSHOT_KEY keys[SNAPSHOT_N_FILES];
+    get_snapshot_keys(path, keys, 0);
+
+    int valid = memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+                header.version == SNAPSHOT_VERSION &&
+                header.n_files == SNAPSHOT_N_FILES &&
+                header.size == (uint64_t)st.st_size;
+
+    // Size and modification time are checked first, the hash only when they match
+    for (int i = 0; valid && i < SNAPSHOT_N_FILES; i++){
+        valid = keys[i].size == header.keys[i].size &&
+                keys[i].mtime_sec == header.keys[i].mtime_sec &&
+                keys[i].mtime_nsec == header.keys[i].mtime_nsec;
+    }
+    if (valid){
+        get_snapshot_keys(path, keys, 1);
+        for (int i = 0; valid && i < SNAPSHOT_N_FILES; i++){
+            valid = keys[i].hash == header.keys[i].hash;
+        }
+    }
+
+    if (!valid){
+        munmap((void*)data, st.st_size);
+        return NULL;
+    }
+
+    SNAPSHOT snapshot = malloc(sizeof(struct snapshot));
+    snapshot->data = data;
+    snapshot->size = st.st_size;
+    snapshot->position = sizeof(header);
+    snapshot->failed = 0;
+    snapshot->checksum = header.checksum;
+
+    return snapshot;
+}
+
+int verify_snapshot(SNAPSHOT snapshot){
+    const unsigned char* payload = (const unsigned char*)snapshot->data + sizeof(struct snapshot_header);
+    uint64_t checksum = checksum_bytes(payload, snapshot->size - sizeof(struct snapshot_header));
+
+    return checksum == snapshot->checksum ? 0 : -1;
+}
+
+int close_snapshot(SNAPSHOT snapshot){
+    int failed = snapshot->failed;
+
+    munmap((void*)snapshot->data, snapshot->size);
+    free(snapshot);
+
+    return failed ? -1 : 0;
+}
+
+void write_snapshot_int(FILE* file, int value){
+    int32_t v = value;
+    fwrite(&v, sizeof(v), 1, file);
+}
+
+void write_snapshot_double(FILE* file, double value){
+    fwrite(&value, sizeof(value), 1, file);
+}
+
+void write_snapshot_string(FILE* file, const char* value){
+    uint32_t length = value == NULL ? SNAPSHOT_NULL_STRING : strlen(value);
+    fwrite(&length, sizeof(length), 1, file);
+    if (value != NULL) fwrite(value, 1, length + 1, file);
+}
+
+void write_snapshot_bytes(FILE* file, const char* data, size_t size){
+    uint64_t length = size;
+    fwrite(&length, sizeof(length), 1, file);
+    if (size > 0) fwrite(data, 1, size, file);
+}
+
+/**
+ * @brief Advance the position of a snapshot.
+ *
+ * @param snapshot The snapshot.
+ * @param size The number of bytes to be read.
+ * @return A pointer to the bytes, or NULL if they go past the end of the snapshot.
+ */
+static const char* take(SNAPSHOT snapshot, size_t size){
+    if (snapshot->failed || snapshot->size - snapshot->position < size){
+        snapshot->failed = 1;
+        return NULL;
+    }
+
+    const char* data = snapshot->data + snapshot->position;
+    snapshot->position += size;
+
+    return data;
+}
+
+int read_snapshot_int(SNAPSHOT snapshot){
+    int32_t value = 0;
+    const char* data = take(snapshot, sizeof(value));
+    if (data != NULL) memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+double read_snapshot_double(SNAPSHOT snapshot){
+    double value = 0;
+    const char* data = take(snapshot, sizeof(value));
+    if (data != NULL) memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+const char* read_snapshot_string(SNAPSHOT snapshot){
+    uint32_t length;
+    const char* data = take(snapshot, sizeof(length));
+    if (data == NULL) return NULL;
+
+    memcpy(&length, data, sizeof(length));
+    if (length == SNAPSHOT_NULL_STRING) return NULL;
+
+    return take(snapshot, (size_t)length + 1);
+}
+
+char* read_snapshot_strdup(SNAPSHOT snapshot){
+    const char* value = read_snapshot_string(snapshot);
+    return value == NULL ? NULL : strdup(value);
+}
+
+const char* read_snapshot_bytes(SNAPSHOT snapshot, size_t* size){
+    uint64_t length = 0;
+    const char* data = take(snapshot, sizeof(length));
+    if (data != NULL) memcpy(&length, data, sizeof(length));
+
+    *size = 0;
+    data = take(snapshot, length);
+    if (data != NULL) *size = length;
+
+    return data;
+}
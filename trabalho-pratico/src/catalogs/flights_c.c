@@ -20,55 +20,124 @@
 */
 
 #include "catalogs/flights_c.h"
+#include "utils/alloc_stats.h"
 
 #include <glib.h>
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 /**
  * @struct flights_catalog
  * @brief Flight catalog structure that stores information about flights.
  */
 struct flights_catalog {
-    GHashTable* flights; /**< Hash table that maps flight IDs to flight objects.*/
-    GHashTable* flightsNumber; /**< Hash table that maps flight numbers to flight objects. */
+    ID_MAP flights; /**< Maps flight IDs to flight objects.*/
+    STRING_MAP flightsNumber; /**< Hash table that maps flight numbers to flight objects. */
+    STRING_MAP removed; /**< Hash table that maps the IDs of the flights removed for overbooking to their departure day. */
+    int indexed; /**< Whether the secondary indexes were already built. */
+    pthread_mutex_t lock; /**< Serializes the construction of the secondary indexes. */
 };
 
 FLIGHTS_C create_flight_c(void){
     FLIGHTS_C new_catalog = malloc(sizeof(struct flights_catalog));
 
-    new_catalog->flights = g_hash_table_new_full(g_str_hash, g_str_equal, free, (GDestroyNotify) free_flight);
-    new_catalog->flightsNumber = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+    new_catalog->flights = create_id_map("", free, (GDestroyNotify) free_flight);
+    new_catalog->flightsNumber = create_string_map(free, NULL);
+    new_catalog->removed = create_string_map(free, NULL);
+    new_catalog->indexed = 0;
+    pthread_mutex_init(&new_catalog->lock, NULL);
 
     return new_catalog;
 }
 
 void insert_flight_c(FLIGHT flight, FLIGHTS_C catalog, char* key){
-    g_hash_table_insert(catalog->flights, key, flight);
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    id_map_insert(catalog->flights, key, flight);
 }
 
 void insert_flightNumber_c(FLIGHTS_C catalog, char* key, char* day){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
     int dayN = ourAtoi(day);
-    if (g_hash_table_contains(catalog->flightsNumber, key)){
-        int *days = g_hash_table_lookup(catalog->flightsNumber, key);
+    if (string_map_contains(catalog->flightsNumber, key)){
+        int *days = string_map_lookup(catalog->flightsNumber, key);
         days[dayN - 1]++;
         free(key);
     } else{
         int* days = g_new(int, 31);
         memset(days, 0, sizeof(int) * 31);
         days[dayN - 1]++;
-        g_hash_table_insert(catalog->flightsNumber, key, days);
+        string_map_insert(catalog->flightsNumber, key, days);
     }
 }
 
+/**
+ * @brief Counts a flight departing on a given day.
+ *
+ * @param catalog The flight catalog.
+ * @param day The departure day, packed as YYYYMMDD.
+ */
+static void index_flight_day(FLIGHTS_C catalog, int day){
+    char key[16];
+    char dayS[16];
+    snprintf(key, sizeof(key), "%04d%02d", day / 10000, (day / 100) % 100);
+    snprintf(dayS, sizeof(dayS), "%02d", day % 100);
+
+    insert_flightNumber_c(catalog, strdup(key), dayS);
+}
+
+/**
+ * @brief Builds the secondary indexes of the flight catalog the first time they are needed.
+ *
+ * Safe to call from concurrent queries, the indexes are only built once.
+ *
+ * @param catalog The flight catalog.
+ */
+static void build_flight_indexes(FLIGHTS_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (__atomic_load_n(&catalog->indexed, __ATOMIC_ACQUIRE)) return;
+
+    pthread_mutex_lock(&catalog->lock);
+    if (!catalog->indexed){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        ID_MAP_ITER flight_iter;
+        gpointer key, value;
+        id_map_iter_init(&flight_iter, catalog->flights);
+        while (id_map_iter_next(&flight_iter, &key, &value)) {
+            index_flight_day(catalog, get_flight_departure_day((FLIGHT)value));
+        }
+
+        // Flights removed for overbooking were already counted when the CSV was loaded
+        STRING_MAP_ITER iter;
+        string_map_iter_init(&iter, catalog->removed);
+        while (string_map_iter_next(&iter, &key, &value)) {
+            index_flight_day(catalog, GPOINTER_TO_INT(value));
+        }
+
+        log_index_build("flightsNumber", elapsed_since(start));
+        __atomic_store_n(&catalog->indexed, 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&catalog->lock);
+}
+
 int* get_flightNumber_c(FLIGHTS_C catalog, char* key){
-    return g_hash_table_lookup(catalog->flightsNumber, key);
+    build_flight_indexes(catalog);
+    return string_map_lookup(catalog->flightsNumber, key);
 }
 
 FLIGHT get_flight_by_id(FLIGHTS_C catalog, char* id){
-    return g_hash_table_lookup(catalog->flights, id);
+    return id_map_lookup(catalog->flights, id);
+}
+
+void freeze_flights_c(FLIGHTS_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    freeze_id_map(catalog->flights);
 }
 
-GHashTable* get_hash_table_flight(FLIGHTS_C catalog){
+ID_MAP get_hash_table_flight(FLIGHTS_C catalog){
     return catalog->flights;
 }
 
@@ -80,22 +149,96 @@ void update_flight_c(FLIGHTS_C catalog, char* id){
     set_flight_nPassengers(flight, total + 1);
 }
 
+int get_flight_day_by_id(FLIGHTS_C catalog, char* id){
+    FLIGHT flight = get_flight_by_id(catalog, id);
+    if (flight != NULL) return get_flight_departure_day(flight);
+    return GPOINTER_TO_INT(string_map_lookup(catalog->removed, id));
+}
+
 void remove_flight_from_hash_table(FLIGHTS_C flights, char* flight_id) {
-    g_hash_table_remove(flights->flights, flight_id);
+    FLIGHT flight = get_flight_by_id(flights, flight_id);
+    if (flight == NULL) return;
+    string_map_insert(flights->removed, strdup(flight_id), GINT_TO_POINTER(get_flight_departure_day(flight)));
+    id_map_remove(flights->flights, flight_id);
+}
+
+void save_flights_c(FLIGHTS_C catalog, FILE* file){
+    write_snapshot_int(file, id_map_size(catalog->flights));
+
+    ID_MAP_ITER flight_iter;
+    gpointer key, value;
+    id_map_iter_init(&flight_iter, catalog->flights);
+    while (id_map_iter_next(&flight_iter, &key, &value)) {
+        save_flight((FLIGHT)value, file);
+    }
+
+    write_snapshot_int(file, string_map_size(catalog->removed));
+    STRING_MAP_ITER iter;
+    string_map_iter_init(&iter, catalog->removed);
+    while (string_map_iter_next(&iter, &key, &value)) {
+        write_snapshot_string(file, key);
+        write_snapshot_int(file, GPOINTER_TO_INT(value));
+    }
+}
+
+int load_flights_c(FLIGHTS_C catalog, SNAPSHOT snapshot){
+    int n = read_snapshot_int(snapshot);
+    for (int i = 0; i < n; i++){
+        if (!load_flight(snapshot, catalog)) return -1;
+    }
+
+    n = read_snapshot_int(snapshot);
+    for (int i = 0; i < n; i++){
+        char* id = read_snapshot_strdup(snapshot);
+        int day = read_snapshot_int(snapshot);
+        if (id == NULL) return -1;
+        string_map_insert(catalog->removed, id, GINT_TO_POINTER(day));
+    }
+
+    return 0;
+}
+
+void report_flights_c_memory(FLIGHTS_C catalog, MEMORY_REPORT report){
+    build_flight_indexes(catalog);
+
+    begin_memory_catalog(report, "flights", id_map_size(catalog->flights));
+    add_memory(report, MEMORY_BUCKETS, id_map_memory(catalog->flights) + string_map_memory(catalog->flightsNumber) +
+                                       string_map_memory(catalog->removed));
+
+    size_t structs = 0, strings = 0;
+    ID_MAP_ITER flight_iter;
+    gpointer key, value;
+    id_map_iter_init(&flight_iter, catalog->flights);
+    while (id_map_iter_next(&flight_iter, &key, &value)){
+        strings += string_memory(key);
+        structs += get_flight_memory((FLIGHT)value, &strings);
+    }
+
+    STRING_MAP_ITER iter;
+    string_map_iter_init(&iter, catalog->flightsNumber);
+    while (string_map_iter_next(&iter, &key, &value)) strings += string_memory(key);
+    string_map_iter_init(&iter, catalog->removed);
+    while (string_map_iter_next(&iter, &key, &value)) strings += string_memory(key);
+
+    add_memory(report, MEMORY_STRUCTS, structs);
+    add_memory(report, MEMORY_STRINGS, strings);
+    add_memory(report, MEMORY_DAY_COUNTS, string_map_size(catalog->flightsNumber) * 31 * sizeof(int));
 }
 
 void free_flight_c(FLIGHTS_C catalog){
-    g_hash_table_destroy(catalog->flights);
+    free_id_map(catalog->flights);
 
     // Free user hash table
-    GHashTableIter iter2;
+    STRING_MAP_ITER iter2;
     gpointer reserv_id, reservations;
-    g_hash_table_iter_init(&iter2, catalog->flightsNumber);
-    while (g_hash_table_iter_next(&iter2, &reserv_id, &reservations)) {
+    string_map_iter_init(&iter2, catalog->flightsNumber);
+    while (string_map_iter_next(&iter2, &reserv_id, &reservations)) {
         // Free the GPtrArray associated with each user
         int* reservations_array = reservations;
         g_free(reservations_array);
     }
-    g_hash_table_destroy(catalog->flightsNumber);
+    free_string_map(catalog->flightsNumber);
+    free_string_map(catalog->removed);
+    pthread_mutex_destroy(&catalog->lock);
     free(catalog);
 }
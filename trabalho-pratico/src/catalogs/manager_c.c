@@ -20,6 +20,22 @@
 */
 
 #include "catalogs/manager_c.h"
+#include "utils/alloc_stats.h"
+#include "utils/utils.h"
+
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+/**
+ * @struct entity_entry
+ * @brief An entry of the entity directory.
+ */
+struct entity_entry {
+    ENTITY_TYPE type;       /**< Type of the entity. */
+    void* handle;           /**< The entity. */
+    ENTITY_PROFILE profile; /**< Its query 1 profile. */
+};
 
 /**
  * @struct manager_catalog
@@ -30,6 +46,9 @@ struct manager_catalog {
     FLIGHTS_C flights;      /**< Flight catalog */
     RESERV_C reservations;  /**< Reservation catalog */
     PASS_C passengers;      /**< Passenger catalog */
+    STRING_MAP entities;   /**< Directory of every ID, borrowing its keys from the catalogs. */
+    int indexed;            /**< Whether the directory was already built. */
+    pthread_mutex_t lock;   /**< Serializes the construction of the directory. */
 };
 
 MANAGER create_manager_c(USERS_C users_c, FLIGHTS_C flights_c, RESERV_C reserv_c, PASS_C pass_c){
@@ -39,6 +58,9 @@ MANAGER create_manager_c(USERS_C users_c, FLIGHTS_C flights_c, RESERV_C reserv_c
     new->flights = flights_c;
     new->reservations = reserv_c;
     new->passengers = pass_c;
+    new->entities = create_string_map(NULL, g_free);
+    new->indexed = 0;
+    pthread_mutex_init(&new->lock, NULL);
 
     return new;
 }
@@ -59,10 +81,158 @@ PASS_C get_pass_c(MANAGER catalog){
     return catalog->passengers;
 }
 
+/**
+ * @brief Add an entity to the directory, replacing the one already there with the same ID.
+ */
+static struct entity_entry* add_entity(MANAGER catalog, char* id, ENTITY_TYPE type, void* handle){
+    struct entity_entry* entry = g_new0(struct entity_entry, 1);
+    entry->type = type;
+    entry->handle = handle;
+    entry->profile.active = 1;
+    string_map_insert(catalog->entities, id, entry);
+    return entry;
+}
+
+/**
+ * @brief Builds the entity directory the first time it is needed.
+ *
+ * Users are added first so that flights and reservations with the same ID replace them.
+ * Safe to call from concurrent queries, the directory is only built once.
+ *
+ * @param catalog The manager catalog.
+ */
+static void build_entity_directory(MANAGER catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (__atomic_load_n(&catalog->indexed, __ATOMIC_ACQUIRE)) return;
+
+    pthread_mutex_lock(&catalog->lock);
+    if (!catalog->indexed){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        STRING_MAP_ITER iter;
+        gpointer key, value;
+
+        string_map_iter_init(&iter, get_hash_table_users(catalog->users));
+        while (string_map_iter_next(&iter, &key, &value)){
+            USER user = value;
+            ENTITY_PROFILE* profile = &add_entity(catalog, key, ENTITY_USER, user)->profile;
+            char* status = get_user_account_status(user);
+            profile->active = strcmp(status, "INACTIVE") != 0;
+            profile->age = get_user_age(user);
+            profile->flights = get_user_array_number_id(catalog->passengers, key);
+            profile->reservations = get_user_array_reserv_id(catalog->reservations, key);
+            profile->total = get_user_total_spent(user);
+            free(status);
+        }
+
+        ID_MAP_ITER id_iter;
+        id_map_iter_init(&id_iter, get_hash_table_reserv(catalog->reservations));
+        while (id_map_iter_next(&id_iter, &key, &value)){
+            if (strncmp(key, "Book", 4) != 0) continue;
+
+            RESERV reserv = value;
+            ENTITY_PROFILE* profile = &add_entity(catalog, key, ENTITY_RESERVATION, reserv)->profile;
+            char* begin = get_begin_date(reserv);
+            char* end = get_end_date(reserv);
+            profile->nights = get_number_of_nights(reserv);
+            profile->total = get_cost(reserv);
+            profile->begin = pack_date(begin);
+            profile->end = pack_date(end);
+            free(begin);
+            free(end);
+        }
+
+        id_map_iter_init(&id_iter, get_hash_table_flight(catalog->flights));
+        while (id_map_iter_next(&id_iter, &key, &value)){
+            char* id = key;
+            int i = 0;
+            while (isDigit(id[i])) i++;
+            if (id[i] != '\0') continue;
+
+            FLIGHT flight = value;
+            ENTITY_PROFILE* profile = &add_entity(catalog, key, ENTITY_FLIGHT, flight)->profile;
+            char* departure = get_flight_schedule_departure_date(flight);
+            char* arrival = get_flight_schedule_arrival_date(flight);
+            profile->flights = get_flight_nPassengers(flight);
+            profile->delay = get_flight_delay(flight);
+            profile->begin = pack_datetime(departure);
+            profile->end = pack_datetime(arrival);
+            free(departure);
+            free(arrival);
+        }
+
+        log_index_build("entity directory", elapsed_since(start));
+        __atomic_store_n(&catalog->indexed, 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&catalog->lock);
+}
+
+const ENTITY_PROFILE* get_entity_c(MANAGER catalog, char* id, ENTITY_TYPE* type, void** handle){
+    build_entity_directory(catalog);
+
+    struct entity_entry* entry = string_map_lookup(catalog->entities, id);
+    if (entry == NULL) return NULL;
+
+    *type = entry->type;
+    *handle = entry->handle;
+    return &entry->profile;
+}
+
+void freeze_manager_c(MANAGER catalog){
+    freeze_users_c(catalog->users);
+    freeze_flights_c(catalog->flights);
+    freeze_reservations_c(catalog->reservations);
+}
+
+void save_manager_c(MANAGER catalog, FILE* file){
+    save_users_c(catalog->users, file);
+    save_flights_c(catalog->flights, file);
+    save_reservations_c(catalog->reservations, file);
+    save_passengers_c(catalog->passengers, file);
+}
+
+int load_manager_c(MANAGER catalog, SNAPSHOT snapshot){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (load_users_c(catalog->users, snapshot) == -1) return -1;
+    if (load_flights_c(catalog->flights, snapshot) == -1) return -1;
+    if (load_reservations_c(catalog->reservations, snapshot) == -1) return -1;
+    return load_passengers_c(catalog->passengers, snapshot);
+}
+
+void reset_manager_c(MANAGER catalog){
+    free_flight_c(catalog->flights);
+    free_user_c(catalog->users);
+    free_reservations_c(catalog->reservations);
+    free_passengers_c(catalog->passengers);
+    free_string_map(catalog->entities);
+
+    catalog->users = create_user_c();
+    catalog->flights = create_flight_c();
+    catalog->reservations = create_reservations_c();
+    catalog->passengers = create_passengers_c();
+    catalog->entities = create_string_map(NULL, g_free);
+    catalog->indexed = 0;
+}
+
+void report_manager_c_memory(MANAGER catalog, MEMORY_REPORT report){
+    report_users_c_memory(catalog->users, report);
+    report_flights_c_memory(catalog->flights, report);
+    report_reservations_c_memory(catalog->reservations, report);
+    report_passengers_c_memory(catalog->passengers, catalog->flights, report);
+
+    build_entity_directory(catalog);
+    begin_memory_catalog(report, "entity directory", string_map_size(catalog->entities));
+    add_memory(report, MEMORY_BUCKETS, string_map_memory(catalog->entities));
+    add_memory(report, MEMORY_STRUCTS, string_map_size(catalog->entities) * sizeof(struct entity_entry));
+}
+
 void free_manager_c(MANAGER catalog){
     free_flight_c(catalog->flights);
     free_user_c(catalog->users);
     free_reservations_c(catalog->reservations);
     free_passengers_c(catalog->passengers);
+    free_string_map(catalog->entities);
+    pthread_mutex_destroy(&catalog->lock);
     free(catalog);
 }
@@ -20,68 +20,233 @@
 */
 
 #include "catalogs/passengers_c.h"
+#include "utils/alloc_stats.h"
+#include "utils/index_builder.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 /**
  * @struct passengers_catalog
  * @brief A catalog for storing passenger records.
+ *
+ * Users and flights are given dense indexes, so that a passenger is a pair of 32 bit indexes
+ * instead of a copy of each ID. The pairs read during the load are built into the flights of each
+ * user, and from those into the users of each day, the first time they are needed.
  */
 struct passengers_catalog {
-    GHashTable* users; /**< Hash table to store flights of users records. */
-    GHashTable* passengers;
+    INDEX_BUILDER pending; /**< Flights of each user read since user_flights was built, NULL while it is. */
+    REVERSE_INDEX user_flights; /**< Flights of each user, whose rows are the user indexes. NULL until built. */
+    STRING_MAP flight_index; /**< Maps each flight ID to its index plus one. */
+    GPtrArray* flight_ids; /**< ID of each flight index, borrowed from flight_index. */
+    REVERSE_INDEX day_users; /**< Users that flew on each day, as YYYYMMDD. NULL until built. */
+    pthread_mutex_t lock; /**< Serializes the construction of the reverse indexes. */
 };
 
 PASS_C create_passengers_c(void){
     PASS_C new = malloc(sizeof(struct passengers_catalog));
 
-    new->users = g_hash_table_new_full(g_str_hash, g_str_equal, free, free_ptr_array);
-    new->passengers = g_hash_table_new_full(g_str_hash, g_str_equal, free, free_ptr_array);
+    new->pending = create_index_builder(1);
+    new->user_flights = NULL;
+    new->flight_index = create_string_map(free, NULL);
+    new->flight_ids = g_ptr_array_new();
+    new->day_users = NULL;
+    pthread_mutex_init(&new->lock, NULL);
 
     return new;
 }
 
+/**
+ * @brief Get the index of a flight, giving it the next one (and copying its ID) the first time it is seen.
+ *
+ * @param catalog The passengers catalog.
+ * @param id The flight ID.
+ * @return The index.
+ */
+static uint32_t flight_index(PASS_C catalog, const char* id){
+    uint32_t i = GPOINTER_TO_UINT(string_map_lookup(catalog->flight_index, id));
+    if (i != 0) return i - 1;
+
+    char* copy = strdup(id);
+    string_map_insert(catalog->flight_index, copy, GUINT_TO_POINTER(catalog->flight_ids->len + 1));
+    g_ptr_array_add(catalog->flight_ids, copy);
+    return catalog->flight_ids->len - 1;
+}
+
 void insert_pass_user_c(char* flight_id, PASS_C catalog, char* key){
-    if (g_hash_table_contains(catalog->users, key)){
-        GPtrArray* flightArray = g_hash_table_lookup(catalog->users,key);
-        g_ptr_array_add(flightArray, flight_id);
-        free(key);
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+
+    // Passengers inserted after the indexes were built go back to recording edges
+    if (catalog->user_flights != NULL){
+        catalog->pending = thaw_reverse_index(catalog->user_flights);
+        catalog->user_flights = NULL;
+        free_reverse_index(catalog->day_users);
+        catalog->day_users = NULL;
     }
-    else {
-        GPtrArray* flightArray = g_ptr_array_new();
-        g_ptr_array_add(flightArray, flight_id);
-        g_hash_table_insert(catalog->users, key, flightArray);
+
+    add_index_edge(catalog->pending, key, flight_index(catalog, flight_id));
+}
+
+/**
+ * @brief Builds the flights of each user from the passengers read the first time they are needed.
+ *
+ * Safe to call from concurrent queries, the index is only built once.
+ *
+ * @param catalog The passengers catalog.
+ */
+static void build_user_flights(PASS_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (__atomic_load_n(&catalog->user_flights, __ATOMIC_ACQUIRE) != NULL) return;
+
+    pthread_mutex_lock(&catalog->lock);
+    if (catalog->user_flights == NULL){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        REVERSE_INDEX user_flights = build_reverse_index(catalog->pending);
+        catalog->pending = NULL;
+
+        log_index_build("user flights", elapsed_since(start));
+        __atomic_store_n(&catalog->user_flights, user_flights, __ATOMIC_RELEASE);
     }
+    pthread_mutex_unlock(&catalog->lock);
 }
 
-void insert_passengers_c(PASS_C catalog, char* key, char* user){
-    if (g_hash_table_contains(catalog->passengers, key)){
-        GPtrArray* userArray = g_hash_table_lookup(catalog->passengers,key);
-        g_ptr_array_add(userArray, user);
-        free(key);
-    } else{
-        GPtrArray* userArray = g_ptr_array_new();
-        g_ptr_array_add(userArray, user);
-        g_hash_table_insert(catalog->passengers, key, userArray);
+/**
+ * @brief Builds the users of each day from the flights of each user the first time they are needed.
+ *
+ * Safe to call from concurrent queries, the index is only built once.
+ *
+ * @param catalog The passengers catalog.
+ * @param flights The flights catalog, where the departure days are looked up.
+ */
+static void build_day_users(PASS_C catalog, FLIGHTS_C flights){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (__atomic_load_n(&catalog->day_users, __ATOMIC_ACQUIRE) != NULL) return;
+    build_user_flights(catalog);
+
+    pthread_mutex_lock(&catalog->lock);
+    if (catalog->day_users == NULL){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        // The day of each flight is looked up once, however many passengers it had
+        INDEX_BUILDER days = create_index_builder(1);
+        uint32_t* flight_day = malloc(sizeof(uint32_t) * (catalog->flight_ids->len + 1));
+        for (guint f = 0; f < catalog->flight_ids->len; f++){
+            char dayKey[16];
+            snprintf(dayKey, sizeof(dayKey), "%08d", get_flight_day_by_id(flights, g_ptr_array_index(catalog->flight_ids, f)));
+            flight_day[f] = add_index_key(days, dayKey);
+        }
+
+        for (uint32_t user = 0; user < get_reverse_index_keys(catalog->user_flights); user++){
+            uint32_t count;
+            const uint32_t* user_flights = get_reverse_index_row(catalog->user_flights, user, &count);
+            for (uint32_t i = 0; i < count; i++) add_index_row_edge(days, flight_day[user_flights[i]], user);
+        }
+        free(flight_day);
+
+        REVERSE_INDEX day_users = build_reverse_index(days);
+
+        log_index_build("passengers", elapsed_since(start));
+        __atomic_store_n(&catalog->day_users, day_users, __ATOMIC_RELEASE);
     }
+    pthread_mutex_unlock(&catalog->lock);
 }
 
-GPtrArray* get_passengers_c(PASS_C catalog, char* key){
-    return g_hash_table_lookup(catalog->passengers, key);
+const uint32_t* get_passengers_c(PASS_C catalog, FLIGHTS_C flights, char* key, uint32_t* count){
+    build_day_users(catalog, flights);
+    return get_reverse_index_values(catalog->day_users, key, count);
 }
 
-GPtrArray* get_user_array_by_id(PASS_C catalog, char* id){
-    return g_hash_table_lookup(catalog->users, id);
+const uint32_t* get_user_flights_c(PASS_C catalog, char* id, uint32_t* count){
+    build_user_flights(catalog);
+    return get_reverse_index_values(catalog->user_flights, id, count);
 }
 
 int get_user_array_number_id(PASS_C catalog, char* id){
-    GPtrArray* user_array = get_user_array_by_id(catalog, id);
-    if (!user_array) return 0;
-    return user_array->len;
+    uint32_t count;
+    get_user_flights_c(catalog, id, &count);
+    return count;
+}
+
+char* get_pass_user_id_c(PASS_C catalog, uint32_t user){
+    build_user_flights(catalog);
+    return get_reverse_index_key(catalog->user_flights, user);
+}
+
+char* get_pass_flight_id_c(PASS_C catalog, uint32_t flight){
+    return g_ptr_array_index(catalog->flight_ids, flight);
+}
+
+uint32_t get_pass_n_users_c(PASS_C catalog){
+    build_user_flights(catalog);
+    return get_reverse_index_keys(catalog->user_flights);
+}
+
+void save_passengers_c(PASS_C catalog, FILE* file){
+    build_user_flights(catalog);
+    write_snapshot_int(file, get_reverse_index_keys(catalog->user_flights));
+
+    for (uint32_t user = 0; user < get_reverse_index_keys(catalog->user_flights); user++){
+        uint32_t count;
+        const uint32_t* flights = get_reverse_index_row(catalog->user_flights, user, &count);
+
+        write_snapshot_string(file, get_reverse_index_key(catalog->user_flights, user));
+        write_snapshot_int(file, count);
+        for (uint32_t i = 0; i < count; i++) write_snapshot_string(file, get_pass_flight_id_c(catalog, flights[i]));
+    }
+}
+
+int load_passengers_c(PASS_C catalog, SNAPSHOT snapshot){
+    int n = read_snapshot_int(snapshot);
+
+    for (int i = 0; i < n; i++){
+        char* user = read_snapshot_strdup(snapshot);
+        int len = read_snapshot_int(snapshot);
+        if (user == NULL || len < 0){
+            free(user);
+            return -1;
+        }
+
+        for (int j = 0; j < len; j++){
+            char* flight = read_snapshot_strdup(snapshot);
+            if (flight == NULL){
+                free(user);
+                return -1;
+            }
+            insert_pass_user_c(flight, catalog, user);
+            free(flight);
+        }
+        free(user);
+    }
+
+    return 0;
+}
+
+void report_passengers_c_memory(PASS_C catalog, FLIGHTS_C flights, MEMORY_REPORT report){
+    build_day_users(catalog, flights);
+
+    begin_memory_catalog(report, "passengers", get_reverse_index_edges(catalog->user_flights));
+    report_reverse_index_memory(catalog->user_flights, report);
+    report_reverse_index_memory(catalog->day_users, report);
+
+    size_t strings = 0;
+    for (guint f = 0; f < catalog->flight_ids->len; f++) strings += string_memory(g_ptr_array_index(catalog->flight_ids, f));
+    add_memory(report, MEMORY_BUCKETS, string_map_memory(catalog->flight_index));
+    add_memory(report, MEMORY_STRINGS, strings);
+    add_memory(report, MEMORY_ARRAYS, ptr_array_memory(catalog->flight_ids));
 }
 
 void free_passengers_c(PASS_C catalog){
-    g_hash_table_destroy(catalog->users);
-    g_hash_table_destroy(catalog->passengers);
+    free_index_builder(catalog->pending);
+    free_reverse_index(catalog->user_flights);
+    free_reverse_index(catalog->day_users);
+    g_ptr_array_free(catalog->flight_ids, TRUE);
+    free_string_map(catalog->flight_index);
+    pthread_mutex_destroy(&catalog->lock);
 
     free(catalog);
 }
-
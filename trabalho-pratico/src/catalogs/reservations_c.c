@@ -20,138 +20,292 @@
 */
 
 #include "catalogs/reservations_c.h"
+#include "utils/alloc_stats.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+/**
+ * @struct hotel_rating
+ * @brief Running aggregates of the ratings of a hotel's reservations.
+ */
+struct hotel_rating {
+    int sum; /**< Sum of the ratings. */
+    int count; /**< Number of rated reservations. */
+    int histogram[HOTEL_MAX_RATING + 1]; /**< Number of reservations with each rating. */
+};
 
 /**
  * @struct reservations_catalog
  * @brief A catalog for storing reservation records.
  */
 struct reservations_catalog {
-    GHashTable* reserv; /**< Hash table to store reservation records. */
-    GHashTable* user; /**< Hash table to store all user's reservations*/
-    GHashTable* hotel; /**< Hash table to store all hotel's reservations.*/
-    GHashTable* reservNumber;
+    ID_MAP reserv; /**< Maps reservation IDs to reservation records. */
+    RESERV* sorted; /**< Every reservation by begin date (most recent first) and then ID, the positions the user and hotel indexes refer to. */
+    REVERSE_INDEX user; /**< Reservations of each user. */
+    REVERSE_INDEX hotel; /**< Reservations of each hotel, in the order of sorted. */
+    INDEX_BUILDER pending; /**< Builder of the index being built. */
+    STRING_MAP reservNumber;
+    STRING_MAP rating; /**< Hash table to store the rating aggregates of each hotel. */
+    int indexed[RESERV_N_INDEXES]; /**< Whether each secondary index was already built. */
+    pthread_mutex_t lock; /**< Serializes the construction of the secondary indexes. */
 };
 
 RESERV_C create_reservations_c(void){
     RESERV_C new = malloc(sizeof(struct reservations_catalog));
 
-    new->reserv = g_hash_table_new_full(g_str_hash, g_str_equal, free, (GDestroyNotify)free_reservations);
-    new->user = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, NULL);
-    new->hotel = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, NULL);
-    new->reservNumber = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+    new->reserv = create_id_map("Book", free, (GDestroyNotify)free_reservations);
+    new->sorted = NULL;
+    new->user = NULL;
+    new->hotel = NULL;
+    new->pending = NULL;
+    new->reservNumber = create_string_map(free, NULL);
+    new->rating = create_string_map(NULL, g_free);
+    memset(new->indexed, 0, sizeof(new->indexed));
+    pthread_mutex_init(&new->lock, NULL);
 
     return new;
 }
 
 void insert_reservations_c(RESERV reserv, RESERV_C catalog, char* key){
-    g_hash_table_insert(catalog->reserv, key, reserv);
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    id_map_insert(catalog->reserv, key, reserv);
 }
 
-void insert_usersReservations_c(char* reserv_id, RESERV_C catalog, char* key){
-    if(g_hash_table_contains(catalog->user, key)){
-        GPtrArray* reservations = g_hash_table_lookup(catalog->user, key);
-        g_ptr_array_add(reservations, reserv_id);
-    }
-    else{
-        GPtrArray* reservations = g_ptr_array_new();
-        g_ptr_array_add(reservations, reserv_id);
-        g_hash_table_insert(catalog->user, key, reservations);
-    }
+void insert_usersReservations_c(uint32_t reserv, RESERV_C catalog, char* key){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    add_index_edge(catalog->pending, key, reserv);
 }
 
-void insert_hotelsReservations_c(char* reserv_id, RESERV_C catalog, char* key){
-    if(g_hash_table_contains(catalog->hotel, key)){
-        GPtrArray* reservations = g_hash_table_lookup(catalog->hotel, key);
-        g_ptr_array_add(reservations, reserv_id);
-    }
-    else{
-        GPtrArray* reservations = g_ptr_array_new();
-        g_ptr_array_add(reservations, reserv_id);
-        g_hash_table_insert(catalog->hotel, key, reservations);
-    }
+void insert_hotelsReservations_c(uint32_t reserv, RESERV_C catalog, char* key){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    add_index_edge(catalog->pending, key, reserv);
 }
 
 void insert_reservNumber_c(RESERV_C catalog, char* key, char* day){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
     int dayN = ourAtoi(day);
-    if (g_hash_table_contains(catalog->reservNumber, key)){
-        int* days = g_hash_table_lookup(catalog->reservNumber, key);
+    if (string_map_contains(catalog->reservNumber, key)){
+        int* days = string_map_lookup(catalog->reservNumber, key);
         days[dayN - 1]++;
         free(key);
     } else{
         int* days = g_new(int, 31);
         memset(days, 0, sizeof(int) * 31);
         days[dayN - 1]++;
-        g_hash_table_insert(catalog->reservNumber, key, days);
+        string_map_insert(catalog->reservNumber, key, days);
+    }
+}
+
+void insert_hotel_rating_c(RESERV_C catalog, char* hotel_id, int rating){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    struct hotel_rating* aggregate = string_map_lookup(catalog->rating, hotel_id);
+    if (aggregate == NULL){
+        aggregate = g_new0(struct hotel_rating, 1);
+        string_map_insert(catalog->rating, hotel_id, aggregate);
     }
+
+    if (rating < 1 || rating > HOTEL_MAX_RATING) return;
+    aggregate->sum += rating;
+    aggregate->count++;
+    aggregate->histogram[rating]++;
+}
+
+/**
+ * @brief Sorts every reservation by begin date and ID, once, for the user and hotel indexes.
+ *
+ * @param catalog The reservation catalog, whose lock is held.
+ */
+static void sort_reservations(RESERV_C catalog){
+    if (catalog->sorted != NULL) return;
+
+    catalog->sorted = malloc(sizeof(RESERV) * (id_map_size(catalog->reserv) + 1));
+    size_t n = 0;
+    ID_MAP_ITER iter;
+    gpointer key, value;
+    id_map_iter_init(&iter, catalog->reserv);
+    while (id_map_iter_next(&iter, &key, &value)) catalog->sorted[n++] = value;
+
+    sort_reservations_by_begin(catalog->sorted, n);
+}
+
+/**
+ * @brief Builds a secondary index of the reservation catalog the first time it is needed.
+ *
+ * Safe to call from concurrent queries, each index is only built once.
+ *
+ * @param catalog The reservation catalog.
+ * @param index The index.
+ */
+static void build_reservation_index(RESERV_C catalog, RESERV_INDEX index){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    static const char* names[] = {"user reservations", "hotel reservations", "reservNumber"};
+
+    if (__atomic_load_n(&catalog->indexed[index], __ATOMIC_ACQUIRE)) return;
+
+    pthread_mutex_lock(&catalog->lock);
+    if (!catalog->indexed[index]){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        if (index == RESERV_BY_DAY){
+            ID_MAP_ITER reserv_iter;
+            gpointer key, value;
+            id_map_iter_init(&reserv_iter, catalog->reserv);
+            while (id_map_iter_next(&reserv_iter, &key, &value)) {
+                index_reservation((RESERV)value, 0, catalog, index);
+            }
+        }
+        else {
+            // Recorded in the order query 4 lists them, which the rows of each key then keep
+            sort_reservations(catalog);
+            uint32_t n = id_map_size(catalog->reserv);
+            catalog->pending = create_index_builder(0);
+            for (uint32_t i = 0; i < n; i++) index_reservation(catalog->sorted[i], i, catalog, index);
+
+            REVERSE_INDEX built = build_reverse_index(catalog->pending);
+            catalog->pending = NULL;
+            if (index == RESERV_BY_USER) catalog->user = built;
+            else catalog->hotel = built;
+        }
+
+        log_index_build(names[index], elapsed_since(start));
+        __atomic_store_n(&catalog->indexed[index], 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&catalog->lock);
 }
 
 int* get_reservNumber_c(RESERV_C catalog, char* key){
-    return g_hash_table_lookup(catalog->reservNumber, key);
+    build_reservation_index(catalog, RESERV_BY_DAY);
+    return string_map_lookup(catalog->reservNumber, key);
 }
 
 RESERV get_reservations_by_id(RESERV_C catalog, char* id){
-    return g_hash_table_lookup(catalog->reserv, id);
+    return id_map_lookup(catalog->reserv, id);
+}
+
+void freeze_reservations_c(RESERV_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    freeze_id_map(catalog->reserv);
+}
+
+RESERV get_reservation_at_c(RESERV_C catalog, uint32_t reserv){
+    return catalog->sorted[reserv];
+}
+
+const uint32_t* get_user_reservations_c(RESERV_C catalog, char* user_id, uint32_t* count){
+    build_reservation_index(catalog, RESERV_BY_USER);
+    return get_reverse_index_values(catalog->user, user_id, count);
 }
 
-GPtrArray* get_user_reserv_array_by_id(RESERV_C catalog, char* user_id){
-    return g_hash_table_lookup(catalog->user, user_id);
+const uint32_t* get_hotel_reservations_c(RESERV_C catalog, char* hotel_id, uint32_t* count){
+    build_reservation_index(catalog, RESERV_BY_HOTEL);
+    return get_reverse_index_values(catalog->hotel, hotel_id, count);
 }
 
-GPtrArray* get_hotel_reserv_array_by_id(RESERV_C catalog, char* hotel_id){
-    return g_hash_table_lookup(catalog->hotel, hotel_id);
+double get_hotel_average_rating_c(RESERV_C catalog, char* hotel_id){
+    struct hotel_rating* aggregate = string_map_lookup(catalog->rating, hotel_id);
+    if (aggregate == NULL || aggregate->count == 0) return 0;
+    return aggregate->sum / (double)aggregate->count;
+}
+
+int get_hotel_rating_histogram_c(RESERV_C catalog, char* hotel_id, int* histogram){
+    struct hotel_rating* aggregate = string_map_lookup(catalog->rating, hotel_id);
+    if (aggregate == NULL){
+        memset(histogram, 0, sizeof(int) * (HOTEL_MAX_RATING + 1));
+        return 0;
+    }
+
+    memcpy(histogram, aggregate->histogram, sizeof(aggregate->histogram));
+    return aggregate->count;
 }
 
 int get_user_array_reserv_id(RESERV_C catalog, char* id){
-    GPtrArray* user_array = get_user_reserv_array_by_id(catalog, id);
-    if (!user_array) return 0;
-    return user_array->len;
+    uint32_t count;
+    get_user_reservations_c(catalog, id, &count);
+    return count;
 }
 
 int get_number_reserv_id(RESERV_C catalog){
-    return g_hash_table_size(catalog->reserv);
+    return id_map_size(catalog->reserv);
 }
 
-GHashTable* get_hash_table_reserv(RESERV_C catalog){
+ID_MAP get_hash_table_reserv(RESERV_C catalog){
     return catalog->reserv;
 }
 
-void free_reservations_c(RESERV_C catalog){
-    g_hash_table_destroy(catalog->reserv);
+void save_reservations_c(RESERV_C catalog, FILE* file){
+    write_snapshot_int(file, id_map_size(catalog->reserv));
 
-    // Free user hash table
-    GHashTableIter iter;
-    gpointer user_id, user_reservations;
-    g_hash_table_iter_init(&iter, catalog->user);
-    while (g_hash_table_iter_next(&iter, &user_id, &user_reservations)) {
-        // Free the GPtrArray associated with each user
-        GPtrArray *reservations_array = user_reservations;
-        g_ptr_array_free(reservations_array, TRUE);
+    ID_MAP_ITER iter;
+    gpointer key, value;
+    id_map_iter_init(&iter, catalog->reserv);
+    while (id_map_iter_next(&iter, &key, &value)) {
+        save_reservation((RESERV)value, file);
     }
+}
 
-    g_hash_table_destroy(catalog->user);
+int load_reservations_c(RESERV_C catalog, SNAPSHOT snapshot){
+    int n = read_snapshot_int(snapshot);
+    for (int i = 0; i < n; i++){
+        if (!load_reservation(snapshot, catalog)) return -1;
+    }
 
-    // Free user hash table
-    GHashTableIter iter1;
-    gpointer hotel_id, hotel_reservations;
-    g_hash_table_iter_init(&iter1, catalog->hotel);
-    while (g_hash_table_iter_next(&iter1, &hotel_id, &hotel_reservations)) {
-        // Free the GPtrArray associated with each user
-        GPtrArray *reservations_array = hotel_reservations;
-        g_ptr_array_free(reservations_array, TRUE);
+    return 0;
+}
+
+void report_reservations_c_memory(RESERV_C catalog, MEMORY_REPORT report){
+    for (int i = 0; i < RESERV_N_INDEXES; i++) build_reservation_index(catalog, i);
+
+    begin_memory_catalog(report, "reservations", id_map_size(catalog->reserv));
+    add_memory(report, MEMORY_BUCKETS, id_map_memory(catalog->reserv) + string_map_memory(catalog->reservNumber) +
+                                       string_map_memory(catalog->rating));
+    report_reverse_index_memory(catalog->user, report);
+    report_reverse_index_memory(catalog->hotel, report);
+
+    size_t structs = 0, strings = 0;
+    ID_MAP_ITER reserv_iter;
+    gpointer key, value;
+    id_map_iter_init(&reserv_iter, catalog->reserv);
+    while (id_map_iter_next(&reserv_iter, &key, &value)){
+        strings += string_memory(key);
+        structs += get_reservation_memory((RESERV)value, &strings);
     }
+    structs += string_map_size(catalog->rating) * sizeof(struct hotel_rating);
+
+    // The user and hotel indexes borrow their keys from the reservations
+    add_memory(report, MEMORY_ARRAYS, sizeof(RESERV) * id_map_size(catalog->reserv));
+
+    STRING_MAP_ITER iter;
+    string_map_iter_init(&iter, catalog->reservNumber);
+    while (string_map_iter_next(&iter, &key, &value)) strings += string_memory(key);
+
+    add_memory(report, MEMORY_STRUCTS, structs);
+    add_memory(report, MEMORY_STRINGS, strings);
+    add_memory(report, MEMORY_DAY_COUNTS, string_map_size(catalog->reservNumber) * 31 * sizeof(int));
+}
+
+void free_reservations_c(RESERV_C catalog){
+    free_id_map(catalog->reserv);
 
-    g_hash_table_destroy(catalog->hotel);
+    free(catalog->sorted);
+    free_reverse_index(catalog->user);
+    free_reverse_index(catalog->hotel);
 
     // Free user hash table
-    GHashTableIter iter2;
+    STRING_MAP_ITER iter2;
     gpointer reserv_id, reservations;
-    g_hash_table_iter_init(&iter2, catalog->reservNumber);
-    while (g_hash_table_iter_next(&iter2, &reserv_id, &reservations)) {
+    string_map_iter_init(&iter2, catalog->reservNumber);
+    while (string_map_iter_next(&iter2, &reserv_id, &reservations)) {
         // Free the GPtrArray associated with each user
         int* reservations_array = reservations;
         g_free(reservations_array);
     }
-    g_hash_table_destroy(catalog->reservNumber);
+    free_string_map(catalog->reservNumber);
+    free_string_map(catalog->rating);
+    pthread_mutex_destroy(&catalog->lock);
 
     free(catalog);
 }
@@ -20,49 +20,101 @@
 */
 
 #include "catalogs/users_c.h"
+#include "utils/alloc_stats.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
 
 /**
  * @struct users_catalog
  * @brief User catalog structure that stores information about users.
  */
 struct users_catalog {
-    GHashTable* users; /**< Hash table that maps user IDs to user objects. */
-    GHashTable* usersNumber; /**< Hash table that maps number of users for each year and month. */
+    STRING_MAP users; /**< Hash table that maps user IDs to user objects. */
+    STRING_MAP usersNumber; /**< Hash table that maps number of users for each year and month. */
+    PERFECT_HASH frozen; /**< Perfect hash of the user IDs after freeze_users_c, NULL until then. */
+    int indexed; /**< Whether the secondary indexes were already built. */
+    pthread_mutex_t lock; /**< Serializes the construction of the secondary indexes. */
 };
 
 USERS_C create_user_c(void){
     USERS_C new = malloc(sizeof(struct users_catalog));
 
-    new->users = g_hash_table_new_full(g_str_hash, g_str_equal, free, (GDestroyNotify)free_user);
-    new->usersNumber = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+    new->users = create_string_map(free, (GDestroyNotify)free_user);
+    new->usersNumber = create_string_map(free, NULL);
+    new->frozen = NULL;
+    new->indexed = 0;
+    pthread_mutex_init(&new->lock, NULL);
 
     return new;
 }
 
 void insert_user_c(USER user, USERS_C catalog, char* key){
-    g_hash_table_insert(catalog->users, key, user);
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    free_perfect_hash(catalog->frozen);
+    catalog->frozen = NULL;
+    string_map_insert(catalog->users, key, user);
 }
 
 void insert_userNumber_c(USERS_C catalog, char* key, char* day){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
     int dayN = ourAtoi(day);
-    if (g_hash_table_contains(catalog->usersNumber, key)){
-        int *days = g_hash_table_lookup(catalog->usersNumber, key);
+    if (string_map_contains(catalog->usersNumber, key)){
+        int *days = string_map_lookup(catalog->usersNumber, key);
         days[dayN - 1]++;
         free(key);
     } else{
         int* days = g_new(int, 31);
         memset(days, 0, sizeof(int) * 31);
         days[dayN - 1]++;
-        g_hash_table_insert(catalog->usersNumber, key, days);
+        string_map_insert(catalog->usersNumber, key, days);
+    }
+}
+
+/**
+ * @brief Builds the secondary indexes of the user catalog the first time they are needed.
+ *
+ * Safe to call from concurrent queries, the indexes are only built once.
+ *
+ * @param catalog The user catalog.
+ */
+static void build_user_indexes(USERS_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    if (__atomic_load_n(&catalog->indexed, __ATOMIC_ACQUIRE)) return;
+
+    pthread_mutex_lock(&catalog->lock);
+    if (!catalog->indexed){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        STRING_MAP_ITER iter;
+        gpointer key, value;
+        string_map_iter_init(&iter, catalog->users);
+        while (string_map_iter_next(&iter, &key, &value)) {
+            index_user((USER)value, catalog);
+        }
+
+        log_index_build("usersNumber", elapsed_since(start));
+        __atomic_store_n(&catalog->indexed, 1, __ATOMIC_RELEASE);
     }
+    pthread_mutex_unlock(&catalog->lock);
 }
 
 int* get_userNumber_c(USERS_C catalog, char* key){
-    return g_hash_table_lookup(catalog->usersNumber, key);
+    build_user_indexes(catalog);
+    return string_map_lookup(catalog->usersNumber, key);
 }
 
 USER get_user_by_id(USERS_C catalog, char* id){
-    return g_hash_table_lookup(catalog->users,id);
+    if (catalog->frozen != NULL) return lookup_perfect_hash(catalog->frozen, id);
+    return string_map_lookup(catalog->users,id);
+}
+
+void freeze_users_c(USERS_C catalog){
+    ALLOC_TAG_SCOPE(ALLOC_CATALOGS);
+    free_perfect_hash(catalog->frozen);
+    catalog->frozen = create_perfect_hash(catalog->users);
 }
 
 void update_user_c(USERS_C catalog, char* id, double cost){
@@ -73,22 +125,68 @@ void update_user_c(USERS_C catalog, char* id, double cost){
     set_user_total_spent(user, total + cost);
 }
 
+void save_users_c(USERS_C catalog, FILE* file){
+    write_snapshot_int(file, string_map_size(catalog->users));
+
+    STRING_MAP_ITER iter;
+    gpointer key, value;
+    string_map_iter_init(&iter, catalog->users);
+    while (string_map_iter_next(&iter, &key, &value)) {
+        save_user((USER)value, file);
+    }
+}
+
+int load_users_c(USERS_C catalog, SNAPSHOT snapshot){
+    int n = read_snapshot_int(snapshot);
+    for (int i = 0; i < n; i++){
+        if (!load_user(snapshot, catalog)) return -1;
+    }
+
+    return 0;
+}
+
+void report_users_c_memory(USERS_C catalog, MEMORY_REPORT report){
+    build_user_indexes(catalog);
+
+    begin_memory_catalog(report, "users", string_map_size(catalog->users));
+    add_memory(report, MEMORY_BUCKETS, string_map_memory(catalog->users) + string_map_memory(catalog->usersNumber));
+    if (catalog->frozen != NULL) add_memory(report, MEMORY_BUCKETS, perfect_hash_memory(catalog->frozen));
+
+    size_t structs = 0, strings = 0;
+    STRING_MAP_ITER iter;
+    gpointer key, value;
+    string_map_iter_init(&iter, catalog->users);
+    while (string_map_iter_next(&iter, &key, &value)){
+        strings += string_memory(key);
+        structs += get_user_memory((USER)value, &strings);
+    }
+
+    string_map_iter_init(&iter, catalog->usersNumber);
+    while (string_map_iter_next(&iter, &key, &value)) strings += string_memory(key);
+
+    add_memory(report, MEMORY_STRUCTS, structs);
+    add_memory(report, MEMORY_STRINGS, strings);
+    add_memory(report, MEMORY_DAY_COUNTS, string_map_size(catalog->usersNumber) * 31 * sizeof(int));
+}
+
 void free_user_c(USERS_C catalog){
-    g_hash_table_destroy(catalog->users);
+    free_perfect_hash(catalog->frozen);
+    free_string_map(catalog->users);
 
     // Free user hash table
-    GHashTableIter iter2;
+    STRING_MAP_ITER iter2;
     gpointer reserv_id, reservations;
-    g_hash_table_iter_init(&iter2, catalog->usersNumber);
-    while (g_hash_table_iter_next(&iter2, &reserv_id, &reservations)) {
+    string_map_iter_init(&iter2, catalog->usersNumber);
+    while (string_map_iter_next(&iter2, &reserv_id, &reservations)) {
         // Free the GPtrArray associated with each user
         int* reservations_array = reservations;
         g_free(reservations_array);
     }
-    g_hash_table_destroy(catalog->usersNumber);
+    free_string_map(catalog->usersNumber);
+    pthread_mutex_destroy(&catalog->lock);
     free(catalog);
 }
 
-GHashTable* get_hash_table_users(USERS_C catalog){
+STRING_MAP get_hash_table_users(USERS_C catalog){
     return catalog->users;
 }
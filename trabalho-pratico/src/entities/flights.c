@@ -20,6 +20,9 @@
 */
 
 #include "entities/flights.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
+#include "utils/memory_report.h"
 #include "catalogs/manager_c.h"
 
 #include <stdlib.h>
@@ -149,6 +152,18 @@ int get_flight_nPassengers(FLIGHT flight){
     return flight->nPassengers;
 }
 
+size_t get_flight_memory(FLIGHT flight, size_t* strings){
+    *strings += string_memory(flight->airline) +
+                string_memory(flight->plane_model) +
+                string_memory(flight->origin) +
+                string_memory(flight->destination) +
+                string_memory(flight->schedule_departure_date) +
+                string_memory(flight->schedule_arrival_date) +
+                string_memory(flight->real_departure_date) +
+                string_memory(flight->real_arrival_date);
+    return sizeof(*flight);
+}
+
 void free_flight(FLIGHT flight){
     free(flight->airline);
     free(flight->plane_model);
@@ -162,7 +177,10 @@ void free_flight(FLIGHT flight){
     free(flight);
 }
 
-int verify_flight(char** fields){
+int verify_flight(char** fields, void* catalog){
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
+    (void)catalog;
+
     if (!(fields[0]) || !(fields[1]) || !(fields[2]) ||
         !(fields[10]) || !(fields[11]) || !(fields[6]) || !(fields[7]) ||
         !(fields[8] || !(fields[9]))) return 0;
@@ -184,11 +202,11 @@ int verify_flight(char** fields){
 }
 
 int build_flight(char** flight_fields, void* catalog){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
 
     FLIGHTS_C flightsC = (FLIGHTS_C) catalog;
 
-    if (!verify_flight(flight_fields)) return 0;
-
     FLIGHT flight = create_flight();
 
     char* origin = case_insensitive(flight_fields[4]);
@@ -207,14 +225,48 @@ int build_flight(char** flight_fields, void* catalog){
 
     insert_flight_c(flight,flightsC,flight->id);
 
-    char year[6];
-    char month[3];
-    char day[3];
-    sscanf(flight_fields[6], "%4[^/]/%2[^/]/%2[^/]", year, month, day);
+    return 1;
+}
 
-    char* concatenated = concat(year, month);
+int get_flight_departure_day(FLIGHT flight){
+    return pack_date(flight->schedule_departure_date);
+}
+
+void save_flight(FLIGHT flight, FILE* file){
+    write_snapshot_string(file, flight->id);
+    write_snapshot_string(file, flight->airline);
+    write_snapshot_string(file, flight->plane_model);
+    write_snapshot_int(file, flight->total_seats);
+    write_snapshot_string(file, flight->origin);
+    write_snapshot_string(file, flight->destination);
+    write_snapshot_string(file, flight->schedule_departure_date);
+    write_snapshot_string(file, flight->schedule_arrival_date);
+    write_snapshot_string(file, flight->real_departure_date);
+    write_snapshot_string(file, flight->real_arrival_date);
+    write_snapshot_int(file, flight->nPassengers);
+}
+
+int load_flight(SNAPSHOT snapshot, void* catalog){
+    FLIGHT flight = create_flight();
 
-    insert_flightNumber_c(flightsC, concatenated, day);
+    flight->id = read_snapshot_strdup(snapshot);
+    flight->airline = read_snapshot_strdup(snapshot);
+    flight->plane_model = read_snapshot_strdup(snapshot);
+    flight->total_seats = read_snapshot_int(snapshot);
+    flight->origin = read_snapshot_strdup(snapshot);
+    flight->destination = read_snapshot_strdup(snapshot);
+    flight->schedule_departure_date = read_snapshot_strdup(snapshot);
+    flight->schedule_arrival_date = read_snapshot_strdup(snapshot);
+    flight->real_departure_date = read_snapshot_strdup(snapshot);
+    flight->real_arrival_date = read_snapshot_strdup(snapshot);
+    flight->nPassengers = read_snapshot_int(snapshot);
+
+    if (flight->id == NULL){
+        free_flight(flight);
+        return 0;
+    }
+
+    insert_flight_c(flight, (FLIGHTS_C)catalog, flight->id);
 
     return 1;
 }
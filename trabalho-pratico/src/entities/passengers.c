@@ -20,6 +20,8 @@
 */
 
 #include "entities/passengers.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
 
 #include "catalogs/manager_c.h"
 
@@ -28,7 +30,11 @@
 #include <stdio.h>
 #include <glib.h>
 
-int verify_passengers(char** passengers_fields, USERS_C users, FLIGHTS_C flights){
+int verify_passengers(char** passengers_fields, void* catalog){
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
+    USERS_C users = get_users_c((MANAGER)catalog);
+    FLIGHTS_C flights = get_flights_c((MANAGER)catalog);
+
     if (!(passengers_fields[0])) return 0;
     if (!(passengers_fields[1])) return 0;
     if (!(get_flight_by_id(flights, passengers_fields[0]))) return 0;
@@ -37,25 +43,21 @@ int verify_passengers(char** passengers_fields, USERS_C users, FLIGHTS_C flights
 }
 
 int build_passengers(char** passengers_fields, void* catalog){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
 
     MANAGER managerC = (MANAGER) catalog;
-    USERS_C usersC = get_users_c(managerC);
     FLIGHTS_C flightsC = get_flights_c(managerC);
     PASS_C passengersC = get_pass_c(managerC);
 
-    if (!verify_passengers(passengers_fields, usersC, flightsC)) return 0;
-
-    char* copy_flight = strdup(passengers_fields[0]);
-    char* copy_user = strdup(passengers_fields[1]);
-    char* copy_user1 = strdup(passengers_fields[1]);
-
-    FLIGHT flight = get_flight_by_id(flightsC, copy_flight);
+    char* flight_id = passengers_fields[0];
+    FLIGHT flight = get_flight_by_id(flightsC, flight_id);
 
     // Check if the number of passengers exceeds the total number of seats
     if (get_flight_nPassengers(flight) > get_flight_total_seats(flight)) {
         FILE* errorF = fopen("Resultados/flights_errors.csv", "a");
         if (errorF != NULL) {
-            char* id = copy_flight;
+            char* id = flight_id;
             char* airline = get_flight_airline(flight);
             char* plane_model = get_flight_plane_model(flight);
             int total_seats = get_flight_total_seats(flight);
@@ -72,25 +74,12 @@ int build_passengers(char** passengers_fields, void* catalog){
         }
 
         // Remove the flight from the hash table
-        remove_flight_from_hash_table(flightsC, copy_flight);
+        remove_flight_from_hash_table(flightsC, flight_id);
         return 0;
     }
 
-    insert_pass_user_c(copy_flight,passengersC, copy_user);
-    update_flight_c(flightsC,copy_flight);
-
-    char* flightD = get_flight_schedule_departure_date(flight);
-    char year[6];
-    char month[3];
-    char day[3];
-    sscanf(flightD, "%4[^/]/%2[^/]/%2[^/]", year, month, day);
-    free(flightD);
-
-    char* concatenated = concat(year, month);
-    char* key = concat(concatenated,day);
-    insert_passengers_c(passengersC, key, copy_user1);
-    free(concatenated);
-    //free(key);
+    insert_pass_user_c(flight_id, passengersC, passengers_fields[1]);
+    update_flight_c(flightsC, flight_id);
 
     return 1;
 }
@@ -20,6 +20,11 @@
 */
 
 #include "entities/reservations.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
+#include "utils/memory_report.h"
+#include "utils/radix_sort.h"
+#include "utils/id_map.h"
 
 #include "IO/input.h"
 #include "utils/utils.h"
@@ -157,6 +162,18 @@ int get_price_per_night(RESERV res){
     return (res->price_per_night);
 }
 
+size_t get_reservation_memory(RESERV res, size_t* strings){
+    *strings += string_memory(res->user_id) +
+                string_memory(res->hotel_id) +
+                string_memory(res->hotel_name) +
+                string_memory(res->hotel_stars) +
+                string_memory(res->begin_date) +
+                string_memory(res->end_date) +
+                string_memory(res->includes_breakfast) +
+                string_memory(res->rating);
+    return sizeof(*res);
+}
+
 void free_reservations(RESERV res){
     free(res->user_id);
     free(res->hotel_id);
@@ -170,7 +187,10 @@ void free_reservations(RESERV res){
     free(res);
 }
 
-int verify_reservations(char** fields, USERS_C users){
+int verify_reservations(char** fields, void* catalog){
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
+    USERS_C users = get_users_c((MANAGER)catalog);
+
     if (!(fields[0]) || !(fields[1]) || !(fields[2]) ||
         !(fields[3]) || !(fields[6]) || !(fields[7]) || !(fields[8])) return 0;
 
@@ -187,14 +207,25 @@ int verify_reservations(char** fields, USERS_C users){
     return 1;
 }
 
+/**
+ * @brief Converts a validated rating to an integer.
+ *
+ * @param rating The rating.
+ * @return The rating, or 0 when it is missing.
+ */
+static int rating_value(char* rating){
+    if (rating == NULL || rating[0] == '\0') return 0;
+    return ourAtoi(rating);
+}
+
 int build_reservations(char** reservations_fields, void* catalog){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
 
     MANAGER managerC = (MANAGER)catalog;
     USERS_C usersC = get_users_c(managerC);
     RESERV_C reservsC = get_reserv_c(managerC);
 
-    if (!verify_reservations(reservations_fields, usersC)) return 0;
-
     RESERV res = create_reservation();
     char* breakfast = first_letter_to_upper(reservations_fields[10]);
 
@@ -228,19 +259,133 @@ int build_reservations(char** reservations_fields, void* catalog){
     set_cost(res,cost);
 
     insert_reservations_c(res, reservsC, res->id);
-    insert_usersReservations_c(res->id, reservsC, res->user_id);
-    insert_hotelsReservations_c(res->id, reservsC, res->hotel_id);
+    insert_hotel_rating_c(reservsC, res->hotel_id, rating_value(res->rating));
 
     update_user_c(usersC,reservations_fields[1],cost);
 
+    return 1;
+}
+
+void index_reservation(RESERV res, uint32_t position, void* catalog, RESERV_INDEX index){
+    RESERV_C reservsC = (RESERV_C)catalog;
+
+    if (index == RESERV_BY_USER){
+        insert_usersReservations_c(position, reservsC, res->user_id);
+        return;
+    }
+    if (index == RESERV_BY_HOTEL){
+        insert_hotelsReservations_c(position, reservsC, res->hotel_id);
+        return;
+    }
+
     char year[6];
     char month[3];
     char day[3];
-    sscanf(reservations_fields[7], "%4[^/]/%2[^/]/%2[^/]", year, month, day);
+    sscanf(res->begin_date, "%4[^/]/%2[^/]/%2[^/]", year, month, day);
 
     char* concatenated = concat(year, month);
 
     insert_reservNumber_c(reservsC, concatenated, day);
+}
+
+/**
+ * @struct begin_key
+ * @brief A reservation and its packed begin date.
+ */
+struct begin_key {
+    long long begin; /**< Begin date as YYYYMMDD. */
+    RESERV res; /**< The reservation. */
+};
+
+/**
+ * @brief Compares two begin keys, most recent first and then by reservation ID.
+ */
+static int compare_begin_keys(const void* a, const void* b){
+    const struct begin_key* key_a = a;
+    const struct begin_key* key_b = b;
+
+    if (key_a->begin != key_b->begin) return key_a->begin < key_b->begin ? 1 : -1;
+    return strcmp(key_a->res->id, key_b->res->id);
+}
+
+/**
+ * @brief Sorts reservations by comparing their begin keys, for IDs that can't be packed.
+ */
+static void sort_by_comparison(RESERV* reservations, size_t n){
+    struct begin_key* keys = malloc(sizeof(struct begin_key) * (n + 1));
+    for (size_t i = 0; i < n; i++){
+        keys[i].begin = pack_date(reservations[i]->begin_date);
+        keys[i].res = reservations[i];
+    }
+
+    qsort(keys, n, sizeof(struct begin_key), compare_begin_keys);
+
+    for (size_t i = 0; i < n; i++) reservations[i] = keys[i].res;
+    free(keys);
+}
+
+void sort_reservations_by_begin(RESERV* reservations, size_t n){
+    RADIX_KEY* keys = malloc(sizeof(RADIX_KEY) * (n + 1));
+
+    for (size_t i = 0; i < n; i++){
+        // Canonical IDs sort like their number, any other ID needs the string comparison
+        if (!encode_id_key(reservations[i]->id, "Book", &keys[i].secondary)){
+            free(keys);
+            sort_by_comparison(reservations, n);
+            return;
+        }
+        keys[i].primary = UINT64_MAX - (uint64_t)pack_date(reservations[i]->begin_date);
+        keys[i].index = i;
+    }
+
+    radix_sort(keys, n);
+
+    RESERV* sorted = malloc(sizeof(RESERV) * (n + 1));
+    for (size_t i = 0; i < n; i++) sorted[i] = reservations[keys[i].index];
+    memcpy(reservations, sorted, sizeof(RESERV) * n);
+
+    free(sorted);
+    free(keys);
+}
+
+void save_reservation(RESERV res, FILE* file){
+    write_snapshot_string(file, res->id);
+    write_snapshot_string(file, res->user_id);
+    write_snapshot_string(file, res->hotel_id);
+    write_snapshot_string(file, res->hotel_name);
+    write_snapshot_string(file, res->hotel_stars);
+    write_snapshot_string(file, res->begin_date);
+    write_snapshot_string(file, res->end_date);
+    write_snapshot_string(file, res->includes_breakfast);
+    write_snapshot_string(file, res->rating);
+    write_snapshot_double(file, res->cost);
+    write_snapshot_int(file, res->price_per_night);
+}
+
+int load_reservation(SNAPSHOT snapshot, void* catalog){
+    RESERV_C reservsC = (RESERV_C)catalog;
+    RESERV res = create_reservation();
+
+    res->id = read_snapshot_strdup(snapshot);
+    res->user_id = read_snapshot_strdup(snapshot);
+    res->hotel_id = read_snapshot_strdup(snapshot);
+    res->hotel_name = read_snapshot_strdup(snapshot);
+    res->hotel_stars = read_snapshot_strdup(snapshot);
+    res->begin_date = read_snapshot_strdup(snapshot);
+    res->end_date = read_snapshot_strdup(snapshot);
+    res->includes_breakfast = read_snapshot_strdup(snapshot);
+    res->rating = read_snapshot_strdup(snapshot);
+    res->cost = read_snapshot_double(snapshot);
+    res->price_per_night = read_snapshot_int(snapshot);
+
+    if (res->id == NULL || res->user_id == NULL || res->hotel_id == NULL){
+        free(res->id);
+        free_reservations(res);
+        return 0;
+    }
+
+    insert_reservations_c(res, reservsC, res->id);
+    insert_hotel_rating_c(reservsC, res->hotel_id, rating_value(res->rating));
 
     return 1;
 }
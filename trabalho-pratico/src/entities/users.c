@@ -20,6 +20,9 @@
 */
 
 #include "entities/users.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
+#include "utils/memory_report.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +41,7 @@ struct user {
     char* country_code; /**< User's country code. */
     char* account_status; /**< User's account status. */
     double total_spent; /**< User's total spent on reservations. */
+    int account_creation; /**< Account creation date, packed as YYYYMMDD. */
 };
 
 USER create_user(void){
@@ -50,6 +54,7 @@ USER create_user(void){
     new->country_code = NULL;
     new->account_status = NULL;
     new->total_spent = 0.0;
+    new->account_creation = 0;
 
     return new;
 }
@@ -118,6 +123,15 @@ double get_user_total_spent(USER user){
     return (user->total_spent);
 }
 
+size_t get_user_memory(USER user, size_t* strings){
+    *strings += string_memory(user->name) +
+                string_memory(user->sex) +
+                string_memory(user->passport) +
+                string_memory(user->country_code) +
+                string_memory(user->account_status);
+    return sizeof(*user);
+}
+
 void free_user(USER user){
     free(user->name);
     free(user->sex);
@@ -128,7 +142,10 @@ void free_user(USER user){
     free(user);
 }
 
-int verify_user(char** fields){
+int verify_user(char** fields, void* catalog){
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
+    (void)catalog;
+
     if (!(fields[0]) || !(fields[1]) || !(fields[3]) ||
         !(fields[5]) || !(fields[6]) || !(fields[8]) ||
         !(fields[10])|| !(fields[4]) || !(fields[9])) return 0;
@@ -149,9 +166,10 @@ int verify_user(char** fields){
 }
 
 int build_user(char  **user_fields, void *catalog){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_ENTITIES);
 
     USERS_C usersC = (USERS_C)catalog;
-    if (!verify_user(user_fields)) return 0;
 
     USER user = create_user();
     int age = calculate_user_age(SYSTEM_DATE, user_fields[4]);
@@ -165,17 +183,53 @@ int build_user(char  **user_fields, void *catalog){
     set_user_country_code(user,user_fields[7]);
     set_user_account_status(user,acc_status);
     set_user_total_spent(user,0.0);
+    user->account_creation = pack_date(user_fields[9]);
 
     insert_user_c(user,usersC,user->id);
 
-    char year[6];
-    char month[3];
-    char day[3];
-    sscanf(user_fields[9], "%4[^/]/%2[^/]/%2[^/]", year, month, day);
+    return 1;
+}
+
+void index_user(USER user, void* catalog){
+    char key[16];
+    char day[16];
+    snprintf(key, sizeof(key), "%04d%02d", user->account_creation / 10000, (user->account_creation / 100) % 100);
+    snprintf(day, sizeof(day), "%02d", user->account_creation % 100);
 
-    char* concatenated = concat(year, month);
+    insert_userNumber_c((USERS_C)catalog, strdup(key), day);
+}
+
+void save_user(USER user, FILE* file){
+    write_snapshot_string(file, user->id);
+    write_snapshot_string(file, user->name);
+    write_snapshot_int(file, user->age);
+    write_snapshot_string(file, user->sex);
+    write_snapshot_string(file, user->passport);
+    write_snapshot_string(file, user->country_code);
+    write_snapshot_string(file, user->account_status);
+    write_snapshot_double(file, user->total_spent);
+    write_snapshot_int(file, user->account_creation);
+}
+
+int load_user(SNAPSHOT snapshot, void* catalog){
+    USER user = create_user();
 
-    insert_userNumber_c(usersC, concatenated, day);
+    user->id = read_snapshot_strdup(snapshot);
+    user->name = read_snapshot_strdup(snapshot);
+    user->age = read_snapshot_int(snapshot);
+    user->sex = read_snapshot_strdup(snapshot);
+    user->passport = read_snapshot_strdup(snapshot);
+    user->country_code = read_snapshot_strdup(snapshot);
+    user->account_status = read_snapshot_strdup(snapshot);
+    user->total_spent = read_snapshot_double(snapshot);
+    user->account_creation = read_snapshot_int(snapshot);
+
+    if (user->id == NULL){
+        free_user(user);
+        return 0;
+    }
+
+    insert_user_c(user, (USERS_C)catalog, user->id);
 
     return 1;
 }
@@ -26,6 +26,38 @@
 #include <ncurses.h>
 #include <string.h>
 
+/**
+ * @brief Prints a row of a query result, if it exists.
+ *
+ * @param win The window where the row is printed.
+ * @param y The line of the window.
+ * @param results The query result.
+ * @param row The row index.
+ */
+static void print_result_row(WINDOW* win, int y, RESULT results, int row){
+    if (row < 0 || row >= get_result_rows(results)) return;
+
+    char* formatted_string = format_result_row(results, row);
+    mvwprintw(win, y, 1, "%s", formatted_string);
+    free(formatted_string);
+}
+
+/**
+ * @brief Prints a single field of the first row of a query result.
+ *
+ * @param win The window where the field is printed.
+ * @param y The line of the window.
+ * @param results The query result.
+ * @param field The field index.
+ */
+static void print_result_field(WINDOW* win, int y, RESULT results, int field){
+    int total_size = format_result_field(results, 0, field, NULL, 0) + 1;
+    char* formatted_string = malloc(total_size);
+    format_result_field(results, 0, field, formatted_string, total_size);
+    mvwprintw(win, y, 1, "%s", formatted_string);
+    free(formatted_string);
+}
+
 void query_results(SETTINGS settings, int id, void* output, char** args){
 
     int optionFormat = get_output_S(settings);
@@ -95,7 +127,7 @@ void txtFormat(SETTINGS settings, int id, void* output, char** args){
 
     if (output != NULL){
         output_query(output_file, output, id);
-        free_query(output,id);
+        free_result(output);
     }
     fclose(output_file);
 
@@ -199,10 +231,10 @@ void oneByOne(SETTINGS settings, int id, void* output, char** args){
     set_nQueries_S(settings, q+1);
 
     int currentPage = 1;
-    char** results = (char**)output;
+    RESULT results = (RESULT)output;
     int nArgs = 0;
     if (output != NULL && (id != 3 && id != 8)){
-        nArgs = ourAtoi(results[0]);
+        nArgs = get_result_rows(results);
     }
 
     int resultsPerPage = 12;
@@ -246,25 +278,15 @@ void oneByOne(SETTINGS settings, int id, void* output, char** args){
             mvwprintw(win, 5, 1, "--  ---   ---   ---   ---   ---  --- Page %d ---   ---   ---   ---   ---  ---", currentPage);
             if (id == 1){
                 if (currentPage == 1){
-                    for (int i = 0; i < 8; i++) {
-                        if (results[i] == NULL) {
-                            results[i] = "False";
-                        } else if (strcmp(results[i], "T") == 0) {
-                            results[i] = "True";
-                        }
-                        mvwprintw(win, 6+i, 1, "%s", results[i]);
+                    for (int i = 0; i < get_result_fields(results); i++) {
+                        print_result_field(win, 6+i, results, i);
                     }
                 }
                 mvwprintw(win, 19, 1, "All outputs are displayed :)  ");
             }
             else if (id == 3 || id == 8){
-                char* result = (char*)output;
                 if (currentPage == 1){
-                    int total_size = snprintf(NULL, 0, "%s", result) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", result);
-                    mvwprintw(win, 6, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6, results, 0);
                 }
                 mvwprintw(win, 19, 1, "All outputs are displayed :)  ");
             }
@@ -284,11 +306,7 @@ void oneByOne(SETTINGS settings, int id, void* output, char** args){
 
                 for (int j = startIdx; j < endIdx ; j++) {
                     // Display only results belonging to the current page
-                    int total_size = snprintf(NULL, 0, "%s", results[j]) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", results[j]);
-                    mvwprintw(win, 6 + (j-2) % resultsPerPage, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6 + (j-2) % resultsPerPage, results, j - 2);
                 }
             }
             else {
@@ -308,11 +326,7 @@ void oneByOne(SETTINGS settings, int id, void* output, char** args){
 
                 for (int j = startIdx; j < endIdx ; j++) {
                     // Display only results belonging to the current page
-                    int total_size = snprintf(NULL, 0, "%s", results[j]) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", results[j]);
-                    mvwprintw(win, 6 + (j-1) % resultsPerPage, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6 + (j-1) % resultsPerPage, results, j - 1);
                 }
             }
             if ((id != 1 && id != 3 && id != 8) && verify == 1)
@@ -437,12 +451,12 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
     set_nQueries_S(settings, n+1);
 
     int currentPage = 1; // Variable to control the current page
-    char** results = (char**)output;
+    RESULT results = (RESULT)output;
     int nPages = get_nPages_S(settings);
     int nArgs = 0;
     int resultsPerPage = 0;
     if (output != NULL && (id != 3 && id != 8)){
-        nArgs = ourAtoi(results[0]);
+        nArgs = get_result_rows(results);
         resultsPerPage = (nArgs / nPages) + ((nArgs % nPages) > 0); // Number of results per page
     }
 
@@ -489,13 +503,8 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
 
             if (id == 1){
                 if (currentPage == 1){
-                    for (int i = 0; i < 8; i++) {
-                        if (results[i] == NULL) {
-                            results[i] = "False";
-                        } else if (strcmp(results[i], "T") == 0) {
-                            results[i] = "True";
-                        }
-                        mvwprintw(win, 6+i, 1, "%s", results[i]);
+                    for (int i = 0; i < get_result_fields(results); i++) {
+                        print_result_field(win, 6+i, results, i);
                     }
                 }
             }
@@ -527,11 +536,7 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
                 if (resultsPerPage <= 12){
                     for (int j = startIdx; j <= endIdx; j++) {
                         // Display only results belonging to the current page
-                        int total_size = snprintf(NULL, 0, "%s", results[j - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j - 1]);
-                        mvwprintw(win, 6 + (j - 1) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - 1) % resultsPerPage, results, j - 1 - 2);
                     }
                 }
                 else {
@@ -539,23 +544,14 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
                     mvwprintw(win, 19, 55, "press 'd' to go down");
                     for (int j = scrollStart; j <= scrollEnd && scrollEnd < endIdx && (j + startIdx - 1)< nArgs; j++) {
                         // Display only results belonging to the current page
-                        int total_size = snprintf(NULL, 0, "%s", results[j + startIdx - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j + startIdx - 1]);
-                        mvwprintw(win, 6 + (j - scrollStart) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - scrollStart) % resultsPerPage, results, j + startIdx - 1 - 2);
                     }
                 }
 
             }
             else if (id == 3 || id == 8){
-                char* result = (char*)output;
                 if (currentPage == 1){
-                    int total_size = snprintf(NULL, 0, "%s", result) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", result);
-                    mvwprintw(win, 6, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6, results, 0);
                 }
             }
             else{
@@ -583,22 +579,14 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
 
             if (resultsPerPage <= 12){
                     for (int j = startIdx; j <= endIdx; j++) {
-                        int total_size = snprintf(NULL, 0, "%s", results[j - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j - 1]);
-                        mvwprintw(win, 6 + (j - 1) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - 1) % resultsPerPage, results, j - 1 - 1);
                     }
                 }
             else {
                 mvwprintw(win, 19, 1, "press 'u' to go up");
                 mvwprintw(win, 19, 55, "press 'd' to go down");
                 for (int j = scrollStart; j <= scrollEnd && scrollEnd < endIdx && (j + startIdx -1)< nArgs; j++) {
-                    int total_size = snprintf(NULL, 0, "%s", results[j + startIdx - 1]) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", results[j + startIdx - 1]);
-                    mvwprintw(win, 6 + (j - scrollStart) % resultsPerPage, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6 + (j - scrollStart) % resultsPerPage, results, j + startIdx - 1 - 1);
                 }
             }
             }
@@ -648,7 +636,7 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -660,7 +648,7 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -672,7 +660,7 @@ void numberPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -719,12 +707,12 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
     set_nQueries_S(settings, n+1);
 
     int currentPage = 1; // Variable to control the current page
-    char** results = (char**)output;
+    RESULT results = (RESULT)output;
     int nPages = 0;
     int nArgs = 0;
     int resultsPerPage = get_nOutputs_S(settings);
     if (output != NULL && (id != 3 && id != 8)){
-        nArgs = ourAtoi(results[0]);
+        nArgs = get_result_rows(results);
         nPages = (nArgs / resultsPerPage) + ((nArgs % resultsPerPage) > 0); // Number of results per page
     }
 
@@ -771,13 +759,8 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
 
             if (id == 1){
                 if (currentPage == 1){
-                    for (int i = 0; i < 8; i++) {
-                        if (results[i] == NULL) {
-                            results[i] = "False";
-                        } else if (strcmp(results[i], "T") == 0) {
-                            results[i] = "True";
-                        }
-                        mvwprintw(win, 6+i, 1, "%s", results[i]);
+                    for (int i = 0; i < get_result_fields(results); i++) {
+                        print_result_field(win, 6+i, results, i);
                     }
                 }
             }
@@ -809,11 +792,7 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
                 if (resultsPerPage <= 12){
                     for (int j = startIdx; j <= endIdx; j++) {
                         // Display only results belonging to the current page
-                        int total_size = snprintf(NULL, 0, "%s", results[j - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j - 1]);
-                        mvwprintw(win, 6 + (j - 1) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - 1) % resultsPerPage, results, j - 1 - 2);
                     }
                 }
                 else {
@@ -821,23 +800,14 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
                     mvwprintw(win, 19, 55, "press 'd' to go down");
                     for (int j = scrollStart; j <= scrollEnd && scrollEnd < endIdx && (j + startIdx - 1)< nArgs; j++) {
                         // Display only results belonging to the current page
-                        int total_size = snprintf(NULL, 0, "%s", results[j + startIdx - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j + startIdx - 1]);
-                        mvwprintw(win, 6 + (j - scrollStart) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - scrollStart) % resultsPerPage, results, j + startIdx - 1 - 2);
                     }
                 }
 
             }
             else if (id == 3 || id == 8){
-                char* result = (char*)output;
                 if (currentPage == 1){
-                    int total_size = snprintf(NULL, 0, "%s", result) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", result);
-                    mvwprintw(win, 6, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6, results, 0);
                 }
             }
             else{
@@ -865,22 +835,14 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
 
             if (resultsPerPage <= 12){
                     for (int j = startIdx; j <= endIdx; j++) {
-                        int total_size = snprintf(NULL, 0, "%s", results[j - 1]) + 1;
-                        char* formatted_string = malloc(total_size);
-                        snprintf(formatted_string, total_size, "%s", results[j - 1]);
-                        mvwprintw(win, 6 + (j - 1) % resultsPerPage, 1, "%s", formatted_string);
-                        free(formatted_string);
+                        print_result_row(win, 6 + (j - 1) % resultsPerPage, results, j - 1 - 1);
                     }
                 }
             else {
                 mvwprintw(win, 19, 1, "press 'u' to go up");
                 mvwprintw(win, 19, 55, "press 'd' to go down");
                 for (int j = scrollStart; j <= scrollEnd && scrollEnd < endIdx && (j + startIdx -1)< nArgs; j++) {
-                    int total_size = snprintf(NULL, 0, "%s", results[j + startIdx - 1]) + 1;
-                    char* formatted_string = malloc(total_size);
-                    snprintf(formatted_string, total_size, "%s", results[j + startIdx - 1]);
-                    mvwprintw(win, 6 + (j - scrollStart) % resultsPerPage, 1, "%s", formatted_string);
-                    free(formatted_string);
+                    print_result_row(win, 6 + (j - scrollStart) % resultsPerPage, results, j + startIdx - 1 - 1);
                 }
             }
             }
@@ -930,7 +892,7 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -942,7 +904,7 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -954,7 +916,7 @@ void outputsPage(SETTINGS settings, int id, void* output, char** args){
                     free(args);
                     free(option);
                     for (int i = 0; i < 5; i++) free_button(options[i]);
-                    free_query(output,id);
+                    free_result(output);
                     werase(win);
                     wrefresh(win);
                     endwin();
@@ -29,8 +29,16 @@
 #include "menuNdata/batch.h"
 #include "menuNdata/interactive.h"
 #include "menuNdata/interactive.h"
+#include "menuNdata/server.h"
 #include "test/test.h"
+#include "test/bench.h"
+#include "test/generator.h"
+#include "test/scaling.h"
+#include "test/replay.h"
+#include "test/map_bench.h"
 #include "utils/utils.h"
+#include "utils/trace.h"
+#include "utils/memory_report.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -42,6 +50,20 @@
  * @brief Function main that receives the arguments from the command line
  *
  * Depending on number of arguments starts wither batch mode(2 arguments) or interactive mode (no arguments)
+ * Batch mode accepts a third argument, --packed, to write every output to a single archive, and
+ * "--unpack <archive> [command]" splits an archive back into the commandN_output.txt files.
+ * "--memory-report <dataset>" loads the dataset and reports the memory used by each catalog.
+ * "--serve <dataset> [socket]" loads the dataset once and answers queries sent by programa-cliente,
+ * which takes the socket followed by the query lines (read from stdin when there are none).
+ * programa-bench takes the dataset and, optionally, the number of measured and warmup runs of
+ * each query scenario, or "--scaling <folder> [max scale] [max threads]" to measure the load and a
+ * command mix over generated datasets of increasing size, or "--replay <dataset> <commands> [limit] [mix]"
+ * to replay a command file for a duration ("30s") or a number of commands, or "--maps [keys]" to compare
+ * the string map of the catalogs with a GHashTable, and programa-gerador writes a synthetic dataset to a folder, taking the
+ * scale factor, the seed and the percentage of invalid rows.
+ * programa-testes compares the outputs with the expected ones and the query times with a latency
+ * baseline, given as an optional fourth argument, and exits with 1 when either check fails.
+ * When built with TRACE=1, the batch, test and server modes write a Chrome trace to TRACE_PATH.
  *
  * @param argc Number of arguments
  * @param argsv Array containing the arguments
@@ -53,16 +75,91 @@ int main(int argc, char** argsv){
     double elapsed;
     clock_gettime(CLOCK_REALTIME, &start);
 
-    if(argc == 3 && strcmp("./programa-principal",argsv[0]) == 0) {
-        batch(argsv[1], argsv[2]);
+    // Benchmarks and tests always load the CSV files and never touch the snapshot of the dataset
+    if (strcmp("./programa-bench",argsv[0]) == 0 || strcmp("./programa-testes",argsv[0]) == 0) {
+        set_snapshot_enabled(0);
+    }
+
+    if((argc == 3 || argc == 4) && strcmp("./programa-principal",argsv[0]) == 0 && strcmp("--serve",argsv[1]) == 0) {
+        return server(argsv[2], argc == 4 ? argsv[3] : SERVER_SOCKET_PATH) == -1;
+    }
+    else if(argc == 3 && strcmp("./programa-principal",argsv[0]) == 0 && strcmp("--memory-report",argsv[1]) == 0) {
+        return memory_report(argsv[2]) == -1;
+    }
+    else if(argc >= 2 && strcmp("./programa-cliente",argsv[0]) == 0) {
+        return client(argsv[1], argc > 2 ? argsv + 2 : NULL, argc - 2);
+    }
+    else if((argc == 3 || argc == 4) && strcmp("./programa-principal",argsv[0]) == 0 && strcmp("--unpack",argsv[1]) == 0) {
+        int n = unpack_outputs(argsv[2], argc == 4 ? atoi(argsv[3]) : 0);
+        if (n == -1) printf("Invalid output archive\n");
+        return 0;
+    }
+    else if(argc == 3 && strcmp("./programa-principal",argsv[0]) == 0) {
+        batch(argsv[1], argsv[2], OUTPUT_FILES);
+    }
+    else if(argc == 4 && strcmp("./programa-principal",argsv[0]) == 0 && strcmp("--packed",argsv[3]) == 0) {
+        batch(argsv[1], argsv[2], OUTPUT_PACKED);
     }
     else if(argc == 1 && strcmp("./programa-principal",argsv[0]) == 0) {
         interactive();
     }
-    else if (argc == 4 && strcmp("./programa-testes",argsv[0]) == 0){
-        test(argsv[1], argsv[2], argsv[3]);
+    else if (argc >= 4 && argc <= 6 && strcmp("./programa-bench",argsv[0]) == 0 && strcmp("--replay",argsv[1]) == 0){
+        // The limit is a duration when it ends in 's' and a number of commands otherwise
+        char* end = NULL;
+        double limit = argc > 4 ? strtod(argsv[4], &end) : REPLAY_DURATION;
+        int duration = argc <= 4 || *end == 's';
+        int mix = argc > 5 && strcmp("mix", argsv[5]) == 0;
+        if (limit <= 0 || (argc > 5 && !mix)){
+            printf("Invalid replay limit or order\n");
+            return 1;
+        }
+        return replay(argsv[2], argsv[3], duration ? limit : 0, duration ? 0 : (long)limit, mix) == -1;
+    }
+    else if (argc >= 3 && argc <= 5 && strcmp("./programa-bench",argsv[0]) == 0 && strcmp("--scaling",argsv[1]) == 0){
+        double max_scale = argc > 3 ? atof(argsv[3]) : SCALING_MAX_SCALE;
+        int max_threads = argc > 4 ? atoi(argsv[4]) : SCALING_MAX_THREADS;
+        if (max_scale < SCALING_MIN_SCALE || max_threads < 1){
+            printf("Invalid scale or number of threads\n");
+            return 1;
+        }
+        return scaling_bench(argsv[2], max_scale, max_threads) == -1;
+    }
+    else if ((argc == 2 || argc == 3) && strcmp("./programa-bench",argsv[0]) == 0 && strcmp("--maps",argsv[1]) == 0){
+        long keys = argc > 2 ? atol(argsv[2]) : MAP_BENCH_KEYS;
+        if (keys < 1){
+            printf("Invalid number of keys\n");
+            return 1;
+        }
+        return map_bench(keys) == -1;
+    }
+    else if (argc >= 2 && argc <= 4 && strcmp("./programa-bench",argsv[0]) == 0){
+        int iterations = argc > 2 ? atoi(argsv[2]) : BENCH_ITERATIONS;
+        int warmup = argc > 3 ? atoi(argsv[3]) : BENCH_WARMUP;
+        if (iterations < 1 || warmup < 0){
+            printf("Invalid number of iterations\n");
+            return 1;
+        }
+        return bench(argsv[1], iterations, warmup) == -1;
+    }
+    else if (argc >= 2 && argc <= 5 && strcmp("./programa-gerador",argsv[0]) == 0){
+        double scale = argc > 2 ? atof(argsv[2]) : 1;
+        uint64_t seed = argc > 3 ? strtoull(argsv[3], NULL, 10) : GENERATOR_SEED;
+        double invalid = argc > 4 ? atof(argsv[4]) : GENERATOR_INVALID;
+        if (scale <= 0 || invalid < 0 || invalid > 100){
+            printf("Invalid scale or percentage of invalid rows\n");
+            return 1;
+        }
+        if (generate_dataset(argsv[1], scale, seed, invalid) == -1){
+            printf("Could not create the dataset files\n");
+            return 1;
+        }
         return 0;
     }
+    else if ((argc == 4 || argc == 5) && strcmp("./programa-testes",argsv[0]) == 0){
+        int failed = test(argsv[1], argsv[2], argsv[3], argc == 5 ? argsv[4] : LATENCY_BASELINE_PATH) == -1;
+        TRACE_DUMP(TRACE_PATH);
+        return failed;
+    }
     else {
         printf("Invalid number of arguments, must be either 1, 3 or 4\n");
         return 0;
@@ -81,6 +178,8 @@ int main(int argc, char** argsv){
 
     replace_lines_at_start("Resultados/analysis.txt", time, memory);
 
+    TRACE_DUMP(TRACE_PATH);
+
     return 0;
 }
 
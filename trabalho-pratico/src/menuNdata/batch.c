@@ -26,7 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-void batch (char* path1, char* path2){
+void batch (char* path1, char* path2, OUTPUT_MODE mode){
 
     USERS_C users_catalog = create_user_c();
     FLIGHTS_C flights_catalog = create_flight_c();
@@ -38,7 +38,7 @@ void batch (char* path1, char* path2){
         return;
     }
 
-    if (execute_queries(manager_catalog,path2,0) == -1){
+    if (execute_queries(manager_catalog,path2,0,mode) == -1){
         return;
     }
 
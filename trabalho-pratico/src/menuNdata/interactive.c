@@ -21,6 +21,7 @@
  */
 
 #include "menuNdata/interactive.h"
+#include "utils/alloc_stats.h"
 #include <string.h>
 
 /**
@@ -125,6 +126,7 @@ void free_settings(SETTINGS setts){
 }
 
 void interactive(void){
+    ALLOC_TAG_SCOPE(ALLOC_INTERACTIVE);
 
     SETTINGS settings = create_settings();
 
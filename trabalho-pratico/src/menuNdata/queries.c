@@ -20,113 +20,114 @@
  */
 
 #include "menuNdata/queries.h"
+#include "utils/trace.h"
+#include "utils/alloc_stats.h"
+#include "utils/selection.h"
+#include "utils/radix_sort.h"
+#include "utils/id_map.h"
 
 #include <glib.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <locale.h>
+#include <pthread.h>
 
-void* query1(MANAGER manager,char** args){
+RESULT query1(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* entity = args[0];
-    char** result = malloc(sizeof(char*) * 9);
-    int i = 0;
-
-    // Check if the entity ID is a digit, indicating it might be a flight ID
-    while (isDigit(entity[i]) && entity[i] != '\0') i++;
-
-    // If the ID is composed of digits and corresponds to a flight
-    if ((i == (int)strlen(entity)) && get_flight_by_id(get_flights_c(manager), entity)) {
-        FLIGHT flight = get_flight_by_id(get_flights_c(manager), entity);
+    RESULT result;
+    ENTITY_TYPE type;
+    void* handle;
+    int i;
+
+    // A single lookup resolves the ID to its entity and the precomputed numeric fields
+    const ENTITY_PROFILE* profile = get_entity_c(manager, entity, &type, &handle);
+
+    // If the entity is not recognized there is nothing to output
+    if (profile == NULL) return NULL;
+
+    if (type == ENTITY_FLIGHT) {
+        FLIGHT flight = handle;
+        static const char* names[] = {
+            "airline", "plane_model", "origin", "destination", "schedule_departure_date",
+            "schedule_arrival_date", "passengers", "delay"
+        };
         static flight_table_getters flight_functions[] = {
             get_flight_airline, get_flight_plane_model, get_flight_origin,
-            get_flight_destination, get_flight_schedule_departure_date,
-            get_flight_schedule_arrival_date
+            get_flight_destination
         };
 
+        result = create_result(8, names);
+        add_result_row(result);
+
         // Retrieve flight information using getter functions
-        for (i = 0; i < 6; i++) {
-            result[i] = flight_functions[i](flight);
+        for (i = 0; i < 4; i++) {
+            set_result_string(result, 0, i, flight_functions[i](flight));
         }
 
-        // Get the number of flights in the array based on the flight ID
-        int flight_array_number = get_flight_nPassengers(flight);
-        result[6] = int_to_string(flight_array_number);
-
-        // Get the delay of the flight
-        int flight_delay = get_flight_delay(flight);
-        result[7] = int_to_string(flight_delay);
-
-        result[8] = "flight";
+        set_result_datetime(result, 0, 4, profile->begin);
+        set_result_datetime(result, 0, 5, profile->end);
+        set_result_int(result, 0, 6, profile->flights);
+        set_result_int(result, 0, 7, profile->delay);
     }
 
-    // If the ID starts with "Book" and corresponds to a reservation
-    else if (strncmp(entity, "Book", 4) == 0 && get_reservations_by_id(get_reserv_c(manager), entity)) {
-        RESERV reserv = get_reservations_by_id(get_reserv_c(manager), entity);
+    else if (type == ENTITY_RESERVATION) {
+        RESERV reserv = handle;
+        static const char* names[] = {
+            "hotel_id", "hotel_name", "hotel_stars", "begin_date", "end_date",
+            "includes_breakfast", "nights", "total_price"
+        };
         static reservation_table_getters reservation_functions[] = {
-            get_hotel_id, get_hotel_name, get_hotel_stars, get_begin_date, get_end_date,
-            get_includes_breakfast
+            get_hotel_id, get_hotel_name, get_hotel_stars
         };
 
+        result = create_result(8, names);
+        add_result_row(result);
+
         // Retrieve reservation information using getter functions
-        for(i = 0; i < 6; i++){
-            result[i] = reservation_functions[i](reserv);
+        for(i = 0; i < 3; i++){
+            set_result_string(result, 0, i, reservation_functions[i](reserv));
         }
 
-        // Get the number of nights in the reservation
-        int nNight = get_number_of_nights(reserv);
-        result[6] = int_to_string(nNight);
+        set_result_date(result, 0, 3, profile->begin);
+        set_result_date(result, 0, 4, profile->end);
 
-        // Get the cost of the reservation
-        double cost = get_cost(reserv);
-        result[7] = double_to_string(cost);
+        // A missing value is written as False and a "t" normalized to "T" as True
+        char* breakfast = get_includes_breakfast(reserv);
+        if (breakfast != NULL && strcmp(breakfast, "T") == 0){
+            set_result_ref(result, 0, 5, "True");
+            free(breakfast);
+        }
+        else if (breakfast != NULL) set_result_string(result, 0, 5, breakfast);
 
-        result[8] = "reservation";
+        set_result_int(result, 0, 6, profile->nights);
+        set_result_double(result, 0, 7, profile->total);
     }
 
-    // If the entity is a user
-    else if (get_user_by_id(get_users_c(manager), entity)) {
-        USER user = get_user_by_id(get_users_c(manager), entity);
-        char* status = get_user_account_status(user);
+    else {
+        USER user = handle;
 
-        // Check if the user is inactive, if so, return NULL
-        if (strcmp(status, "INACTIVE") == 0) {
-            free(result);
-            free(status);
-            return NULL;
-        }
+        // Inactive users have nothing to output
+        if (!profile->active) return NULL;
 
-        static user_table_getters user_functions[] = {
-            get_user_name, get_user_sex, get_user_sex,
-            get_user_country_code, get_user_passport
+        static const char* names[] = {
+            "name", "sex", "age", "country_code", "passport",
+            "number_of_flights", "number_of_reservations", "total_spent"
         };
 
-        // Retrieve user information using getter functions
-        for(i = 0; i < 5; i++){
-            if(i != 2){
-            result[i] = user_functions[i](user);
-            }
-            else result[i] = int_to_string(get_user_age(user));
-        }
+        result = create_result(8, names);
+        add_result_row(result);
 
-        // Get the number of flights associated with the user
-        int array_flight = get_user_array_number_id(get_pass_c(manager), entity);
-        result[5] = int_to_string(array_flight);
-
-        // Get the number of reservations associated with the user
-        int array_reserv = get_user_array_reserv_id(get_reserv_c(manager), entity);
-        result[6] = int_to_string(array_reserv);
-
-        // Get the total amount spent by the user
-        double total_spent = get_user_total_spent(user);
-        result[7] = double_to_string(total_spent);
-
-        result[8] = "user";
-        free(status);
-    } else {
-        // If the entity is not recognized, free the result array and return NULL
-        free(result);
-        return NULL;
+        set_result_string(result, 0, 0, get_user_name(user));
+        set_result_string(result, 0, 1, get_user_sex(user));
+        set_result_int(result, 0, 2, profile->age);
+        set_result_string(result, 0, 3, get_user_country_code(user));
+        set_result_string(result, 0, 4, get_user_passport(user));
+        set_result_int(result, 0, 5, profile->flights);
+        set_result_int(result, 0, 6, profile->reservations);
+        set_result_double(result, 0, 7, profile->total);
     }
 
     return result;
@@ -144,62 +145,16 @@ void* query1(MANAGER manager,char** args){
  */
 typedef struct {
     char* id;      /**< Identifier associated with the result entry. */
-    char* date;    /**< Date associated with the result entry. */
+    long long when; /**< Date associated with the result entry, packed as YYYYMMDDhhmmss. */
+    const char* type; /**< Type of the entity (only used by query 2). */
 } ResultEntry;
 
-/**
- * @brief Compares two date strings in the format "yyyy/mm/dd hh:mm:ss".
- *
- * This function compares two date strings, first by years, then months, days, hours,
- * minutes, and seconds. The returning integer is positive if itemB is later than itemA,
- * negative if itemB is earlier than itemA, and zero if they are equal.
- *
- * @param itemA The first date string.
- * @param itemB The second date string.
- * @return The result of the comparison.
- */
-int compare_datesF(char* itemA, char* itemB) {
-    // Comparar anos
-    int yearA, monthA, dayA, hourA, minA,segA;
-    sscanf(itemA, "%d/%d/%d %d:%d:%d", &yearA, &monthA, &dayA, &hourA, &minA, &segA);
-
-    int yearB, monthB, dayB, hourB, minB, segB;
-    sscanf(itemB, "%d/%d/%d %d:%d:%d", &yearB, &monthB, &dayB, &hourB, &minB, &segB);
-
-    if (yearA != yearB){
-        return yearB - yearA;  // Sort by year in descending order
-    }
-
-    // Compare months
-    if (monthA != monthB){
-        return monthB - monthA;  // sort by month in descending order
-    }
-
-    // Compare days
-    if (dayB != dayA){
-        return dayB - dayA;  // Sort days by descending order
-    }
-
-    //Compare hours
-    if (hourB != hourA){
-        return hourB - hourA; //Sort hours in descending order
-    }
-
-    //Compare minutes
-    if (minB != minA){
-        return minB - minA; //Sort minutes in descending order
-    }
-
-    return segB - segA; //Sort seconds in descending order
-}
-
 /**
  * @brief Compares two ResultEntry structures based on date and ID.
  *
  * This function is designed to be used with the qsort function to sort an array
- * of ResultEntry structures. It first compares dates using the compare_datesF
- * function and then, in case of a tie, compares IDs using strcmp. The result is
- * suitable for sorting entries in chronological order and alphabetical order by ID.
+ * of ResultEntry structures. It first compares the packed dates, most recent first,
+ * and then, in case of a tie, compares IDs using strcmp.
  *
  * @param a Pointer to the first ResultEntry.
  * @param b Pointer to the second ResultEntry.
@@ -210,16 +165,68 @@ int compare_results(const void* a, const void* b) {
     ResultEntry* entryB = (ResultEntry*)b;
 
     // Compare dates
-    int dateComparison = compare_datesF(entryA->date, entryB->date);
-    if (dateComparison != 0) {
-        return dateComparison;
+    if (entryA->when != entryB->when) {
+        return entryA->when < entryB->when ? 1 : -1;
     }
 
     // In case of a tie compare Ids
     return strcmp(entryA->id, entryB->id);
 }
 
-void* query2(MANAGER manager,char** args){
+/**
+ * @brief Packs a result ID into a word that sorts like strcmp sorts the IDs.
+ *
+ * Canonical flight IDs (ten digits) come before canonical reservation IDs ("Book" and ten
+ * digits), since a digit sorts before 'B', and IDs of the same kind are in the order of
+ * their number.
+ *
+ * @param id The ID.
+ * @param key Where the packed ID is stored.
+ * @return 1 if the ID is canonical, 0 otherwise.
+ */
+static int pack_result_id(const char* id, uint64_t* key) {
+    if (encode_id_key(id, "", key)) return 1;
+    if (!encode_id_key(id, "Book", key)) return 0;
+
+    *key |= 1ULL << 40;
+    return 1;
+}
+
+/**
+ * @brief Sorts result entries with compare_results' order, by radix on packed (date, ID) keys.
+ *
+ * Falls back to qsort with compare_results when an ID isn't canonical and so can't be packed.
+ *
+ * @param entries The entries.
+ * @param count Number of entries.
+ */
+static void sort_results(ResultEntry* entries, int count) {
+    RADIX_KEY* keys = malloc(sizeof(RADIX_KEY) * (count + 1));
+
+    for (int i = 0; i < count; i++) {
+        if (!pack_result_id(entries[i].id, &keys[i].secondary)) {
+            free(keys);
+            qsort(entries, count, sizeof(ResultEntry), compare_results);
+            return;
+        }
+        // Most recent first
+        keys[i].primary = UINT64_MAX - (uint64_t)entries[i].when;
+        keys[i].index = i;
+    }
+
+    radix_sort(keys, count);
+
+    ResultEntry* sorted = malloc(sizeof(ResultEntry) * (count + 1));
+    for (int i = 0; i < count; i++) sorted[i] = entries[keys[i].index];
+    memcpy(entries, sorted, sizeof(ResultEntry) * count);
+
+    free(sorted);
+    free(keys);
+}
+
+RESULT query2(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* user = args[0];
     int length_args = 0;
     while (args[length_args] != NULL) length_args++;
@@ -232,266 +239,135 @@ void* query2(MANAGER manager,char** args){
         return NULL;
     }
 
-    ResultEntry* result_array = malloc(sizeof(ResultEntry) * 256);
-    int count = 0;
-
     char* status = get_user_account_status(userE);
-    if (strcmp(status, "INACTIVE") == 0){
-        free(result_array);
-        free(status);
-        return NULL;
-    }
-    else if (length_args == 1){ //list all types
-        GPtrArray* flights = get_user_array_by_id(get_pass_c(manager),user);
-        GPtrArray* reservations = get_user_reserv_array_by_id(reservC,user);
-
-        // Iterate over flights
-        for (int i = 0; i < (int)flights->len; i++) {
-            char* flightI = g_ptr_array_index(flights, i);
-            FLIGHT flight = get_flight_by_id(flightsC,flightI);
-            char* date = get_flight_schedule_departure_date(flight);
-
-            char* id_flight = strdup(flightI);
-            result_array[count].id = id_flight;
-            result_array[count].date = date;
-            count++;
-        }
+    int list_flights = length_args == 1 || strcmp(args[1],"flights") == 0;
+    int list_reservations = length_args == 1 || strcmp(args[1],"reservations") == 0;
 
-        // Iterate over reservations
-        for (int i = 0; i < (int)reservations->len; i++) {
-            char* reservationI = g_ptr_array_index(reservations, i);
-            RESERV reservation = get_reservations_by_id(reservC,reservationI);
-            char* date = get_begin_date(reservation);
-
-            char* id_reserv = strdup(reservationI);
-            result_array[count].id = id_reserv;
-            result_array[count].date = concat(date," 00:00:00");
-            count++;
-            free(date);
-        }
-    }
-    else if (strcmp(args[1],"reservations") == 0){
-        GPtrArray* reservations = get_user_reserv_array_by_id(reservC,user);
-
-        // Iterate over reservations
-        for (int i = 0; i < (int)reservations->len; i++) {
-            char* reservationI = g_ptr_array_index(reservations, i);
-            RESERV reservation = get_reservations_by_id(reservC,reservationI);
-            char* date = get_begin_date(reservation);
-
-            char* id_reserv = strdup(reservationI);
-            result_array[count].id = id_reserv;
-            result_array[count].date = concat(date," 00:00:00");
-            count++;
-            free(date);
-        }
-    }
-    else if (strcmp(args[1],"flights") == 0){
-        GPtrArray* flights = get_user_array_by_id(get_pass_c(manager), user);
-
-        // Iterate over flights
-        for (int i = 0; i < (int)flights->len; i++) {
-            char* flightI = g_ptr_array_index(flights, i);
-            FLIGHT flight = get_flight_by_id(flightsC,flightI);
-            char* date = get_flight_schedule_departure_date(flight);
-
-            char* id_flight = strdup(flightI);
-            result_array[count].id = id_flight;
-            result_array[count].date = date;
-            count++;
-        }
-    }
-    else {
-        free(result_array);
+    if (strcmp(status, "INACTIVE") == 0 || (!list_flights && !list_reservations)){
+        free(status);
         return NULL;
     }
+    free(status);
 
-    // Sort ressults
-    char** finalResult = malloc(sizeof(char*)*256);
-    finalResult[0] = int_to_string(count);
-    qsort(result_array, count, sizeof(ResultEntry), compare_results);
+    PASS_C passengersC = get_pass_c(manager);
+    uint32_t n_flights;
+    const uint32_t* flights = get_user_flights_c(passengersC, user, &n_flights);
+    uint32_t n_reservations;
+    const uint32_t* reservations = get_user_reservations_c(reservC, user, &n_reservations);
 
-    if (length_args == 1) finalResult[1] = NULL;
-    else finalResult[1] = strdup(args[1]);
-    for (int j = 2; j < count+2; j++) {
-        char* date = strndup(result_array[j-2].date, 10);
-        char* id = result_array[j-2].id;
-        int total_size = snprintf(NULL, 0,"%s;%s", id, date) + 1;
+    ResultEntry* result_array = malloc(sizeof(ResultEntry) * (n_flights + n_reservations + 1));
+    int count = 0;
 
-        // Alocatte memory to formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
+    // Iterate over flights
+    for (uint32_t i = 0; list_flights && i < n_flights; i++) {
+        char* flightI = get_pass_flight_id_c(passengersC, flights[i]);
+        FLIGHT flight = get_flight_by_id(flightsC,flightI);
+        // Passengers read before their flight was found to be overbooked still point to it
+        if (flight == NULL) continue;
 
-        // Create formatted string
-        snprintf(formatted_string, total_size, "%s;%s", id, date);
+        char* date = get_flight_schedule_departure_date(flight);
 
-        finalResult[j] = strdup(formatted_string);
-        free(formatted_string);
+        result_array[count].id = strdup(flightI);
+        result_array[count].when = pack_datetime(date);
+        result_array[count].type = "flight";
+        count++;
         free(date);
-        free(result_array[j-2].id);
-        free(result_array[j-2].date);
     }
 
-    free(status);
-    free(result_array);
-    return finalResult;
-}
+    // Iterate over reservations
+    for (uint32_t i = 0; list_reservations && i < n_reservations; i++) {
+        RESERV reservation = get_reservation_at_c(reservC, reservations[i]);
+        char* date = get_begin_date(reservation);
 
-void* query3(MANAGER manager,char** args){
-    char* hotel_id = args[0];
-    RESERV_C catalog = get_reserv_c(manager);
+        result_array[count].id = get_reservation_id(reservation);
+        result_array[count].when = pack_date(date) * 1000000;
+        result_array[count].type = "reservation";
+        count++;
+        free(date);
+    }
 
-    double rating = 0;
-    int i = 0;
+    // Sort results
+    sort_results(result_array, count);
 
-    GPtrArray* hotel_array = get_hotel_reserv_array_by_id(catalog, hotel_id);
+    // The type is only listed when both flights and reservations are
+    static const char* names[] = {"id", "date", "type"};
+    RESULT finalResult = create_result(length_args == 1 ? 3 : 2, names);
 
-    if (hotel_array != NULL){
-        for (guint j = 0; j < hotel_array->len; j++) {
-            char* reserv_id = g_ptr_array_index(hotel_array, j);
-            RESERV reservation = get_reservations_by_id(catalog, reserv_id);
-            char* ratingH = get_rating(reservation);
-            double add;
-            sscanf(ratingH, "%lf", &add);
-            rating += add;
-            i++;
-            free(ratingH);
-        }
-        rating = rating/(double)i;
+    for (int j = 0; j < count; j++) {
+        int row = add_result_row(finalResult);
+        set_result_string(finalResult, row, 0, result_array[j].id);
+        set_result_date(finalResult, row, 1, result_array[j].when / 1000000);
+        if (length_args == 1) set_result_ref(finalResult, row, 2, result_array[j].type);
     }
-    else rating = 0;
-
-    char* finalResult = double_to_string(rating);
 
+    free(result_array);
     return finalResult;
 }
 
-/**
- * @brief Compares two date strings in the format "yyyy/mm/dd".
- *
- * This function compares two date strings, first by years, then months, then days.
- * The returning integer is positive if itemB is later than itemA, negative if itemB
- * is earlier than itemA, and zero if they are equal.
- *
- * @param a Pointer to the first date string.
- * @param b Pointer to the second date string.
- * @return The result of the comparison.
- */
-int compare_dates(const void* a, const void* b) {
-    char* itemA = (char*)a;
-    char* itemB = (char*)b;
-
-    // Compare years
-    int yearA, monthA, dayA;
-    sscanf(itemA, "%d/%d/%d", &yearA, &monthA, &dayA);
-
-    int yearB, monthB, dayB;
-    sscanf(itemB, "%d/%d/%d", &yearB, &monthB, &dayB);
-
-    if (yearA != yearB){
-        return yearB - yearA;  // Sort by year in descending order
-    }
-
-    // Compare months
-    if (monthA != monthB){
-        return monthB - monthA;  // Sort by month in descending order
-    }
-
-    // Compare days
-    return dayB - dayA;  // Sort by day in descending order
-}
+RESULT query3(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
+    char* hotel_id = args[0];
+    RESERV_C catalog = get_reserv_c(manager);
 
-/**
- * @brief Compares two reservations based on their dates and IDs.
- *
- * This function is designed to be used with the qsort function to compare two RESERVInfo 
- * structures. It first compares dates using the compare_dates function and then,
- * in case of a tie, compares reservation IDs using strcmp.
- *
- * @param a Pointer to the first RESERVInfo structure.
- * @param b Pointer to the second RESERVInfo structure.
- * @return The result of the comparison.
- */
-int compare_reservations(const void* a, const void* b) {
-    ResultEntry* res_a = (ResultEntry*)a;
-    ResultEntry* res_b = (ResultEntry*)b;
+    double rating = get_hotel_average_rating_c(catalog, hotel_id);
 
-    // Compare begin dates
-    int date_compare = compare_dates(res_a->date, res_b->date);
-    if (date_compare != 0) {
-        return date_compare;
-    }
+    static const char* names[] = {"rating"};
+    RESULT finalResult = create_result(1, names);
+    add_result_row(finalResult);
+    set_result_double(finalResult, 0, 0, rating);
 
-    //If begin dates are equal use the reservation Id as a tiebreaker
-    int compare = strcmp(res_a->id, res_b->id);
-    return compare;
+    return finalResult;
 }
 
-void* query4(MANAGER manager,char** args){
+RESULT query4(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* hotel_id = args[0];
     RESERV_C catalog = get_reserv_c(manager);
 
-    // Create an array to store pointers to the reservations
-    int initialCapacity = 500;
-    ResultEntry* reserv_array = malloc(sizeof(ResultEntry) * initialCapacity);
-    int i = 0;
-
-    GPtrArray* hotel_array = get_hotel_reserv_array_by_id(catalog, hotel_id);
-
-    if (hotel_array != NULL){
-        for (guint j = 0; j < hotel_array->len; j++) {
-            if (i >= initialCapacity) {
-                initialCapacity *= 2;
-                reserv_array = realloc(reserv_array, sizeof(ResultEntry) * initialCapacity);
-            }
-            char* reserv_id = g_ptr_array_index(hotel_array, j);
-            RESERV reservation = get_reservations_by_id(catalog, reserv_id);
-            reserv_array[i].id = get_reservation_id(reservation);
-            reserv_array[i].date = get_begin_date(reservation);
-            i++;
+    // Already sorted by begin date and ID when the index was built
+    uint32_t n_reservations;
+    const uint32_t* hotel_array = get_hotel_reservations_c(catalog, hotel_id, &n_reservations);
+    if (hotel_array == NULL) return NULL;
+
+    // Optional page of the list: an offset and a limit
+    uint32_t first = 0, last = n_reservations;
+    if (args[1] != NULL){
+        int offset = atoi(args[1]);
+        if (offset > 0) first = (uint32_t)offset < last ? (uint32_t)offset : last;
+        if (args[2] != NULL){
+            int limit = atoi(args[2]);
+            if (limit >= 0 && (uint32_t)limit < last - first) last = first + limit;
         }
     }
-    else {
-        free(reserv_array);
-        return NULL;
-    }
 
-    // Sort reservations using sort function
-    qsort(reserv_array, i, sizeof(ResultEntry), compare_reservations);
+    static const char* names[] = {"id", "begin_date", "end_date", "user_id", "rating", "total_price"};
+    RESULT finalResult = create_result(6, names);
 
-    char** finalResult = malloc(sizeof(char*)*(i+1));
-    finalResult[0] = int_to_string(i);
-    for (int j = 1; j < i+1; j++) {
-        RESERV reservation = get_reservations_by_id(catalog,reserv_array[j-1].id);
+    for (uint32_t j = first; j < last; j++) {
+        RESERV reservation = get_reservation_at_c(catalog, hotel_array[j]);
         char* begin = get_begin_date(reservation);
         char* end = get_end_date(reservation);
-        char* user = get_user_id_R(reservation);
-        char* rating = get_rating(reservation);
 
-        int total_size = snprintf(NULL, 0,"%s;%s;%s;%s;%s;%f", reserv_array[j-1].id,
-        begin, end, user, rating, get_cost(reservation)) + 1;
+        int row = add_result_row(finalResult);
+        set_result_string(finalResult, row, 0, get_reservation_id(reservation));
+        set_result_date(finalResult, row, 1, pack_date(begin));
+        set_result_date(finalResult, row, 2, pack_date(end));
+        set_result_string(finalResult, row, 3, get_user_id_R(reservation));
+        set_result_string(finalResult, row, 4, get_rating(reservation));
+        set_result_double(finalResult, row, 5, get_cost(reservation));
 
-        // Allocate memory to formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
-
-        // Create fromatted string
-        snprintf(formatted_string, total_size, "%s;%s;%s;%s;%s;%.3f",reserv_array[j-1].id,
-        begin, end, user, rating, get_cost(reservation));
-
-        finalResult[j] = formatted_string;
         free(begin);
-        free(user);
         free(end);
-        free(rating);
-        free(reserv_array[j-1].id);
-        free(reserv_array[j-1].date);
     }
 
-    free(reserv_array);
-
     return finalResult;
 }
 
-void* query5(MANAGER manager,char** args){
+RESULT query5(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* origin = args[0];
     char* begin_date = args[1];
     char* end_date = args[2];
@@ -501,6 +377,8 @@ void* query5(MANAGER manager,char** args){
         return NULL;
     }
     FLIGHTS_C catalog = get_flights_c(manager);
+    long long begin = pack_datetime(begin_date);
+    long long end = pack_datetime(end_date);
 
     // Create an array to store pointers to flights
     int initialCapacity = 500;
@@ -508,63 +386,48 @@ void* query5(MANAGER manager,char** args){
 
     int i = 0;
 
-    GHashTable* flights = get_hash_table_flight(catalog);
+    ID_MAP flights = get_hash_table_flight(catalog);
 
     // Iterate over catalog reservations
-    GHashTableIter iter;
+    ID_MAP_ITER iter;
     gpointer key, value;
-    g_hash_table_iter_init(&iter, flights);
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
+    id_map_iter_init(&iter, flights);
+    while (id_map_iter_next(&iter, &key, &value)) {
         FLIGHT flight = (FLIGHT)value;
         char* date = get_flight_schedule_departure_date(flight);
         char* originC = get_flight_origin(flight);
+        long long when = pack_datetime(date);
 
         // Verify if a reservation belongs to the desire airport
-        if (strcmp(originC, origin) == 0 &&
-        (compare_datesF(begin_date,date) >= 0 && compare_datesF(date,end_date) >= 0)) {
+        if (strcmp(originC, origin) == 0 && when >= begin && when <= end) {
             if (i >= initialCapacity) {
                 initialCapacity *= 2;
                 flight_array = realloc(flight_array, sizeof(ResultEntry) * initialCapacity);
             }
             flight_array[i].id = get_flight_id(flight);
-            flight_array[i].date = get_flight_schedule_departure_date(flight);
+            flight_array[i].when = when;
             i++;
         }
         free(date);
         free(originC);
     }
 
-    // Sort flights using compare function
-    qsort(flight_array, i, sizeof(ResultEntry), compare_results);
+    // Sort flights
+    sort_results(flight_array, i);
 
-    char** finalResult = malloc(sizeof(char*)*(i+1));
-    finalResult[0] = int_to_string(i);
-    for (int j = 1; j < i+1; j++) {
-        //id;schedule_departure_date;destination;airline;plane_model
-        FLIGHT flight = get_flight_by_id(catalog, flight_array[j-1].id);
-
-        char* schedule_departure_date = get_flight_schedule_departure_date(flight);
-        char* destination = get_flight_destination(flight);
-        char* airline = get_flight_airline(flight);
-        char* plane_model = get_flight_plane_model(flight);
-
-        int total_size = snprintf(NULL, 0,"%s;%s;%s;%s;%s\n", flight_array[j-1].id,
-        schedule_departure_date, destination, airline,plane_model) + 1;
+    static const char* names[] = {"id", "schedule_departure_date", "destination", "airline", "plane_model"};
+    RESULT finalResult = create_result(5, names);
 
-        // Alocatte memory to formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
-
-        // Create formatted string
-        snprintf(formatted_string, total_size, "%s;%s;%s;%s;%s", flight_array[j-1].id,
-        schedule_departure_date, destination, airline,plane_model);
+    for (int j = 0; j < i; j++) {
+        //id;schedule_departure_date;destination;airline;plane_model
+        FLIGHT flight = get_flight_by_id(catalog, flight_array[j].id);
 
-        finalResult[j] = formatted_string;
-        free(flight_array[j-1].id);
-        free(flight_array[j-1].date);
-        free(schedule_departure_date);
-        free(destination);
-        free(airline);
-        free(plane_model);
+        int row = add_result_row(finalResult);
+        set_result_string(finalResult, row, 0, flight_array[j].id);
+        set_result_datetime(finalResult, row, 1, flight_array[j].when);
+        set_result_string(finalResult, row, 2, get_flight_destination(flight));
+        set_result_string(finalResult, row, 3, get_flight_airline(flight));
+        set_result_string(finalResult, row, 4, get_flight_plane_model(flight));
     }
 
     free(flight_array);
@@ -635,7 +498,9 @@ int findAirportPosition(AirportInfo* array, int size, const char* airport) {
 
 // receives <Year> and N
 // return airport name and number of passengers
-void* query6(MANAGER manager,char** args){
+RESULT query6(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* Year = args[0];
     int N = ourAtoi(args[1]);
     int year = ourAtoi(args[0]);
@@ -647,13 +512,13 @@ void* query6(MANAGER manager,char** args){
 
     int i = 0;
 
-    GHashTable* flights = get_hash_table_flight(catalog);
+    ID_MAP flights = get_hash_table_flight(catalog);
 
     // Iterate over catalog reservations
-    GHashTableIter iter;
+    ID_MAP_ITER iter;
     gpointer key, value;
-    g_hash_table_iter_init(&iter, flights);
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
+    id_map_iter_init(&iter, flights);
+    while (id_map_iter_next(&iter, &key, &value)) {
         FLIGHT flight = (FLIGHT) value;
 
         char* date = get_flight_schedule_arrival_date(flight);
@@ -703,26 +568,19 @@ void* query6(MANAGER manager,char** args){
         free(id_flight);
     }
 
-    // Sort flights using compare function
-    qsort(array, i, sizeof(AirportInfo), sort_airports);
+    // Only the first N airports are emitted, so only those are put in order
+    select_top_k(array, i, sizeof(AirportInfo), N, sort_airports);
 
-    char** finalResult = malloc(sizeof(char*)*(N+1));
-    finalResult[0] = (i < N ? int_to_string(i) : int_to_string(N));
-    for (int j = 1; j < i+1 && j<N+1; j++) {
-        int total_size = snprintf(NULL, 0,"%s;%d", array[j-1].name,
-        array[j-1].nPassengers) + 1;
+    static const char* names[] = {"name", "passengers"};
+    RESULT finalResult = create_result(2, names);
 
-        // Alocatte memory to a formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
-
-        // Create fromatted string
-        snprintf(formatted_string, total_size, "%s;%d", array[j-1].name, array[j-1].nPassengers);
-
-        finalResult[j] = formatted_string;
-    }
-
-    for(int j = 0; j < i; j++){
-        free(array[j].name);
+    for (int j = 0; j < i; j++) {
+        if (j < N){
+            int row = add_result_row(finalResult);
+            set_result_string(finalResult, row, 0, array[j].name);
+            set_result_int(finalResult, row, 1, array[j].nPassengers);
+        }
+        else free(array[j].name);
     }
 
     free(array);
@@ -764,30 +622,26 @@ int findAirportPosition2(AirportInfo2* array, int size, const char* airport) {
     return -1;
 }
 
-
-int compare_ints(gconstpointer a, gconstpointer b) {
-    return *(const int*)a - *(const int*)b;
-}
-
 //Listar o top N aeroportos com a maior mediana de atrasos.
-void* query7(MANAGER manager,char** args){
+RESULT query7(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     //guardar todas os atrasos num array para cada aeroporto e obter a mediana
     int N = ourAtoi(args[0]);
     if (N < 0) return NULL;
     FLIGHTS_C catalog = get_flights_c(manager);
-    GHashTable* flights = get_hash_table_flight(catalog);
+    ID_MAP flights = get_hash_table_flight(catalog);
     int i = 0;
     int initialCapacity = 500;
     AirportInfo2* array = malloc(sizeof(AirportInfo2) * initialCapacity);
     int delay;
-    char** finalResult = malloc(sizeof(char*)*(N+1));
 
     // Iterate over catalog reservations
-    GHashTableIter iter;
+    ID_MAP_ITER iter;
     gpointer key, value;
-    g_hash_table_iter_init(&iter, flights);
+    id_map_iter_init(&iter, flights);
 
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
+    while (id_map_iter_next(&iter, &key, &value)) {
         FLIGHT flight = (FLIGHT) value;
 
         char* airport = get_flight_origin(flight);
@@ -819,35 +673,22 @@ void* query7(MANAGER manager,char** args){
 
 
     for(int k = 0; k < i; k++) {
-        g_array_sort(array[k].delays, compare_ints);
-        guint length = array[k].delays->len;
-        if (length % 2 != 0) array[k].median = g_array_index(array[k].delays, int , (length/2));
-        else {
-            int first = g_array_index(array[k].delays, int , (length/2) - 1);
-            int second = g_array_index(array[k].delays, int , (length/2));
-            array[k].median = (first + second) / 2;
-        }
+        GArray* delays = array[k].delays;
+        array[k].median = median_of_ints(&g_array_index(delays, int, 0), delays->len);
     }
 
-    qsort(array, i, sizeof(AirportInfo2), sort_airports2);
-
-
-    finalResult[0] = (i < N ? int_to_string(i) : int_to_string(N));
-    for (int j = 1; j < i+1 && j<N+1; j++) {
-        int total_size = snprintf(NULL, 0,"%s;%d", array[j-1].name,
-        array[j-1].median) + 1;
+    select_top_k(array, i, sizeof(AirportInfo2), N, sort_airports2);
 
-        // Alocatte memory to a formatted string
-        char* formatted_string = malloc(total_size);
+    static const char* names[] = {"name", "median"};
+    RESULT finalResult = create_result(2, names);
 
-        // Create fromatted string
-        snprintf(formatted_string, total_size, "%s;%d", array[j-1].name, array[j-1].median);
-
-        finalResult[j] = formatted_string;
-    }
-
-    for(int j = 0; j < i; j++){
-        free(array[j].name);
+    for (int j = 0; j < i; j++) {
+        if (j < N){
+            int row = add_result_row(finalResult);
+            set_result_string(finalResult, row, 0, array[j].name);
+            set_result_int(finalResult, row, 1, array[j].median);
+        }
+        else free(array[j].name);
         g_array_free(array[j].delays, TRUE);
     }
 
@@ -879,20 +720,22 @@ int compare_dates_timeless(char* itemA, char* itemB) {
 
 }
 
-void* query8(MANAGER manager, char** args){
+RESULT query8(MANAGER manager, char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     char* hotel_id = strdup(args[0]);
     RESERV_C catalog = get_reserv_c(manager);
     int price, n_nights, result = 0;
     char* begin = strdup(args[1]);
     char* end = strdup(args[2]);
 
-    GPtrArray* hotel_array = get_hotel_reserv_array_by_id(catalog, hotel_id);
+    uint32_t n_reservations;
+    const uint32_t* hotel_array = get_hotel_reservations_c(catalog, hotel_id, &n_reservations);
 
     if (hotel_array != NULL){
-        for (guint j = 0; j < hotel_array->len; j++) {
+        for (uint32_t j = 0; j < n_reservations; j++) {
             n_nights = 0;
-            char* reserv_id = g_ptr_array_index(hotel_array, j);
-            RESERV reservation = get_reservations_by_id(catalog, reserv_id);
+            RESERV reservation = get_reservation_at_c(catalog, hotel_array[j]);
             char* begin_date = get_begin_date(reservation);
             char* end_date = get_end_date(reservation);
             price = get_price_per_night(reservation);
@@ -913,7 +756,11 @@ void* query8(MANAGER manager, char** args){
     free(begin);
     free(end);
     free(hotel_id);
-    char* finalResult = int_to_string(result);
+
+    static const char* names[] = {"revenue"};
+    RESULT finalResult = create_result(1, names);
+    add_result_row(finalResult);
+    set_result_int(finalResult, 0, 0, result);
 
     return finalResult;
 }
@@ -924,35 +771,58 @@ typedef struct {
     char* user_id;
 } User_list;
 
+/**
+ * @brief Collation of the names listed by query 9, shared by every thread.
+ *
+ * setlocale changes the locale of the whole process and isn't thread-safe, so the locale is
+ * created once and passed to strcoll_l instead.
+ */
+static locale_t names_collation;
+
+/**
+ * @brief Makes sure that names_collation is created only once.
+ */
+static pthread_once_t names_collation_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Creates names_collation, falling back to the byte order of the C locale when en_US.UTF-8 isn't installed.
+ */
+static void create_names_collation(void) {
+    names_collation = newlocale(LC_COLLATE_MASK, "en_US.UTF-8", (locale_t)0);
+    if (names_collation == (locale_t)0) names_collation = newlocale(LC_COLLATE_MASK, "C", (locale_t)0);
+}
+
 int sort_users(const void* a, const void* b) {
-    setlocale(LC_COLLATE, "en_US.UTF-8");
     User_list* f_a = (User_list*)a;
     User_list* f_b = (User_list*)b;
 
-    int result = strcoll(f_a->user, f_b->user);
+    int result = strcoll_l(f_a->user, f_b->user, names_collation);
 
-    if(result == 0) result = strcoll(f_a->user_id, f_b->user_id);
+    if(result == 0) result = strcoll_l(f_a->user_id, f_b->user_id, names_collation);
     return result;
 }
 
-void* query9(MANAGER manager,char** args) {
+RESULT query9(MANAGER manager,char** args) {
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     USERS_C catalog = get_users_c(manager);
-    GHashTable* users = get_hash_table_users(catalog);
-    GHashTableIter iter;
+    STRING_MAP users = get_hash_table_users(catalog);
+    STRING_MAP_ITER iter;
     gpointer key, value;
     char* prefix = args[0];
     int i = 0;
     int initialCapacity = 500;
 
     User_list* user_list = malloc(sizeof(User_list) * initialCapacity);
-    g_hash_table_iter_init(&iter, users);
+    string_map_iter_init(&iter, users);
+    pthread_once(&names_collation_once, create_names_collation);
 
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
+    while (string_map_iter_next(&iter, &key, &value)) {
         USER entity = (USER) value;
         char* user = get_user_name(entity);
         char* user_status = get_user_account_status(entity);
         char *truncatedString = strndup(user, strlen(prefix));
-        if (strcoll(truncatedString, prefix) == 0 && strcmp(user_status, "INACTIVE") != 0){
+        if (strcoll_l(truncatedString, prefix, names_collation) == 0 && strcmp(user_status, "INACTIVE") != 0){
             char* user_id = get_user_id(entity);
             if (i >= initialCapacity) {
                     initialCapacity *= 2;
@@ -970,26 +840,13 @@ void* query9(MANAGER manager,char** args) {
 
     qsort(user_list, i, sizeof(User_list), sort_users);
 
-    char** finalResult = malloc(sizeof(char*)*(i+1));
-
-    finalResult[0] = int_to_string(i);
-
-    for (int j = 1; j < i+1 && j<i+1; j++) {
-        int total_size = snprintf(NULL, 0,"%s;%s", user_list[j-1].user_id,
-        user_list[j-1].user) + 1;
-
-        // Alocatte memory to a formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
+    static const char* names[] = {"id", "name"};
+    RESULT finalResult = create_result(2, names);
 
-        // Create fromatted string
-        snprintf(formatted_string, total_size, "%s;%s", user_list[j-1].user_id, user_list[j-1].user);
-
-        finalResult[j] = formatted_string;
-    }
-
-    for(int j = 0; j < i; j++){
-        free(user_list[j].user_id);
-        free(user_list[j].user);
+    for (int j = 0; j < i; j++) {
+        int row = add_result_row(finalResult);
+        set_result_string(finalResult, row, 0, user_list[j].user_id);
+        set_result_string(finalResult, row, 1, user_list[j].user);
     }
 
     free(user_list);
@@ -1011,14 +868,28 @@ int compareResults(const void* a, const void* b) {
     return ((Result10*)a)->date > ((Result10*)b)->date;
 }
 
-void addArrayToHashTable(GPtrArray *array, GHashTable *hashTable) {
-    for (guint i = 0; i < array->len; i++) {
-        gchar *username = g_ptr_array_index(array, i);
-        g_hash_table_replace(hashTable, username, NULL);
-    }
+/**
+ * @brief Count the users of a list of passengers not yet seen in the current period.
+ *
+ * @param users The user index of each passenger.
+ * @param count Number of passengers.
+ * @param seen Period in which each user was last seen.
+ * @param period The current period, different from every earlier one.
+ * @return The number of users seen for the first time.
+ */
+static int count_new_users(const uint32_t* users, uint32_t count, unsigned* seen, unsigned period){
+    int new_users = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (seen[users[i]] == period) continue;
+        seen[users[i]] = period;
+        new_users++;
+    }
+    return new_users;
 }
 
-void* query10(MANAGER manager,char** args){
+RESULT query10(MANAGER manager,char** args){
+    TRACE_FUNCTION();
+    ALLOC_TAG_SCOPE(ALLOC_QUERIES);
     USERS_C catalogU = get_users_c(manager);
     RESERV_C catalogR = get_reserv_c(manager);
     FLIGHTS_C catalogF = get_flights_c(manager);
@@ -1037,6 +908,10 @@ void* query10(MANAGER manager,char** args){
     }
     int count = 0;
 
+    // Each period marks the users it has seen, so counting its unique passengers needs no set of IDs
+    unsigned* seen = calloc(get_pass_n_users_c(catalogP) + 1, sizeof(unsigned));
+    unsigned period = 0;
+
     if (year == NULL){
         //1st option (No indication provided)
         for (int k = 2010; k < 2024; k++) {
@@ -1045,7 +920,8 @@ void* query10(MANAGER manager,char** args){
 
             // Initialize the counts for each year.
             int total_user = 0, total_flight = 0, total_reserv = 0, total_pass = 0, total_passU = 0;
-            GHashTable* uniqueUsers = g_hash_table_new(g_str_hash, g_str_equal);
+            int unique = 0;
+            period++;
 
             for (int j = 0; j < 12; j++) {
                 char month[4];
@@ -1071,23 +947,20 @@ void* query10(MANAGER manager,char** args){
                         sprintf(day, "%d", i);
 
                     char* data = concat(date, day);
-                    GPtrArray* passengers = get_passengers_c(catalogP, data);
+                    uint32_t n_passengers;
+                    const uint32_t* passengers = get_passengers_c(catalogP, catalogF, data, &n_passengers);
 
                     if (users != NULL) user += users[i - 1];
                     if (flights != NULL) flight += flights[i - 1];
                     if (reservations != NULL) reserv += reservations[i - 1];
 
-                    if (passengers != NULL) {
-                        pass += passengers->len;
-                        addArrayToHashTable(passengers, uniqueUsers);
-                    }
+                    pass += n_passengers;
+                    unique += count_new_users(passengers, n_passengers, seen, period);
 
                     free(data);
                 }
 
-                if (uniqueUsers != NULL) {
-                    passU = g_hash_table_size(uniqueUsers);
-                }
+                passU = unique;
 
                 // Accumulate the totals for each year.
                 total_user += user;
@@ -1099,8 +972,6 @@ void* query10(MANAGER manager,char** args){
                 free(date);
             }
 
-            g_hash_table_destroy(uniqueUsers);
-
             if (total_user != 0 || total_flight != 0 || total_reserv != 0 || total_pass != 0 || total_passU != 0) {
                 result[count].date = k;
                 result[count].users = total_user;
@@ -1115,7 +986,11 @@ void* query10(MANAGER manager,char** args){
     }
     else if (month == NULL){
         //2nd option (Specify the year)
-        if(ourAtoi(year) > 2023 || ourAtoi(year) < 2010) return NULL;
+        if(ourAtoi(year) > 2023 || ourAtoi(year) < 2010) {
+            free(result);
+            free(seen);
+            return NULL;
+        }
 
         for (int j = 0; j < 12; j++){
             char month[4];
@@ -1127,8 +1002,7 @@ void* query10(MANAGER manager,char** args){
             int* reservations = get_reservNumber_c(catalogR, date);
             int* flights = get_flightNumber_c(catalogF, date);
 
-            GHashTable *uniqueUsers;
-            uniqueUsers = g_hash_table_new(g_str_hash, g_str_equal);
+            period++;
 
             int user = 0, flight = 0, reserv = 0, pass = 0, passU = 0;
 
@@ -1138,20 +1012,17 @@ void* query10(MANAGER manager,char** args){
                 if (i < 10) sprintf(day, "0%d", i);
                 else sprintf(day,"%d", i);
                 char* data = concat(date,day);
-                GPtrArray* passengers = get_passengers_c(catalogP, data);
+                uint32_t n_passengers;
+                const uint32_t* passengers = get_passengers_c(catalogP, catalogF, data, &n_passengers);
                 if (users != NULL) user += users[i-1];
                 if (flights != NULL) flight += flights[i-1];
                 if (reservations != NULL) reserv += reservations[i-1];
 
-                if (passengers != NULL) {
-                    pass += passengers->len;
-                    addArrayToHashTable(passengers, uniqueUsers);
-                }
+                pass += n_passengers;
+                passU += count_new_users(passengers, n_passengers, seen, period);
                 free(data);
                 i++;
             }
-            if (uniqueUsers != NULL) passU = g_hash_table_size(uniqueUsers);
-            g_hash_table_destroy(uniqueUsers);
 
             if (user != 0 || flight != 0 || reserv != 0 || pass != 0 || passU != 0){
 
@@ -1174,6 +1045,7 @@ void* query10(MANAGER manager,char** args){
         int M = ourAtoi(month);
         if(Y > 2023 || Y < 2010 || M < 1 || M > 12) {
             free(result);
+            free(seen);
             return NULL;
         }
 
@@ -1189,19 +1061,14 @@ void* query10(MANAGER manager,char** args){
             else sprintf(day,"%d", (i+1));
 
             char* data = concat(date,day);
-            GPtrArray* passengers = get_passengers_c(catalogP, data);
+            uint32_t n_passengers;
+            const uint32_t* passengers = get_passengers_c(catalogP, catalogF, data, &n_passengers);
             int user = 0, flight = 0, reserv = 0, pass = 0, passU = 0;
             if (users != NULL) user = users[i];
             if (flights != NULL) flight = flights[i];
             if (reservations != NULL) reserv = reservations[i];
-            if (passengers != NULL) {
-                pass = passengers->len;
-                GHashTable *uniqueUsers;
-                uniqueUsers = g_hash_table_new(g_str_hash, g_str_equal);
-                addArrayToHashTable(passengers, uniqueUsers);
-                if (uniqueUsers != NULL) passU = g_hash_table_size(uniqueUsers);
-                g_hash_table_destroy(uniqueUsers);
-            }
+            pass = n_passengers;
+            passU = count_new_users(passengers, n_passengers, seen, ++period);
             free(data);
 
             if (user != 0 || flight != 0 || reserv != 0 || pass != 0 || passU != 0){
@@ -1217,158 +1084,25 @@ void* query10(MANAGER manager,char** args){
         free(date);
     }
 
-    char** finalResult = malloc(sizeof(char*)*256);
-
-    finalResult[0] = int_to_string(count);
-    if (year == NULL) finalResult[1] = "year";
-    else if (month == NULL) finalResult[1] = "month";
-    else finalResult[1] = "day";
+    static const char* names[] = {"year", "users", "flights", "passengers", "unique_passengers", "reservations"};
+    RESULT finalResult = create_result(6, names);
 
-    for (int j = 2; j < count+2; j++) {
-        int date = result[j-2].date;
-        int users = result[j-2].users;
-        int flights = result[j-2].flights;
-        int passengers = result[j-2].passengers;
-        int unique_passengers = result[j-2].unique_passengers;
-        int reservations = result[j-2].reservations;
+    if (year == NULL) set_result_name(finalResult, 0, "year");
+    else if (month == NULL) set_result_name(finalResult, 0, "month");
+    else set_result_name(finalResult, 0, "day");
 
-        int total_size = snprintf(NULL, 0,"%d;%d;%d;%d;%d;%d", date, users,
-        flights, passengers, unique_passengers, reservations) + 1;
-
-        // Alocatte memory to a formatted string
-        char* formatted_string = malloc(sizeof(char*)*total_size);
-
-        // Create fromatted string
-        snprintf(formatted_string, total_size,"%d;%d;%d;%d;%d;%d", date, users,
-        flights, passengers, unique_passengers, reservations);
-
-        finalResult[j] = formatted_string;
+    for (int j = 0; j < count; j++) {
+        int row = add_result_row(finalResult);
+        set_result_int(finalResult, row, 0, result[j].date);
+        set_result_int(finalResult, row, 1, result[j].users);
+        set_result_int(finalResult, row, 2, result[j].flights);
+        set_result_int(finalResult, row, 3, result[j].passengers);
+        set_result_int(finalResult, row, 4, result[j].unique_passengers);
+        set_result_int(finalResult, row, 5, result[j].reservations);
     }
 
     free(result);
+    free(seen);
 
     return finalResult;
 }
-
-void free_query(void* result, int query_id){
-
-    static free_queries_func queries[] = {free_query1, free_query2, free_query3,
-                                        free_query4, free_query5, free_query6,
-                                        free_query7, free_query8, free_query9, free_query10};
-
-    queries[query_id - 1](result);
-
-}
-
-void free_query1(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    for (int i = 0; i < 8; i++) {
-        if(resultF[i] != NULL) free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query2(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    free(resultF[0]);
-    for (int i = 2; i < n+2; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query3(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    free(resultF);
-}
-
-void free_query4(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    for (int i = 0; i < n+1; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query5(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    for (int i = 0; i < n+1; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query6(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    for (int i = 0; i < n+1; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query7(void* result){
-        if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    for (int i = 0; i < n+1; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query8(void* result){
-    if (result == NULL) {
-    return;
-    }
-    char** resultF = (char**) result;
-    free(resultF);
-}
-
-void free_query9(void* result) {
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    for (int i = 0; i < n+1; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
-
-void free_query10(void* result){
-    if (result == NULL) {
-        return;
-    }
-    char** resultF = (char**) result;
-    int n = ourAtoi(resultF[0]);
-    free(resultF[0]);
-    for (int i = 2; i < n+2; i++) {
-        free(resultF[i]);
-    }
-    free(resultF);
-}
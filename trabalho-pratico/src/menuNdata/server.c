@@ -0,0 +1,313 @@
+/**
+ * @file server.c
+ * @brief Contains the code related to the query server mode and its client
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "menuNdata/server.h"
+#include "utils/trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief Maximum size of a single argument, limited by the buffer used by parser_query for quoted arguments.
+ */
+#define MAX_ARG_SIZE 99
+
+/**
+ * @struct connection
+ * @brief The data a client thread needs.
+ */
+struct connection {
+    MANAGER manager; /**< Shared read-only catalogs. */
+    int fd; /**< Client socket. */
+};
+
+static volatile sig_atomic_t running = 1;
+static pthread_mutex_t clients_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t clients_done = PTHREAD_COND_INITIALIZER;
+static int active_clients = 0;
+
+/**
+ * @brief Signal handler that stops the server.
+ *
+ * @param signal The received signal.
+ */
+static void stop_server(int signal){
+    (void)signal;
+    running = 0;
+}
+
+/**
+ * @brief Writes a whole buffer to a socket.
+ *
+ * @param fd The socket.
+ * @param data The buffer.
+ * @param length The size of the buffer.
+ * @return 0 on success, -1 if the peer went away.
+ */
+static int send_all(int fd, const char* data, size_t length){
+    while (length > 0){
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n == -1 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        data += n;
+        length -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Checks that a line is a query the interpreter can run safely.
+ *
+ * The batch mode trusts its input file, the server can't: an unknown identifier, a missing
+ * argument or an oversized one would crash every client.
+ *
+ * @param line The query line.
+ * @return 1 if the line is valid, 0 otherwise.
+ */
+static int valid_query_line(char* line){
+    static const int n_args[] = {1, 1, 1, 1, 3, 2, 1, 3, 1, 0};
+
+    int id = (line[0] == '1' && line[1] == '0') ? 10 : line[0] - '0';
+    if (id < 1 || id > 10) return 0;
+
+    char* rest = line + (id == 10 ? 2 : 1);
+    if (*rest == 'F') rest++;
+    if (*rest != '\0' && *rest != ' ') return 0;
+
+    int count = 0;
+    while (*rest != '\0'){
+        if (*rest == ' '){
+            rest++;
+            continue;
+        }
+
+        char* start = rest;
+        if (*rest == '"'){
+            char* close = strchr(rest + 1, '"');
+            if (close == NULL) return 0;
+            rest = close + 1;
+        }
+        else {
+            while (*rest != '\0' && *rest != ' ') rest++;
+        }
+
+        if (rest - start > MAX_ARG_SIZE) return 0;
+        count++;
+    }
+
+    return count >= n_args[id - 1] && count < MAX_ARGS - 1;
+}
+
+/**
+ * @brief Answers the query lines of a client until it disconnects.
+ *
+ * @param data The client connection.
+ * @return NULL.
+ */
+static void* serve_client(void* data){
+    struct connection* connection = data;
+    FILE* input = fdopen(connection->fd, "r");
+
+    char* line = NULL;
+    size_t lsize = 0;
+    ssize_t length;
+
+    while ((length = getline(&line, &lsize, input)) != -1){
+        while (length > 0 && (line[length-1] == '\n' || line[length-1] == '\r')) line[--length] = '\0';
+
+        char* buffer = NULL;
+        size_t size = 0;
+        FILE* output = open_memstream(&buffer, &size);
+        int valid = valid_query_line(line);
+
+        if (valid){
+            RESULT result = parser_query(connection->manager, line);
+            output_query(output, result, get_query_id(line));
+            free_result(result);
+        }
+        else fprintf(output, "Invalid query: %s\n", line);
+
+        fclose(output);
+
+        char header[32];
+        int header_size = snprintf(header, sizeof(header), "%s %zu\n", valid ? "OK" : "ERR", size);
+        int failed = send_all(connection->fd, header, header_size) == -1 ||
+                     send_all(connection->fd, buffer, size) == -1;
+        free(buffer);
+        if (failed) break;
+    }
+
+    free(line);
+    fclose(input);
+    free(connection);
+
+    pthread_mutex_lock(&clients_lock);
+    active_clients--;
+    pthread_cond_signal(&clients_done);
+    pthread_mutex_unlock(&clients_lock);
+
+    return NULL;
+}
+
+int server(char* path1, char* socket_path){
+    USERS_C users_catalog = create_user_c();
+    FLIGHTS_C flights_catalog = create_flight_c();
+    RESERV_C reservations_catalog = create_reservations_c();
+    PASS_C passengers_catalog = create_passengers_c();
+    MANAGER manager_catalog = create_manager_c(users_catalog,flights_catalog,reservations_catalog,passengers_catalog);
+
+    if (set_catalogs(manager_catalog,path1) == -1){
+        free_manager_c(manager_catalog);
+        return -1;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path);
+    if (listen_fd == -1 ||
+        bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) == -1 ||
+        listen(listen_fd, SOMAXCONN) == -1){
+        perror("Error creating server socket");
+        if (listen_fd != -1) close(listen_fd);
+        free_manager_c(manager_catalog);
+        return -1;
+    }
+
+    // No SA_RESTART, so that accept is interrupted by the signal
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop_server;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    printf("Serving queries on %s\n", socket_path);
+    fflush(stdout);
+
+    while (running){
+        int client_fd = accept(listen_fd, NULL, NULL);
+        if (client_fd == -1) continue;
+
+        struct connection* connection = malloc(sizeof(struct connection));
+        connection->manager = manager_catalog;
+        connection->fd = client_fd;
+
+        pthread_mutex_lock(&clients_lock);
+        active_clients++;
+        pthread_mutex_unlock(&clients_lock);
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, serve_client, connection) != 0){
+            close(client_fd);
+            free(connection);
+            pthread_mutex_lock(&clients_lock);
+            active_clients--;
+            pthread_mutex_unlock(&clients_lock);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    close(listen_fd);
+    unlink(socket_path);
+
+    // Connected clients still use the catalogs
+    pthread_mutex_lock(&clients_lock);
+    while (active_clients > 0) pthread_cond_wait(&clients_done, &clients_lock);
+    pthread_mutex_unlock(&clients_lock);
+
+    free_manager_c(manager_catalog);
+
+    TRACE_DUMP(TRACE_PATH);
+
+    return 0;
+}
+
+/**
+ * @brief Sends a query line and prints its answer.
+ *
+ * @param fd The server socket.
+ * @param answers The buffered stream reading from the same socket.
+ * @param query The query line.
+ * @return 0 if the query was answered successfully, 1 otherwise.
+ */
+static int send_query(int fd, FILE* answers, char* query){
+    if (send_all(fd, query, strlen(query)) == -1 || send_all(fd, "\n", 1) == -1) return 1;
+
+    char status[4];
+    size_t size;
+    if (fscanf(answers, "%3s %zu", status, &size) != 2 || fgetc(answers) != '\n') return 1;
+
+    int ok = strcmp(status, "OK") == 0;
+    char* buffer = malloc(size + 1);
+    size_t n = fread(buffer, 1, size, answers);
+    fwrite(buffer, 1, n, ok ? stdout : stderr);
+    free(buffer);
+
+    return (n == size && ok) ? 0 : 1;
+}
+
+int client(char* socket_path, char** queries, int n_queries){
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1 || connect(fd, (struct sockaddr*)&address, sizeof(address)) == -1){
+        perror("Error connecting to the server");
+        if (fd != -1) close(fd);
+        return 1;
+    }
+
+    FILE* answers = fdopen(dup(fd), "r");
+    int failed = 0;
+
+    if (queries != NULL){
+        for (int i = 0; i < n_queries; i++) failed |= send_query(fd, answers, queries[i]);
+    }
+    else {
+        char* line = NULL;
+        size_t lsize = 0;
+        ssize_t length;
+        while ((length = getline(&line, &lsize, stdin)) != -1){
+            if (length > 0 && line[length-1] == '\n') line[length-1] = '\0';
+            if (line[0] == '\0') continue;
+            failed |= send_query(fd, answers, line);
+        }
+        free(line);
+    }
+
+    fclose(answers);
+    close(fd);
+
+    return failed;
+}
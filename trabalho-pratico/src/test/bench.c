@@ -0,0 +1,230 @@
+/**
+ * @file bench.c
+ * @brief Benchmark runner for the query scenarios.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @struct bench_scenario
+ * @brief A query and the arguments it is benchmarked with.
+ */
+struct bench_scenario {
+    int query; /**< Query identifier, from 1 to 10. */
+    const char* name; /**< Scenario name, the same used by the query tests. */
+    const char* args[4]; /**< Query arguments, NULL terminated. */
+};
+
+/**
+ * @brief The scenarios of the query tests.
+ */
+static const struct bench_scenario scenarios[] = {
+    {1, "Valid user", {"Jéssica Tavares", NULL}},
+    {1, "Invalid user", {"DGarcia429", NULL}},
+    {1, "Valid flight", {"0000000029", NULL}},
+    {1, "Invalid flight", {"0000000678", NULL}},
+    {1, "Valid reservation", {"Book0000000048", NULL}},
+    {1, "Invalid reservation", {"Book0000020828", NULL}},
+    {2, "Invalid ID", {"DGarcia429", NULL}},
+    {2, "Flights and Reservations", {"Jéssica Tavares", NULL}},
+    {2, "Flights", {"Jéssica Tavares", "flights", NULL}},
+    {2, "Reservations", {"Jéssica Tavares", "reservations", NULL}},
+    {3, "Invalid ID", {"DGarcia429", NULL}},
+    {3, "Valid ID", {"HTL1001", NULL}},
+    {4, "Invalid ID", {"DGarcia429", NULL}},
+    {4, "Valid ID", {"HTL1003", NULL}},
+    {5, "Invalid Airport", {"Lisbon", "2021/01/01 00:00:00", "2022/12/31 23:59:59", NULL}},
+    {5, "Invalid begin date", {"LIS", "2021/13/01 00:00:00", "2022/12/31 23:59:59", NULL}},
+    {5, "Invalid end date", {"LIS", "2021/01/01 00:00:00", "2022/12/31 23:60:59", NULL}},
+    {5, "Within a short time frame", {"LIS", "2021/01/01 00:00:00", "2021/12/31 23:60:59", NULL}},
+    {5, "Within a moderate time frame", {"LIS", "2020/01/01 00:00:00", "2022/12/31 23:60:59", NULL}},
+    {5, "Within a longer time frame", {"LIS", "2017/01/01 00:00:00", "2022/12/31 23:60:59", NULL}},
+    {6, "Invalid N", {"2023", "-1", NULL}},
+    {6, "Invalid year", {"2024", "10", NULL}},
+    {6, "N = 10", {"2023", "10", NULL}},
+    {6, "N = 100", {"2023", "100", NULL}},
+    {6, "N = 300", {"2023", "300", NULL}},
+    {7, "Invalid N", {"-1", NULL}},
+    {7, "N = 10", {"10", NULL}},
+    {7, "N = 100", {"100", NULL}},
+    {7, "N = 300", {"300", NULL}},
+    {8, "Case 1", {"HTL1001", "2023/05/01", "2023/06/01", NULL}},
+    {8, "Case 2", {"HTL203", "2022/09/07", "2023/12/09", NULL}},
+    {9, "Small user list", {"Mateus Sim", NULL}},
+    {9, "Big user list", {"Alexand", NULL}},
+    {10, "years", {NULL}},
+    {10, "months of 2023", {"2023", NULL}},
+    {10, "days of 06/2023", {"2023", "06", NULL}},
+    {10, "invalid year", {"2024", "03", NULL}},
+    {10, "invalid month", {"2024", "13", NULL}},
+};
+
+/**
+ * @struct bench_result
+ * @brief The measurements of a scenario, latencies in microseconds.
+ */
+struct bench_result {
+    double min; /**< Fastest run. */
+    double median; /**< Median run. */
+    double p99; /**< 99th percentile run. */
+    double mean; /**< Mean of the runs. */
+    double allocations; /**< Allocations per run. */
+    double bytes; /**< Bytes requested per run. */
+};
+
+/**
+ * @brief Comparison function for qsort to sort latencies in ascending order.
+ */
+static int compare_doubles(const void* a, const void* b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Gets a percentile of sorted samples, using the nearest rank.
+ *
+ * @param samples The sorted samples.
+ * @param n The number of samples.
+ * @param percentile The percentile, from 0 to 100.
+ * @return The sample at that percentile.
+ */
+static double percentile(double* samples, int n, double percentile){
+    int rank = (int)(percentile / 100.0 * n + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return samples[rank - 1];
+}
+
+/**
+ * @brief Runs a scenario and measures it.
+ *
+ * @param manager The catalogs.
+ * @param scenario The scenario.
+ * @param iterations Number of measured runs.
+ * @param warmup Number of unmeasured runs.
+ * @param samples Buffer with room for 'iterations' latencies.
+ * @return The measurements.
+ */
+static struct bench_result run_scenario(MANAGER manager, const struct bench_scenario* scenario,
+                                        int iterations, int warmup, double* samples){
+    static queries_func queries[] = {query1, query2, query3, query4, query5,
+                                     query6, query7, query8, query9, query10};
+    queries_func query = queries[scenario->query - 1];
+
+    // Queries get a mutable copy of the arguments, as they do from the interpreter
+    char* args[4] = {NULL};
+    for (int i = 0; i < 4 && scenario->args[i] != NULL; i++) args[i] = strdup(scenario->args[i]);
+
+    for (int i = 0; i < warmup; i++) free_result(query(manager, args));
+
+    double total = 0;
+    long allocations = 0, bytes = 0;
+
+    for (int i = 0; i < iterations; i++){
+        struct timespec start;
+        long count_before, bytes_before, count_after, bytes_after;
+
+        get_alloc_totals(&count_before, &bytes_before);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        RESULT result = query(manager, args);
+        samples[i] = elapsed_since(start) * 1e6;
+        get_alloc_totals(&count_after, &bytes_after);
+
+        allocations += count_after - count_before;
+        bytes += bytes_after - bytes_before;
+        total += samples[i];
+        free_result(result);
+    }
+
+    for (int i = 0; i < 4; i++) free(args[i]);
+
+    qsort(samples, iterations, sizeof(double), compare_doubles);
+
+    struct bench_result result;
+    result.min = samples[0];
+    result.median = percentile(samples, iterations, 50);
+    result.p99 = percentile(samples, iterations, 99);
+    result.mean = total / iterations;
+    result.allocations = (double)allocations / iterations;
+    result.bytes = (double)bytes / iterations;
+
+    return result;
+}
+
+int bench(char* pathD, int iterations, int warmup){
+    USERS_C users_catalog = create_user_c();
+    FLIGHTS_C flights_catalog = create_flight_c();
+    RESERV_C reservations_catalog = create_reservations_c();
+    PASS_C passengers_catalog = create_passengers_c();
+    MANAGER manager_catalog = create_manager_c(users_catalog,flights_catalog,reservations_catalog,passengers_catalog);
+
+    if (set_catalogs(manager_catalog,pathD) == -1){
+        printf("The provided dataset is not valid.\n");
+        free_manager_c(manager_catalog);
+        return -1;
+    }
+
+    FILE* json = fopen(BENCH_JSON_PATH, "w");
+    FILE* csv = fopen(BENCH_CSV_PATH, "w");
+    if (json == NULL || csv == NULL){
+        printf("Could not create the benchmark reports.\n");
+        if (json != NULL) fclose(json);
+        if (csv != NULL) fclose(csv);
+        free_manager_c(manager_catalog);
+        return -1;
+    }
+
+    fprintf(json, "{\n  \"dataset\": \"%s\",\n  \"iterations\": %d,\n  \"warmup\": %d,\n  \"unit\": \"us\",\n  \"scenarios\": [\n",
+            pathD, iterations, warmup);
+    fprintf(csv, "query,scenario,iterations,min_us,median_us,p99_us,mean_us,allocations,bytes\n");
+    printf("%-5s %-30s %12s %12s %12s %12s %10s\n", "Query", "Scenario", "min (us)", "median (us)", "p99 (us)", "mean (us)", "allocs");
+
+    double* samples = malloc(sizeof(double) * iterations);
+    int n = sizeof(scenarios) / sizeof(scenarios[0]);
+
+    for (int i = 0; i < n; i++){
+        const struct bench_scenario* scenario = &scenarios[i];
+        struct bench_result r = run_scenario(manager_catalog, scenario, iterations, warmup, samples);
+
+        printf("%-5d %-30s %12.3f %12.3f %12.3f %12.3f %10.1f\n",
+               scenario->query, scenario->name, r.min, r.median, r.p99, r.mean, r.allocations);
+
+        fprintf(json, "    {\"query\": %d, \"scenario\": \"%s\", \"min\": %.3f, \"median\": %.3f, \"p99\": %.3f, "
+                      "\"mean\": %.3f, \"allocations\": %.1f, \"bytes\": %.1f}%s\n",
+                scenario->query, scenario->name, r.min, r.median, r.p99, r.mean, r.allocations, r.bytes,
+                i + 1 < n ? "," : "");
+        fprintf(csv, "%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f\n",
+                scenario->query, scenario->name, iterations, r.min, r.median, r.p99, r.mean, r.allocations, r.bytes);
+    }
+
+    fprintf(json, "  ]\n}\n");
+
+    free(samples);
+    fclose(json);
+    fclose(csv);
+    free_manager_c(manager_catalog);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file command_mix.c
+ * @brief Command files loaded into memory to be run repeatedly by the benchmarks.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/command_mix.h"
+#include "IO/interpreter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct command_mix
+ * @brief The commands of a command file.
+ */
+struct command_mix {
+    char** lines; /**< The commands, without line breaks. */
+    int* ids; /**< Output identifier of each command, as given by get_query_id. */
+    int n; /**< Number of commands. */
+};
+
+COMMAND_MIX read_command_mix(char* path){
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return NULL;
+
+    COMMAND_MIX mix = malloc(sizeof(struct command_mix));
+    int capacity = 128;
+    mix->lines = malloc(sizeof(char*) * capacity);
+    mix->ids = malloc(sizeof(int) * capacity);
+    mix->n = 0;
+
+    char* line = NULL;
+    size_t size = 0;
+    ssize_t length;
+    while ((length = getline(&line, &size, file)) != -1){
+        if (length > 0 && line[length - 1] == '\n') line[length - 1] = '\0';
+        if (line[0] == '\0') continue;
+
+        if (mix->n == capacity){
+            capacity *= 2;
+            mix->lines = realloc(mix->lines, sizeof(char*) * capacity);
+            mix->ids = realloc(mix->ids, sizeof(int) * capacity);
+        }
+
+        mix->ids[mix->n] = get_query_id(line);
+        mix->lines[mix->n++] = strdup(line);
+    }
+
+    free(line);
+    fclose(file);
+    return mix;
+}
+
+int get_mix_size(COMMAND_MIX mix){
+    return mix->n;
+}
+
+char* get_mix_command(COMMAND_MIX mix, int i){
+    return mix->lines[i];
+}
+
+int get_mix_family(COMMAND_MIX mix, int i){
+    int id = mix->ids[i];
+    return id == 20 ? 10 : id > 10 ? id - 10 : id;
+}
+
+int get_mix_formatted(COMMAND_MIX mix, int i){
+    return mix->ids[i] > 10;
+}
+
+void free_command_mix(COMMAND_MIX mix){
+    for (int i = 0; i < mix->n; i++) free(mix->lines[i]);
+    free(mix->lines);
+    free(mix->ids);
+    free(mix);
+}
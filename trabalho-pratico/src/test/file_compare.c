@@ -24,74 +24,305 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-void compare_files(char* pathO, int n) {
-    int i = 1, errors = 0;
-    FILE *incongruities_file = fopen("Resultados/incongruities.txt", "w");
+/**
+ * @struct mapped_file
+ * @brief A file mapped into memory and the offsets of its lines.
+ */
+struct mapped_file {
+    char* data; /**< Contents, NULL when the file is empty or missing. */
+    size_t size; /**< Size in bytes. */
+    size_t* lines; /**< Offset of the start of each line, plus one past the last. */
+    size_t n_lines; /**< Number of lines. */
+};
+
+/**
+ * @struct comparison
+ * @brief A pair of files to compare and its report.
+ */
+struct comparison {
+    int command; /**< Command number. */
+    char* expected; /**< Path of the expected file. */
+    char* obtained; /**< Path of the obtained file. */
+    char* report; /**< Discrepancies found, NULL when the files are equal. */
+    size_t report_size; /**< Size of the report. */
+    int differences; /**< Number of lines that differ. */
+};
+
+/**
+ * @struct compare_queue
+ * @brief The comparisons shared by the threads.
+ */
+struct compare_queue {
+    struct comparison* comparisons; /**< The comparisons. */
+    int n; /**< Number of comparisons. */
+    int next; /**< Next comparison to be taken. */
+};
+
+/**
+ * @brief Map a file into memory and find its lines.
+ *
+ * @param path Path of the file.
+ * @param file Where the mapping is stored.
+ * @return 0 on success, -1 if the file can't be opened.
+ */
+static int map_file(const char* path, struct mapped_file* file){
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1){
+        close(fd);
+        return -1;
+    }
+
+    file->size = st.st_size;
+    if (file->size > 0){
+        file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (file->data == MAP_FAILED){
+            close(fd);
+            file->data = NULL;
+            return -1;
+        }
+        madvise(file->data, file->size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    size_t capacity = 64;
+    file->lines = malloc(sizeof(size_t) * capacity);
+    file->lines[0] = 0;
+
+    size_t pos = 0;
+    while (pos < file->size){
+        char* newline = memchr(file->data + pos, '\n', file->size - pos);
+        pos = newline == NULL ? file->size : (size_t)(newline - file->data) + 1;
+
+        if (file->n_lines + 2 > capacity){
+            capacity *= 2;
+            file->lines = realloc(file->lines, sizeof(size_t) * capacity);
+        }
+        file->lines[++file->n_lines] = pos;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Unmap a file mapped with map_file.
+ */
+static void unmap_file(struct mapped_file* file){
+    if (file->data != NULL) munmap(file->data, file->size);
+    free(file->lines);
+}
+
+/**
+ * @brief Get a line of a mapped file, without its line break.
+ *
+ * @param file The mapped file.
+ * @param i The line index, from 0.
+ * @param length Where the length of the line is stored.
+ * @return The start of the line, or NULL when the file has fewer lines.
+ */
+static const char* get_line(struct mapped_file* file, size_t i, int* length){
+    if (i >= file->n_lines){
+        *length = 0;
+        return NULL;
+    }
+
+    size_t start = file->lines[i];
+    size_t end = file->lines[i + 1];
+    if (end > start && file->data[end - 1] == '\n') end--;
+
+    *length = end - start;
+    return file->data + start;
+}
+
+/**
+ * @brief Whether a line differs between two mapped files.
+ */
+static int line_differs(struct mapped_file* expected, struct mapped_file* obtained, size_t i){
+    int len1, len2;
+    const char* line1 = get_line(expected, i, &len1);
+    const char* line2 = get_line(obtained, i, &len2);
+
+    if (line1 == NULL || line2 == NULL) return line1 != line2;
+    return len1 != len2 || memcmp(line1, line2, len1) != 0;
+}
+
+/**
+ * @brief Compare a pair of files and write every discrepancy, with its context, to the report.
+ *
+ * @param comparison The pair of files.
+ */
+static void compare_pair(struct comparison* comparison){
+    struct mapped_file expected, obtained;
+    FILE* report = open_memstream(&comparison->report, &comparison->report_size);
+
+    if (map_file(comparison->expected, &expected) == -1 || map_file(comparison->obtained, &obtained) == -1){
+        fprintf(report, "command%d_output.txt: could not open %s\n\n", comparison->command,
+                expected.lines == NULL ? comparison->expected : comparison->obtained);
+        comparison->differences = 1;
+        if (expected.lines != NULL) unmap_file(&expected);
+        fclose(report);
+        return;
+    }
+
+    size_t n = expected.n_lines > obtained.n_lines ? expected.n_lines : obtained.n_lines;
+    size_t i = 0;
+
+    while (i < n){
+        if (!line_differs(&expected, &obtained, i)){
+            i++;
+            continue;
+        }
+
+        // A hunk runs until COMPARE_CONTEXT lines after the last discrepancy close enough to it
+        size_t first = i >= COMPARE_CONTEXT ? i - COMPARE_CONTEXT : 0;
+        size_t last = i;
+        for (size_t j = i + 1; j < n && j <= last + 2 * COMPARE_CONTEXT; j++){
+            if (line_differs(&expected, &obtained, j)) last = j;
+        }
+        size_t end = last + COMPARE_CONTEXT < n ? last + COMPARE_CONTEXT : n - 1;
+
+        fprintf(report, "Discrepancies found at lines %zu-%zu of the command%d_output.txt file:\n",
+                first + 1, end + 1, comparison->command);
+
+        for (size_t j = first; j <= end; j++){
+            int len1, len2;
+            const char* line1 = get_line(&expected, j, &len1);
+            const char* line2 = get_line(&obtained, j, &len2);
+
+            if (!line_differs(&expected, &obtained, j)){
+                fprintf(report, "  %5zu  %.*s\n", j + 1, len1, line1);
+                continue;
+            }
+
+            comparison->differences++;
+            if (line1 != NULL) fprintf(report, "- %5zu  %.*s\n", j + 1, len1, line1);
+            if (line2 != NULL) fprintf(report, "+ %5zu  %.*s\n", j + 1, len2, line2);
+        }
+        fprintf(report, "\n");
+
+        i = end + 1;
+    }
+
+    unmap_file(&expected);
+    unmap_file(&obtained);
+    fclose(report);
+
+    if (comparison->differences == 0){
+        free(comparison->report);
+        comparison->report = NULL;
+    }
+}
+
+/**
+ * @brief Thread that takes comparisons from the queue until it is empty.
+ */
+static void* compare_worker(void* arg){
+    struct compare_queue* queue = arg;
+    int i;
+
+    while ((i = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED)) < queue->n){
+        compare_pair(&queue->comparisons[i]);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Find the highest command number of the expected output files.
+ *
+ * @param pathO The folder with the expected output files.
+ * @return The highest command number, 0 when there are none, -1 if the folder can't be read.
+ */
+static int count_expected(char* pathO){
+    DIR* dir = opendir(pathO);
+    if (dir == NULL) return -1;
+
+    int n = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL){
+        int command, length = 0;
+        if (sscanf(entry->d_name, "command%d_output.txt%n", &command, &length) == 1 &&
+            entry->d_name[length] == '\0' && command > n){
+            n = command;
+        }
+    }
+
+    closedir(dir);
+    return n;
+}
+
+int compare_files(char* pathO) {
+    int n = count_expected(pathO);
+    if (n == -1){
+        perror("Error opening the expected outputs folder");
+        return -1;
+    }
+
+    FILE *incongruities_file = fopen(INCONGRUITIES_PATH, "w");
 
     if (incongruities_file == NULL) {
         perror("Error opening incongruities.txt for writing");
-        return;
+        return -1;
     }
 
     printf("Running tests...\n");
 
-    while (i != n) {
-        char pathV[256];
-        sprintf(pathV, "Resultados/command%d_output.txt", i);
+    struct compare_queue queue = {calloc(n > 0 ? n : 1, sizeof(struct comparison)), n, 0};
 
-        char command[256];
-        sprintf(command, "/command%d_output.txt", i);
-        char *pathE = concat(pathO, command);
+    for (int i = 0; i < n; i++){
+        char command[64];
+        struct comparison* comparison = &queue.comparisons[i];
 
-        FILE *file1 = fopen(pathE, "r");
-        FILE *file2 = fopen(pathV, "r");
+        comparison->command = i + 1;
+        sprintf(command, "/command%d_output.txt", i + 1);
+        comparison->expected = concat(pathO, command);
+        comparison->obtained = concat("Resultados", command);
+    }
 
-        if (file1 == NULL || file2 == NULL) {
-            perror("Error opening files for comparison");
-            fclose(incongruities_file);
-            return;
-        }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_threads = cpus < 1 ? 1 : cpus > COMPARE_MAX_THREADS ? COMPARE_MAX_THREADS : cpus;
+    if (n_threads > n) n_threads = n > 0 ? n : 1;
 
-        char *line1 = NULL;
-        char *line2 = NULL;
-        size_t len1 = 0;
-        size_t len2 = 0;
-        ssize_t read1, read2;
-        int line_number = 1;
-
-        while (1) {
-            read1 = getline(&line1, &len1, file1);
-            read2 = getline(&line2, &len2, file2);
-
-            // Compare lines
-            if (read1 != read2 || (read1 != -1 && read2 != -1 && strcmp(line1, line2) != 0)) {
-                fprintf(incongruities_file, "Discrepancy found at line %d of the command%d_output.txt file:\n",line_number,i);
-                fprintf(incongruities_file, "Expected: %s", read1 != -1 ? line1 : "");
-                fprintf(incongruities_file, "Obtained: %s\n", read2 != -1 ? line2 : "\n");
-                errors++;
-                break;
-            }
+    pthread_t threads[COMPARE_MAX_THREADS];
+    int started = 0;
+    for (int i = 1; i < n_threads; i++){
+        if (pthread_create(&threads[started], NULL, compare_worker, &queue) == 0) started++;
+    }
+    compare_worker(&queue);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
 
-            if (read1 == -1 && read2 == -1) {
-                break;
-            }
+    int errors = 0, lines = 0;
+    for (int i = 0; i < n; i++){
+        struct comparison* comparison = &queue.comparisons[i];
 
-            line_number++;
+        if (comparison->report != NULL){
+            fwrite(comparison->report, 1, comparison->report_size, incongruities_file);
+            errors++;
+            lines += comparison->differences;
         }
 
-        free(line1);
-        free(line2);
-        fclose(file1);
-        fclose(file2);
-        free(pathE);
-        i++;
+        free(comparison->report);
+        free(comparison->expected);
+        free(comparison->obtained);
     }
+    free(queue.comparisons);
 
     fclose(incongruities_file);
 
-    printf("Executed all tests successfully!\n");
+    printf("Compared %d output files\n", n);
     printf("%d anomalies found!\n", errors);
-    printf("Verify anomalies in the incongruities.txt file in the Resultados folder\n");
+    if (errors > 0) printf("%d lines differ, verify them in the incongruities.txt file in the Resultados folder\n", lines);
 
+    return errors;
 }
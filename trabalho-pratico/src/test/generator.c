@@ -0,0 +1,496 @@
+/**
+ * @file generator.c
+ * @brief Synthetic dataset generator for load and query benchmarks.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/generator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Maximum size of a generated field.
+ */
+#define FIELD_SIZE 128
+
+/**
+ * @brief Maximum number of fields of a row.
+ */
+#define MAX_FIELDS 14
+
+/**
+ * @brief 2021/01/01 00:00:00 UTC, start of the generated flights and reservations.
+ */
+#define EPOCH_2021 1609459200
+
+/**
+ * @brief Seconds in three years, the span of the generated flights and reservations.
+ */
+#define THREE_YEARS (3 * 365 * 24 * 3600)
+
+static const char* first_names[] = {
+    "Jéssica", "Mateus", "Alexandre", "Alexandra", "Ana", "João", "Maria", "Luís", "Mariana", "Hugo",
+    "Beatriz", "Tiago", "Inês", "Rafael", "Sofia", "Gonçalo", "Leonor", "Diogo", "Matilde", "Rodrigo",
+    "Carolina", "Martim", "Francisca", "Tomás", "Alícia", "Duarte", "Lara", "Simão", "Benedita", "Vicente"
+};
+
+static const char* surnames[] = {
+    "Tavares", "Sim", "Silva", "Santos", "Ferreira", "Pereira", "Oliveira", "Costa", "Rodrigues", "Martins",
+    "Jesus", "Sousa", "Fernandes", "Gonçalves", "Gomes", "Lopes", "Marques", "Alves", "Almeida", "Ribeiro",
+    "Pinto", "Carvalho", "Teixeira", "Moreira", "Correia", "Mendes", "Nunes", "Soares", "Vieira", "Sá-Mendes"
+};
+
+static const char* countries[] = {"PT", "ES", "FR", "DE", "IT", "GB", "BR", "US"};
+static const char* pay_methods[] = {"debit_card", "credit_card", "cash"};
+static const char* statuses[] = {"active", "Active", "ACTIVE", "inactive", "Inactive"};
+static const char* airlines[] = {"TAP Air Portugal", "Ryanair", "easyJet", "Jet2.com", "Lufthansa", "Iberia"};
+static const char* plane_models[] = {"Airbus A320", "Airbus A321", "Boeing 737", "Boeing 787", "Embraer E195"};
+static const char* airports[] = {"LIS", "OPO", "FAO", "MAD", "BCN", "CDG", "FRA", "MAN", "PRG", "AMS",
+                                 "lis", "Opo", "JFK", "GRU", "FCO", "LHR"};
+static const char* breakfasts[] = {"True", "False", "true", "false", "t", "f", "1", "0", ""};
+static const char* room_details[] = {"Basic", "Standard", "Deluxe", "Suite"};
+
+/**
+ * @brief Number of elements of a static array.
+ */
+#define LENGTH(array) ((int)(sizeof(array) / sizeof(array[0])))
+
+/**
+ * @brief Advances a splitmix64 generator.
+ *
+ * @param state The generator state.
+ * @return The next pseudo-random number.
+ */
+static uint64_t next_random(uint64_t* state){
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Gets a pseudo-random integer in an inclusive range.
+ */
+static int uniform(uint64_t* state, int low, int high){
+    return low + (int)(next_random(state) % (uint64_t)(high - low + 1));
+}
+
+/**
+ * @brief Decides whether the next row is invalid.
+ *
+ * @param state The generator state.
+ * @param invalid The percentage of invalid rows.
+ * @return 1 if the row must be invalid, 0 otherwise.
+ */
+static int chance(uint64_t* state, double invalid){
+    return (next_random(state) % 1000000) < (uint64_t)(invalid * 10000);
+}
+
+/**
+ * @brief Writes the id of a user, which only depends on the seed and on the user index.
+ *
+ * Passengers and reservations pick users by index, so the users don't need to be kept in memory.
+ *
+ * @param buffer Where the id is written.
+ * @param size The size of the buffer.
+ * @param seed The seed.
+ * @param index The user index.
+ * @param name Where the index of the first name and of the surname are stored, or NULL.
+ */
+static void user_id(char* buffer, size_t size, uint64_t seed, long index, int* name){
+    uint64_t state = seed ^ ((uint64_t)index * 0xD1B54A32D192ED03ULL);
+    int first = uniform(&state, 0, LENGTH(first_names) - 1);
+    int last = uniform(&state, 0, LENGTH(surnames) - 1);
+
+    snprintf(buffer, size, "%s%s%ld", first_names[first], surnames[last], index);
+    if (name != NULL){
+        name[0] = first;
+        name[1] = last;
+    }
+}
+
+/**
+ * @brief Formats a timestamp as YYYY/MM/DD hh:mm:ss.
+ */
+static void format_date_time(char* buffer, time_t t){
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    strftime(buffer, FIELD_SIZE, "%Y/%m/%d %H:%M:%S", &tm);
+}
+
+/**
+ * @brief Writes a row of fields separated by ';'.
+ */
+static void write_row(FILE* file, char fields[][FIELD_SIZE], int n){
+    for (int i = 0; i < n; i++){
+        fputs(fields[i], file);
+        fputc(i + 1 < n ? ';' : '\n', file);
+    }
+}
+
+/**
+ * @brief Writes users.csv.
+ *
+ * @return The number of invalid rows.
+ */
+static long generate_users(FILE* file, long n, uint64_t seed, uint64_t* state, double invalid){
+    char fields[MAX_FIELDS][FIELD_SIZE];
+    long n_invalid = 0;
+
+    fprintf(file, "id;name;email;phone_number;birth_date;sex;passport;country_code;address;account_creation;pay_method;account_status\n");
+
+    for (long i = 0; i < n; i++){
+        int name[2];
+        user_id(fields[0], FIELD_SIZE, seed, i, name);
+        snprintf(fields[1], FIELD_SIZE, "%s %s", first_names[name[0]], surnames[name[1]]);
+        snprintf(fields[2], FIELD_SIZE, "user%ld@li3.pt", i);
+        snprintf(fields[3], FIELD_SIZE, "(351) %03d %03d %03d", uniform(state, 100, 999), uniform(state, 0, 999), uniform(state, 0, 999));
+        snprintf(fields[4], FIELD_SIZE, "%04d/%02d/%02d", uniform(state, 1940, 2005), uniform(state, 1, 12), uniform(state, 1, 28));
+        snprintf(fields[5], FIELD_SIZE, "%s", uniform(state, 0, 1) ? "M" : "F");
+        snprintf(fields[6], FIELD_SIZE, "PT%06d", uniform(state, 0, 999999));
+        snprintf(fields[7], FIELD_SIZE, "%s", countries[uniform(state, 0, LENGTH(countries) - 1)]);
+        snprintf(fields[8], FIELD_SIZE, "Rua %d, Lisboa", uniform(state, 1, 999));
+        format_date_time(fields[9], EPOCH_2021 - (time_t)uniform(state, 0, 10 * 365) * 86400 + uniform(state, 0, 86399));
+        snprintf(fields[10], FIELD_SIZE, "%s", pay_methods[uniform(state, 0, LENGTH(pay_methods) - 1)]);
+        snprintf(fields[11], FIELD_SIZE, "%s", statuses[uniform(state, 0, LENGTH(statuses) - 1)]);
+
+        if (chance(state, invalid)){
+            n_invalid++;
+            switch (uniform(state, 0, 5)){
+                case 0: fields[0][0] = '\0'; break;
+                case 1: snprintf(fields[2], FIELD_SIZE, "user%ld.li3.pt", i); break;
+                case 2: memcpy(fields[4] + 5, "13", 2); break;
+                case 3: snprintf(fields[7], FIELD_SIZE, "PRT"); break;
+                case 4: snprintf(fields[11], FIELD_SIZE, "blocked"); break;
+                default: snprintf(fields[4], FIELD_SIZE, "2022/01/01"); break; // born after the account creation
+            }
+        }
+
+        write_row(file, fields, 12);
+    }
+
+    return n_invalid;
+}
+
+/**
+ * @brief Writes flights.csv and passengers.csv.
+ *
+ * @return The number of invalid flights.
+ */
+static long generate_flights(FILE* flights, FILE* passengers, long n, long n_users,
+                             uint64_t seed, uint64_t* state, double invalid, long* n_passenger_rows){
+    char fields[MAX_FIELDS][FIELD_SIZE];
+    char user[FIELD_SIZE];
+    long n_invalid = 0;
+    *n_passenger_rows = 0;
+
+    fprintf(flights, "id;airline;plane_model;total_seats;origin;destination;schedule_departure_date;schedule_arrival_date;"
+                     "real_departure_date;real_arrival_date;pilot;copilot;notes\n");
+    fprintf(passengers, "flight_id;user_id\n");
+
+    for (long i = 0; i < n; i++){
+        int seats = uniform(state, 100, 300);
+        int origin = uniform(state, 0, LENGTH(airports) - 1);
+        int destination = (origin + uniform(state, 1, LENGTH(airports) - 1)) % LENGTH(airports);
+        time_t departure = EPOCH_2021 + (time_t)(next_random(state) % THREE_YEARS);
+        time_t duration = uniform(state, 3600, 12 * 3600);
+        time_t delay = uniform(state, 0, 3 * 3600);
+
+        snprintf(fields[0], FIELD_SIZE, "%010ld", i + 1);
+        snprintf(fields[1], FIELD_SIZE, "%s", airlines[uniform(state, 0, LENGTH(airlines) - 1)]);
+        snprintf(fields[2], FIELD_SIZE, "%s", plane_models[uniform(state, 0, LENGTH(plane_models) - 1)]);
+        snprintf(fields[3], FIELD_SIZE, "%d", seats);
+        snprintf(fields[4], FIELD_SIZE, "%s", airports[origin]);
+        snprintf(fields[5], FIELD_SIZE, "%s", airports[destination]);
+        format_date_time(fields[6], departure);
+        format_date_time(fields[7], departure + duration);
+        format_date_time(fields[8], departure + delay);
+        format_date_time(fields[9], departure + delay + duration);
+        snprintf(fields[10], FIELD_SIZE, "%s %s", first_names[uniform(state, 0, LENGTH(first_names) - 1)],
+                 surnames[uniform(state, 0, LENGTH(surnames) - 1)]);
+        snprintf(fields[11], FIELD_SIZE, "%s %s", first_names[uniform(state, 0, LENGTH(first_names) - 1)],
+                 surnames[uniform(state, 0, LENGTH(surnames) - 1)]);
+        fields[12][0] = '\0';
+
+        int n_passengers = uniform(state, 20, seats < 140 ? seats : 140);
+
+        if (chance(state, invalid)){
+            n_invalid++;
+            switch (uniform(state, 0, 4)){
+                case 0: snprintf(fields[4], FIELD_SIZE, "LISB"); break;
+                case 1: snprintf(fields[3], FIELD_SIZE, "2x0"); break;
+                case 2: format_date_time(fields[7], departure - duration); break;
+                case 3: memcpy(fields[8] + 11, "25", 2); break;
+                default: n_passengers = seats + uniform(state, 10, 20); break; // overbooked
+            }
+        }
+
+        write_row(flights, fields, 13);
+
+        for (int j = 0; j < n_passengers; j++){
+            user_id(user, FIELD_SIZE, seed, (long)(next_random(state) % (uint64_t)n_users), NULL);
+            fprintf(passengers, "%s;%s\n", fields[0], user);
+        }
+        *n_passenger_rows += n_passengers;
+    }
+
+    return n_invalid;
+}
+
+/**
+ * @brief Writes reservations.csv.
+ *
+ * @return The number of invalid rows.
+ */
+static long generate_reservations(FILE* file, long n, long n_users, long n_hotels,
+                                  uint64_t seed, uint64_t* state, double invalid){
+    char fields[MAX_FIELDS][FIELD_SIZE];
+    long n_invalid = 0;
+
+    fprintf(file, "id;user_id;hotel_id;hotel_name;hotel_stars;city_tax;address;begin_date;end_date;"
+                  "price_per_night;includes_breakfast;room_details;rating;comment\n");
+
+    for (long i = 0; i < n; i++){
+        long hotel = (long)(next_random(state) % (uint64_t)n_hotels);
+        // Stars and tax are a property of the hotel
+        uint64_t hotel_state = seed ^ ((uint64_t)hotel * 0x9E3779B97F4A7C15ULL);
+        int stars = uniform(&hotel_state, 1, 5);
+        int tax = uniform(&hotel_state, 0, 20);
+
+        // The number of nights is the difference of the days, so stays don't cross months
+        time_t begin = EPOCH_2021 + (time_t)(next_random(state) % THREE_YEARS);
+        struct tm tm;
+        gmtime_r(&begin, &tm);
+        int day = tm.tm_mday > 27 ? 27 : tm.tm_mday;
+        int nights = uniform(state, 1, 28 - day);
+        int rating = uniform(state, 1, 5);
+
+        snprintf(fields[0], FIELD_SIZE, "Book%010ld", i + 1);
+        user_id(fields[1], FIELD_SIZE, seed, (long)(next_random(state) % (uint64_t)n_users), NULL);
+        snprintf(fields[2], FIELD_SIZE, "HTL%ld", 1000 + hotel);
+        snprintf(fields[3], FIELD_SIZE, "Hotel %ld", 1000 + hotel);
+        snprintf(fields[4], FIELD_SIZE, "%d", stars);
+        snprintf(fields[5], FIELD_SIZE, "%d", tax);
+        snprintf(fields[6], FIELD_SIZE, "Rua %ld, Porto", 1000 + hotel);
+        snprintf(fields[7], FIELD_SIZE, "%04d/%02d/%02d", tm.tm_year + 1900, tm.tm_mon + 1, day);
+        snprintf(fields[8], FIELD_SIZE, "%04d/%02d/%02d", tm.tm_year + 1900, tm.tm_mon + 1, day + nights);
+        snprintf(fields[9], FIELD_SIZE, "%d", uniform(state, 40, 300));
+        snprintf(fields[10], FIELD_SIZE, "%s", breakfasts[uniform(state, 0, LENGTH(breakfasts) - 1)]);
+        snprintf(fields[11], FIELD_SIZE, "%s", room_details[uniform(state, 0, LENGTH(room_details) - 1)]);
+        snprintf(fields[12], FIELD_SIZE, "%d", rating);
+        fields[13][0] = '\0';
+
+        if (chance(state, invalid)){
+            n_invalid++;
+            switch (uniform(state, 0, 5)){
+                case 0: snprintf(fields[4], FIELD_SIZE, "6"); break;
+                case 1: snprintf(fields[5], FIELD_SIZE, "-%d", tax + 1); break;
+                case 2: snprintf(fields[8], FIELD_SIZE, "%04d/%02d/%02d", tm.tm_year + 1899, tm.tm_mon + 1, day); break;
+                case 3: snprintf(fields[10], FIELD_SIZE, "maybe"); break;
+                case 4: snprintf(fields[12], FIELD_SIZE, "7"); break;
+                default: fields[2][0] = '\0'; break;
+            }
+        }
+
+        write_row(file, fields, 14);
+    }
+
+    return n_invalid;
+}
+
+/**
+ * @brief Gets the number of entities of a kind at a scale, at least one.
+ */
+static long scaled(long n, double scale){
+    long result = (long)(n * scale + 0.5);
+    return result < 1 ? 1 : result;
+}
+
+/**
+ * @brief Creates a folder and any of its parents that don't exist, like mkdir -p.
+ *
+ * @return 0 on success, -1 if a folder could not be created.
+ */
+static int make_folders(const char* path){
+    char folder[4096];
+    snprintf(folder, sizeof(folder), "%s", path);
+
+    for (char* p = folder + 1; ; p++){
+        if (*p != '/' && *p != '\0') continue;
+
+        char end = *p;
+        *p = '\0';
+        if (mkdir(folder, 0755) == -1 && errno != EEXIST) return -1;
+        *p = end;
+        if (end == '\0') return 0;
+    }
+}
+
+/**
+ * @brief Opens a dataset file for writing, with a large buffer.
+ */
+static FILE* open_dataset_file(char* path, const char* name, char** buffer){
+    char file_path[4096];
+    snprintf(file_path, sizeof(file_path), "%s/%s", path, name);
+
+    FILE* file = fopen(file_path, "w");
+    *buffer = NULL;
+    if (file != NULL){
+        *buffer = malloc(1 << 20);
+        setvbuf(file, *buffer, _IOFBF, 1 << 20);
+    }
+
+    return file;
+}
+
+int generate_dataset(char* path, double scale, uint64_t seed, double invalid){
+    static const char* names[] = {"users.csv", "flights.csv", "passengers.csv", "reservations.csv"};
+    FILE* files[4];
+    char* buffers[4];
+    int failed = make_folders(path) == -1;
+
+    for (int i = 0; i < 4; i++){
+        files[i] = NULL;
+        buffers[i] = NULL;
+        if (!failed) files[i] = open_dataset_file(path, names[i], &buffers[i]);
+        if (files[i] == NULL) failed = 1;
+    }
+
+    if (!failed){
+        long n_users = scaled(GENERATOR_USERS, scale);
+        long n_flights = scaled(GENERATOR_FLIGHTS, scale);
+        long n_reservations = scaled(GENERATOR_RESERVATIONS, scale);
+        long n_hotels = scaled(GENERATOR_HOTELS, scale);
+
+        // Each file has its own stream, so its rows don't depend on the size of the others
+        uint64_t states[3] = {seed * 3 + 1, seed * 3 + 2, seed * 3 + 3};
+
+        long invalid_users = generate_users(files[0], n_users, seed, &states[0], invalid);
+        long n_passengers;
+        long invalid_flights = generate_flights(files[1], files[2], n_flights, n_users, seed, &states[1], invalid, &n_passengers);
+        long invalid_reservations = generate_reservations(files[3], n_reservations, n_users, n_hotels, seed, &states[2], invalid);
+
+        printf("users.csv: %ld rows, %ld invalid\n", n_users, invalid_users);
+        printf("flights.csv: %ld rows, %ld invalid\n", n_flights, invalid_flights);
+        printf("passengers.csv: %ld rows, rejected with their invalid flights and users\n", n_passengers);
+        printf("reservations.csv: %ld rows, %ld invalid\n", n_reservations, invalid_reservations);
+    }
+
+    for (int i = 0; i < 4; i++){
+        if (files[i] != NULL && fclose(files[i]) != 0) failed = 1;
+        free(buffers[i]);
+    }
+
+    return failed ? -1 : 0;
+}
+
+/**
+ * @brief Writes a random date between 2021 and 2023, with or without the time.
+ */
+static void random_date(char* buffer, uint64_t* state, int with_time){
+    time_t t = EPOCH_2021 + (time_t)(next_random(state) % THREE_YEARS);
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    strftime(buffer, FIELD_SIZE, with_time ? "\"%Y/%m/%d %H:%M:%S\"" : "%Y/%m/%d", &tm);
+}
+
+int generate_commands(char* path, double scale, uint64_t seed, long n){
+    static const int mix[] = GENERATOR_MIX;
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return -1;
+
+    long n_users = scaled(GENERATOR_USERS, scale);
+    long n_flights = scaled(GENERATOR_FLIGHTS, scale);
+    long n_reservations = scaled(GENERATOR_RESERVATIONS, scale);
+    long n_hotels = scaled(GENERATOR_HOTELS, scale);
+
+    int total = 0;
+    for (int i = 0; i < LENGTH(mix); i++) total += mix[i];
+
+    uint64_t state = seed * 3 + 4;
+    char id[FIELD_SIZE], begin[FIELD_SIZE], end[FIELD_SIZE];
+
+    for (long i = 0; i < n; i++){
+        int query = 0;
+        for (int pick = uniform(&state, 0, total - 1); pick >= mix[query]; query++) pick -= mix[query];
+        query++;
+
+        fprintf(file, "%d%s", query, uniform(&state, 0, 1) ? "F" : "");
+
+        switch (query){
+            case 1:
+                switch (uniform(&state, 0, 2)){
+                    case 0: user_id(id, FIELD_SIZE, seed, uniform(&state, 0, n_users - 1), NULL); break;
+                    case 1: snprintf(id, FIELD_SIZE, "%010d", uniform(&state, 1, n_flights)); break;
+                    default: snprintf(id, FIELD_SIZE, "Book%010d", uniform(&state, 1, n_reservations)); break;
+                }
+                fprintf(file, " %s", id);
+                break;
+            case 2:
+                user_id(id, FIELD_SIZE, seed, uniform(&state, 0, n_users - 1), NULL);
+                fprintf(file, " %s", id);
+                switch (uniform(&state, 0, 2)){
+                    case 0: fprintf(file, " flights"); break;
+                    case 1: fprintf(file, " reservations"); break;
+                    default: break;
+                }
+                break;
+            case 3:
+            case 4:
+                fprintf(file, " HTL%d", 1000 + uniform(&state, 0, n_hotels - 1));
+                break;
+            case 5:
+                random_date(begin, &state, 1);
+                random_date(end, &state, 1);
+                if (strcmp(begin, end) > 0) fprintf(file, " %s %s %s", airports[uniform(&state, 0, LENGTH(airports) - 1)], end, begin);
+                else fprintf(file, " %s %s %s", airports[uniform(&state, 0, LENGTH(airports) - 1)], begin, end);
+                break;
+            case 6:
+                fprintf(file, " %d %d", uniform(&state, 2021, 2023), uniform(&state, 1, 50));
+                break;
+            case 7:
+                fprintf(file, " %d", uniform(&state, 1, 50));
+                break;
+            case 8:
+                random_date(begin, &state, 0);
+                random_date(end, &state, 0);
+                fprintf(file, " HTL%d %s %s", 1000 + uniform(&state, 0, n_hotels - 1),
+                        strcmp(begin, end) > 0 ? end : begin, strcmp(begin, end) > 0 ? begin : end);
+                break;
+            case 9:
+                fprintf(file, " %s", first_names[uniform(&state, 0, LENGTH(first_names) - 1)]);
+                break;
+            default:
+                switch (uniform(&state, 0, 2)){
+                    case 0: fprintf(file, " %d", uniform(&state, 2021, 2023)); break;
+                    case 1: fprintf(file, " %d %02d", uniform(&state, 2021, 2023), uniform(&state, 1, 12)); break;
+                    default: break;
+                }
+                break;
+        }
+
+        fputc('\n', file);
+    }
+
+    return fclose(file) == 0 ? 0 : -1;
+}
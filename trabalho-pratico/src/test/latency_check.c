@@ -0,0 +1,159 @@
+/**
+ * @file latency_check.c
+ * @brief Comparison of the latency of each query family with a stored baseline.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/latency_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Number of query families.
+ */
+#define N_FAMILIES 10
+
+/**
+ * @struct family_latency
+ * @brief The time spent in a query family.
+ */
+struct family_latency {
+    int commands; /**< Number of commands of the family. */
+    double seconds; /**< Total time of those commands. */
+};
+
+/**
+ * @brief Sum the time of the commands in the analysis file by query family.
+ *
+ * @param path Path to the analysis file.
+ * @param families Where the times are stored, one per family.
+ * @return 0 on success, -1 if the file can't be read.
+ */
+static int read_analysis(char* path, struct family_latency* families){
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    memset(families, 0, sizeof(struct family_latency) * N_FAMILIES);
+
+    char* line = NULL;
+    size_t size = 0;
+    int family = 0;
+    double seconds;
+
+    while (getline(&line, &size, file) != -1){
+        if (strncmp(line, "Query: ", 7) == 0){
+            family = atoi(line + 7);
+        }
+        else if (family >= 1 && family <= N_FAMILIES && sscanf(line, "Elapsed time: %lf", &seconds) == 1){
+            families[family - 1].commands++;
+            families[family - 1].seconds += seconds;
+            family = 0;
+        }
+    }
+
+    free(line);
+    fclose(file);
+    return 0;
+}
+
+/**
+ * @brief Read a baseline written by write_baseline.
+ *
+ * @param path Path to the baseline.
+ * @param families Where the times are stored, one per family.
+ * @return 0 on success, -1 if the file can't be read.
+ */
+static int read_baseline(char* path, struct family_latency* families){
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    memset(families, 0, sizeof(struct family_latency) * N_FAMILIES);
+
+    int family, commands;
+    double seconds;
+    while (fscanf(file, "%d %d %lf", &family, &commands, &seconds) == 3){
+        if (family < 1 || family > N_FAMILIES) continue;
+        families[family - 1].commands = commands;
+        families[family - 1].seconds = seconds;
+    }
+
+    fclose(file);
+    return 0;
+}
+
+/**
+ * @brief Write the time of each family as a baseline, one "family commands seconds" line each.
+ *
+ * @param path Path to the baseline.
+ * @param families The times, one per family.
+ * @return 0 on success, -1 if the file can't be written.
+ */
+static int write_baseline(char* path, struct family_latency* families){
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return -1;
+
+    for (int i = 0; i < N_FAMILIES; i++){
+        if (families[i].commands > 0) fprintf(file, "%d %d %.6f\n", i + 1, families[i].commands, families[i].seconds);
+    }
+
+    fclose(file);
+    return 0;
+}
+
+int check_latency(char* analysis_path, char* baseline_path){
+    struct family_latency current[N_FAMILIES], baseline[N_FAMILIES];
+
+    if (read_analysis(analysis_path, current) == -1){
+        perror("Error reading the query times");
+        return -1;
+    }
+
+    if (read_baseline(baseline_path, baseline) == -1){
+        if (write_baseline(baseline_path, current) == -1){
+            perror("Error writing the latency baseline");
+            return -1;
+        }
+        printf("Latency baseline recorded in %s\n", baseline_path);
+        return 0;
+    }
+
+    int regressions = 0;
+    printf("%-6s %8s %14s %14s %8s\n", "Query", "Commands", "Baseline (s)", "Current (s)", "Ratio");
+
+    for (int i = 0; i < N_FAMILIES; i++){
+        if (current[i].commands == 0) continue;
+
+        if (current[i].commands != baseline[i].commands){
+            printf("%-6d %8d %14s %14.6f %8s\n", i + 1, current[i].commands, "-", current[i].seconds, "-");
+            continue;
+        }
+
+        double ratio = baseline[i].seconds > 0 ? current[i].seconds / baseline[i].seconds : 1;
+        int regressed = ratio > LATENCY_THRESHOLD && current[i].seconds - baseline[i].seconds > LATENCY_MIN_DELTA;
+        regressions += regressed;
+
+        printf("%-6d %8d %14.6f %14.6f %8.2f%s\n", i + 1, current[i].commands, baseline[i].seconds,
+               current[i].seconds, ratio, regressed ? "  REGRESSION" : "");
+    }
+
+    printf("%d query families regressed beyond %.0f%% of the baseline\n", regressions, (LATENCY_THRESHOLD - 1) * 100);
+
+    return regressions;
+}
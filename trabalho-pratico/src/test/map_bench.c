@@ -0,0 +1,160 @@
+/**
+ * @file map_bench.c
+ * @brief Benchmark of the string map of the catalogs against a GHashTable.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/map_bench.h"
+#include "utils/string_map.h"
+#include "utils/memory_report.h"
+#include "utils/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Number of measured operations.
+ */
+#define N_OPERATIONS 4
+
+/**
+ * @brief Write the i-th key, a user, reservation or flight ID in turn.
+ */
+static char* make_key(long i, int missing){
+    char key[32];
+    long n = i * 2 + missing;
+
+    switch (i % 3){
+        case 0: snprintf(key, sizeof(key), "UserName%ld", n); break;
+        case 1: snprintf(key, sizeof(key), "Book%010ld", n); break;
+        default: snprintf(key, sizeof(key), "%010ld", n); break;
+    }
+
+    return strdup(key);
+}
+
+/**
+ * @brief A random permutation of 0..n-1 (Fisher-Yates with a fixed xorshift seed).
+ */
+static long* shuffled_indexes(long n){
+    long* order = malloc(sizeof(long) * n);
+    for (long i = 0; i < n; i++) order[i] = i;
+
+    uint64_t state = 0x2545f4914f6cdd1dULL;
+    for (long i = n - 1; i > 0; i--){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        long j = state % (i + 1);
+        long tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    return order;
+}
+
+int map_bench(long keys){
+    static const char* operations[N_OPERATIONS] = {"insert", "lookup hit", "lookup miss", "iterate"};
+    double glib[N_OPERATIONS], flat[N_OPERATIONS];
+
+    char** present = malloc(sizeof(char*) * keys);
+    char** missing = malloc(sizeof(char*) * keys);
+    for (long i = 0; i < keys; i++){
+        present[i] = make_key(i, 0);
+        missing[i] = make_key(i, 1);
+    }
+    long* order = shuffled_indexes(keys);
+    volatile long sink = 0;
+    struct timespec start;
+
+    // GLib baseline
+    GHashTable* table = g_hash_table_new(g_str_hash, g_str_equal);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) g_hash_table_insert(table, present[i], present[i]);
+    glib[0] = elapsed_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) sink += g_hash_table_lookup(table, present[order[i]]) != NULL;
+    glib[1] = elapsed_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) sink += g_hash_table_lookup(table, missing[order[i]]) != NULL;
+    glib[2] = elapsed_since(start);
+
+    GHashTableIter table_iter;
+    gpointer key, value;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    g_hash_table_iter_init(&table_iter, table);
+    while (g_hash_table_iter_next(&table_iter, &key, &value)) sink += ((char*)value)[0];
+    glib[3] = elapsed_since(start);
+    size_t glib_memory = hash_table_memory(table);
+    g_hash_table_destroy(table);
+
+    // String map of the catalogs
+    STRING_MAP map = create_string_map(NULL, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) string_map_insert(map, present[i], present[i]);
+    flat[0] = elapsed_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) sink += string_map_lookup(map, present[order[i]]) != NULL;
+    flat[1] = elapsed_since(start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < keys; i++) sink += string_map_lookup(map, missing[order[i]]) != NULL;
+    flat[2] = elapsed_since(start);
+
+    STRING_MAP_ITER map_iter;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    string_map_iter_init(&map_iter, map);
+    while (string_map_iter_next(&map_iter, &key, &value)) sink += ((char*)value)[0];
+    flat[3] = elapsed_since(start);
+    size_t flat_memory = string_map_memory(map);
+    free_string_map(map);
+
+    for (long i = 0; i < keys; i++){
+        free(present[i]);
+        free(missing[i]);
+    }
+    free(present);
+    free(missing);
+    free(order);
+
+    FILE* csv = fopen(MAP_BENCH_CSV_PATH, "w");
+    if (csv == NULL){
+        printf("Could not create the map benchmark report.\n");
+        return -1;
+    }
+
+    printf("%ld keys\n%-12s %16s %16s %8s\n", keys, "Operation", "GHashTable (ns)", "String map (ns)", "Speedup");
+    fprintf(csv, "operation,keys,ghashtable_ns,string_map_ns\n");
+    for (int i = 0; i < N_OPERATIONS; i++){
+        double glib_ns = glib[i] / keys * 1e9;
+        double flat_ns = flat[i] / keys * 1e9;
+        printf("%-12s %16.1f %16.1f %7.2fx\n", operations[i], glib_ns, flat_ns, flat_ns > 0 ? glib_ns / flat_ns : 0);
+        fprintf(csv, "%s,%ld,%.2f,%.2f\n", operations[i], keys, glib_ns, flat_ns);
+    }
+    printf("%-12s %16zu %16zu %8s\n", "memory (B)", glib_memory, flat_memory, "");
+    fprintf(csv, "memory_bytes,%ld,%zu,%zu\n", keys, glib_memory, flat_memory);
+    fclose(csv);
+
+    return 0;
+}
@@ -32,13 +32,13 @@ void query10_test(MANAGER manager){
     argsAll[0] = NULL;
     argsAll[1] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultAll = query10(manager, argsAll);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultAll = query10(manager, argsAll);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 10 - years\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query10(resultAll);
+    free_result(resultAll);
     free(argsAll);
 
 // ----------------------------------------------------------------------------
@@ -46,13 +46,13 @@ void query10_test(MANAGER manager){
     args2023[0] = "2023";
     args2023[1] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultMonth = query10(manager, args2023);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultMonth = query10(manager, args2023);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 10 - months of 2023\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query10(resultMonth);
+    free_result(resultMonth);
     free(args2023);
 
 // ----------------------------------------------------------------------------
@@ -60,13 +60,13 @@ void query10_test(MANAGER manager){
     args2306[0] = "2023";
     args2306[1] = "06";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultDays = query10(manager, args2306);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultDays = query10(manager, args2306);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 10 - days of 06/2023\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query10(resultDays);
+    free_result(resultDays);
     free(args2306);
 
 // ----------------------------------------------------------------------------
@@ -74,13 +74,13 @@ void query10_test(MANAGER manager){
     argsInvalidYear[0] = "2024";
     argsInvalidYear[1] = "03";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidYear = query10(manager, argsInvalidYear);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidYear = query10(manager, argsInvalidYear);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 10 - invalid year (2024)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query10(resultInvalidYear);
+    free_result(resultInvalidYear);
     free(argsInvalidYear);
 
 // ----------------------------------------------------------------------------
@@ -88,13 +88,13 @@ void query10_test(MANAGER manager){
     argsInvalidMonth[0] = "2024";
     argsInvalidMonth[1] = "13";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidMonth = query10(manager, argsInvalidMonth);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidMonth = query10(manager, argsInvalidMonth);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 10 - invalid month (13/2024)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query10(resultInvalidMonth);
+    free_result(resultInvalidMonth);
     free(argsInvalidMonth);
 
     fclose(analysisTest);
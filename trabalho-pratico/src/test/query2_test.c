@@ -32,13 +32,13 @@ void query2_test(MANAGER manager){
     argsInvalidID[0] = "DGarcia429";
     argsInvalidID[1] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidID = query2(manager, argsInvalidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidID = query2(manager, argsInvalidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 2 - Invalid ID\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query2(resultInvalidID);
+    free_result(resultInvalidID);
     free(argsInvalidID);
 // ----------------------------------------------------------------------------
 
@@ -46,13 +46,13 @@ void query2_test(MANAGER manager){
     argsValidID[0] = "Jéssica Tavares";
     argsValidID[1] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultValidID = query2(manager, argsValidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultValidID = query2(manager, argsValidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 2 - Flights and Reservations\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query2(resultValidID);
+    free_result(resultValidID);
     free(argsValidID);
 // ----------------------------------------------------------------------------
 
@@ -61,13 +61,13 @@ void query2_test(MANAGER manager){
     argsValidFlight[1] = "flights";
     argsValidFlight[2] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultValidFlight = query2(manager, argsValidFlight);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultValidFlight = query2(manager, argsValidFlight);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 2 - Flights\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query2(resultValidFlight);
+    free_result(resultValidFlight);
     free(argsValidFlight);
 // ----------------------------------------------------------------------------
 
@@ -76,13 +76,13 @@ void query2_test(MANAGER manager){
     argsValidReservations[1] = "reservations";
     argsValidReservations[2] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultValidReservations = query2(manager, argsValidReservations);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultValidReservations = query2(manager, argsValidReservations);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 2 - Reservations\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query2(resultValidReservations);
+    free_result(resultValidReservations);
     free(argsValidReservations);
 
     fclose(analysisTest);
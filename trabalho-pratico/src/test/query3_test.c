@@ -32,26 +32,26 @@ void query3_test(MANAGER manager){
     char** argsInvalidID = malloc(sizeof(char*));
     argsInvalidID[0] = "DGarcia429";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidID = query3(manager, argsInvalidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidID = query3(manager, argsInvalidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 3 - Invalid ID\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query3(resultInvalidID);
+    free_result(resultInvalidID);
     free(argsInvalidID);
 // ----------------------------------------------------------------------------
 
     char** argsValidID = malloc(sizeof(char*));
     argsValidID[0] = "HTL1001";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultValidID = query3(manager, argsValidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultValidID = query3(manager, argsValidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 3 - Valid ID\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query3(resultValidID);
+    free_result(resultValidID);
     free(argsValidID);
 
     fclose(analysisTest);
@@ -21,6 +21,8 @@
 
 #include "test/query4_test.h"
 
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 void query4_test(MANAGER manager){
@@ -28,30 +30,60 @@ void query4_test(MANAGER manager){
     struct timespec start, end;
     double elapsed;
 
-    char** argsInvalidID = malloc(sizeof(char*));
+    // query4 reads the optional offset and limit, so the arguments end in NULL as the interpreter's do
+    char** argsInvalidID = malloc(sizeof(char*)*3);
     argsInvalidID[0] = "DGarcia429";
+    argsInvalidID[1] = NULL;
+    argsInvalidID[2] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidID = query4(manager, argsInvalidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidID = query4(manager, argsInvalidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 4 - Invalid ID\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query4(resultInvalidID);
+    free_result(resultInvalidID);
     free(argsInvalidID);
 // ----------------------------------------------------------------------------
 
-    char** argsValidID = malloc(sizeof(char*));
+    char** argsValidID = malloc(sizeof(char*)*3);
     argsValidID[0] = "HTL1003";
+    argsValidID[1] = NULL;
+    argsValidID[2] = NULL;
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultValidID = query4(manager, argsValidID);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultValidID = query4(manager, argsValidID);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 4 - Valid ID\n");
-    fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query4(resultValidID);
+    fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
     free(argsValidID);
+// ----------------------------------------------------------------------------
+
+    char** argsPage = malloc(sizeof(char*)*3);
+    argsPage[0] = "HTL1003";
+    argsPage[1] = "10";
+    argsPage[2] = "5";
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultPage = query4(manager, argsPage);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // The page must be the same rows as the full list from the offset on
+    int n_full = resultValidID != NULL ? get_result_rows(resultValidID) : 0;
+    int expected = n_full > 10 ? (n_full - 10 < 5 ? n_full - 10 : 5) : 0;
+    int matches = resultPage != NULL && get_result_rows(resultPage) == expected;
+    for (int i = 0; matches && i < expected; i++){
+        matches = strcmp(get_result_string(resultPage, i, 0), get_result_string(resultValidID, 10 + i, 0)) == 0;
+    }
+    if (!matches) printf("Query 4 - Page (offset 10, limit 5) does not match the full list\n");
+
+    fprintf(analysisTest, "Query 4 - Page (offset 10, limit 5)%s\n", matches ? "" : " - MISMATCH");
+    fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
+    free_result(resultPage);
+    free_result(resultValidID);
+    free(argsPage);
 
     fclose(analysisTest);
 
@@ -33,13 +33,13 @@ void query5_test(MANAGER manager){
     argsInvalidAirport[1] = "2021/01/01 00:00:00";
     argsInvalidAirport[2] = "2022/12/31 23:59:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidAir = query5(manager, argsInvalidAirport);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidAir = query5(manager, argsInvalidAirport);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Invalid Airport\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query5(resultInvalidAir);
+    free_result(resultInvalidAir);
     free(argsInvalidAirport);
 // ----------------------------------------------------------------------------
 
@@ -48,13 +48,13 @@ void query5_test(MANAGER manager){
     argsInvalidBDate[1] = "2021/13/01 00:00:00";
     argsInvalidBDate[2] = "2022/12/31 23:59:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidBDate = query5(manager, argsInvalidBDate);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidBDate = query5(manager, argsInvalidBDate);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Invalid begin date (2021/13/01 00:00:00)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query5(resultInvalidBDate);
+    free_result(resultInvalidBDate);
     free(argsInvalidBDate);
 // ----------------------------------------------------------------------------
 
@@ -63,13 +63,13 @@ void query5_test(MANAGER manager){
     argsInvalidEDate[1] = "2021/01/01 00:00:00";
     argsInvalidEDate[2] = "2022/12/31 23:60:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidEDate = query5(manager, argsInvalidEDate);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidEDate = query5(manager, argsInvalidEDate);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Invalid end date (2022/12/31 23:60:59)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query5(resultInvalidEDate);
+    free_result(resultInvalidEDate);
     free(argsInvalidEDate);
 // ----------------------------------------------------------------------------
 
@@ -78,13 +78,13 @@ void query5_test(MANAGER manager){
     argsSmall[1] = "2021/01/01 00:00:00";
     argsSmall[2] = "2021/12/31 23:60:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultSmall = query5(manager, argsSmall);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultSmall = query5(manager, argsSmall);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Within a short time frame\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query5(resultSmall);
+    free_result(resultSmall);
     free(argsSmall);
 // ----------------------------------------------------------------------------
 
@@ -93,13 +93,13 @@ void query5_test(MANAGER manager){
     argsMedium[1] = "2020/01/01 00:00:00";
     argsMedium[2] = "2022/12/31 23:60:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultMedium = query5(manager, argsMedium);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultMedium = query5(manager, argsMedium);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Within a moderate time frame\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query5(resultMedium);
+    free_result(resultMedium);
     free(argsMedium);
 // ----------------------------------------------------------------------------
 
@@ -108,13 +108,13 @@ void query5_test(MANAGER manager){
     argsBig[1] = "2017/01/01 00:00:00";
     argsBig[2] = "2022/12/31 23:60:59";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultBig = query5(manager, argsBig);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultBig = query5(manager, argsBig);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 5 - Within a longer time frame\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query5(resultBig);
+    free_result(resultBig);
     free(argsBig);
     fclose(analysisTest);
 
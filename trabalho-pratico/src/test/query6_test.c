@@ -32,13 +32,13 @@ void query6_test(MANAGER manager){
     argsInvalid[0] = "2023";
     argsInvalid[1] = "-1";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalid = query6(manager, argsInvalid);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalid = query6(manager, argsInvalid);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 6 - Invalid N (-1)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query6(resultInvalid);
+    free_result(resultInvalid);
     free(argsInvalid);
 // ----------------------------------------------------------------------------
 
@@ -46,13 +46,13 @@ void query6_test(MANAGER manager){
     argsInvalidY[0] = "2024";
     argsInvalidY[1] = "10";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalidY = query6(manager, argsInvalidY);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalidY = query6(manager, argsInvalidY);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 6 - Invalid year (2024)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query6(resultInvalidY);
+    free_result(resultInvalidY);
     free(argsInvalidY);
 // ----------------------------------------------------------------------------
 
@@ -60,13 +60,13 @@ void query6_test(MANAGER manager){
     argsSmall[0] = "2023";
     argsSmall[1] = "10";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultSmall = query6(manager, argsSmall);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultSmall = query6(manager, argsSmall);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 6 - N = 10\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query6(resultSmall);
+    free_result(resultSmall);
     free(argsSmall);
 
 // ----------------------------------------------------------------------------
@@ -75,13 +75,13 @@ void query6_test(MANAGER manager){
     argsMedium[0] = "2023";
     argsMedium[1] = "100";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultMedium = query6(manager, argsMedium);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultMedium = query6(manager, argsMedium);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 6 - N = 100\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query6(resultMedium);
+    free_result(resultMedium);
     free(argsMedium);
 // ----------------------------------------------------------------------------
 
@@ -89,13 +89,13 @@ void query6_test(MANAGER manager){
     argsBig[0] = "2023";
     argsBig[1] = "300";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultBig = query6(manager, argsBig);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultBig = query6(manager, argsBig);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 6 - N = 250\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query6(resultBig);
+    free_result(resultBig);
     free(argsBig);
     fclose(analysisTest);
 
@@ -31,52 +31,52 @@ void query7_test(MANAGER manager){
     char** argsInvalid = malloc(sizeof(char*));
     argsInvalid[0] = "-1";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultInvalid = query7(manager, argsInvalid);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultInvalid = query7(manager, argsInvalid);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 7 - Invalid N (-1)\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query7(resultInvalid);
+    free_result(resultInvalid);
     free(argsInvalid);
 // ----------------------------------------------------------------------------
 
     char** argsSmall = malloc(sizeof(char*));
     argsSmall[0] = "10";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultSmall = query7(manager, argsSmall);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultSmall = query7(manager, argsSmall);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 7 - N = 10\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query7(resultSmall);
+    free_result(resultSmall);
     free(argsSmall);
 // ----------------------------------------------------------------------------
 
     char** argsMedium = malloc(sizeof(char*));
     argsMedium[0] = "100";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultMedium = query7(manager, argsMedium);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultMedium = query7(manager, argsMedium);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 7 - N = 100\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query7(resultMedium);
+    free_result(resultMedium);
     free(argsMedium);
 // ----------------------------------------------------------------------------
 
     char** argsBig = malloc(sizeof(char*));
     argsBig[0] = "300";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* resultBig = query7(manager, argsBig);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT resultBig = query7(manager, argsBig);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 7 - N = 250\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query7(resultBig);
+    free_result(resultBig);
     free(argsBig);
     fclose(analysisTest);
 }
@@ -33,13 +33,13 @@ void query8_test(MANAGER manager){
 
     struct timespec start, end;
     double elapsed;
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* result = query8(manager, args);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT result = query8(manager, args);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 8 - Case 1\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query8(result);
+    free_result(result);
     free(args);
 // ----------------------------------------------------------------------------
 
@@ -48,13 +48,13 @@ void query8_test(MANAGER manager){
     args2[1] = "2022/09/07";
     args2[2] = "2023/12/09";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* result2 = query8(manager, args2);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT result2 = query8(manager, args2);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 8 - Case 2\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query8(result2);
+    free_result(result2);
     free(args2);
     fclose(analysisTest);
     //HTL203 2022/09/07 2022/12/09
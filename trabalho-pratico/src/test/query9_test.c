@@ -31,26 +31,26 @@ void query9_test(MANAGER manager){
 
     struct timespec start, end;
     double elapsed;
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* result = query9(manager, args);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT result = query9(manager, args);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 9 - Small user list\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n", elapsed);
-    free_query9(result);
+    free_result(result);
     free(args);
 // ----------------------------------------------------------------------------
 
     char** args2 = malloc(sizeof(char*));
     args2[0] = "Alexand";
 
-    clock_gettime(CLOCK_REALTIME, &start);
-    void* result2 = query9(manager, args2);
-    clock_gettime(CLOCK_REALTIME, &end);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    RESULT result2 = query9(manager, args2);
+    clock_gettime(CLOCK_MONOTONIC, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     fprintf(analysisTest, "Query 9 - Big user list\n");
     fprintf(analysisTest, "Elapsed time: %.6f seconds\n\n\n", elapsed);
-    free_query9(result2);
+    free_result(result2);
     free(args2);
 
     fclose(analysisTest);
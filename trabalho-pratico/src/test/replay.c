@@ -0,0 +1,265 @@
+/**
+ * @file replay.c
+ * @brief Replay of a command file against loaded catalogs, measuring the throughput.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/replay.h"
+#include "test/command_mix.h"
+#include "test/generator.h"
+#include "catalogs/manager_c.h"
+#include "IO/interpreter.h"
+#include "utils/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Number of query identifiers, 1 to 10 and 1F to 10F.
+ */
+#define N_IDS 20
+
+/**
+ * @struct latency_histogram
+ * @brief The latencies of a query identifier.
+ */
+struct latency_histogram {
+    long count; /**< Number of commands. */
+    double total; /**< Sum of the latencies, in microseconds. */
+    double max; /**< Highest latency, in microseconds. */
+    long buckets[REPLAY_BUCKETS]; /**< Bucket i counts latencies below 2^i microseconds. */
+};
+
+/**
+ * @brief Add a latency to a histogram.
+ *
+ * @param histogram The histogram.
+ * @param us The latency, in microseconds.
+ */
+static void add_latency(struct latency_histogram* histogram, double us){
+    int bucket = 0;
+    while (bucket < REPLAY_BUCKETS - 1 && us >= (double)(1L << bucket)) bucket++;
+
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total += us;
+    if (us > histogram->max) histogram->max = us;
+}
+
+/**
+ * @brief Get the upper bound of the bucket holding a percentile.
+ *
+ * @param histogram The histogram.
+ * @param percentile The percentile, from 0 to 100.
+ * @return The upper bound in microseconds, or the maximum for the last bucket.
+ */
+static double histogram_percentile(struct latency_histogram* histogram, double percentile){
+    long rank = (long)(percentile / 100.0 * histogram->count + 0.999999);
+    long seen = 0;
+
+    for (int i = 0; i < REPLAY_BUCKETS - 1; i++){
+        seen += histogram->buckets[i];
+        if (seen >= rank) return (double)(1L << i) < histogram->max ? (double)(1L << i) : histogram->max;
+    }
+    return histogram->max;
+}
+
+/**
+ * @brief Get the index of the histogram of a command, 0 to 9 for 1 to 10, 10 to 19 for 1F to 10F.
+ */
+static int histogram_index(COMMAND_MIX mix, int i){
+    return get_mix_family(mix, i) - 1 + (get_mix_formatted(mix, i) ? 10 : 0);
+}
+
+/**
+ * @brief Advances a xorshift64 generator, for the weighted draw of the commands.
+ */
+static uint64_t next_draw(uint64_t* state){
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @struct weighted_draw
+ * @brief The commands of each family and the weights they are drawn with.
+ */
+struct weighted_draw {
+    int* commands[10]; /**< Indexes of the commands of each family. */
+    int n_commands[10]; /**< Number of commands of each family. */
+    int weights[10]; /**< Weight of each family, 0 when the file has none of its commands. */
+    int total; /**< Sum of the weights. */
+    uint64_t state; /**< Generator state. */
+};
+
+/**
+ * @brief Group the commands of a file by family, for the weighted draw.
+ */
+static void init_draw(struct weighted_draw* draw, COMMAND_MIX mix){
+    static const int weights[] = GENERATOR_MIX;
+    int n = get_mix_size(mix);
+
+    draw->total = 0;
+    draw->state = 0x9E3779B97F4A7C15ULL;
+    for (int f = 0; f < 10; f++){
+        draw->commands[f] = malloc(sizeof(int) * (n > 0 ? n : 1));
+        draw->n_commands[f] = 0;
+    }
+    for (int i = 0; i < n; i++){
+        int f = get_mix_family(mix, i) - 1;
+        draw->commands[f][draw->n_commands[f]++] = i;
+    }
+    for (int f = 0; f < 10; f++){
+        draw->weights[f] = draw->n_commands[f] > 0 ? weights[f] : 0;
+        draw->total += draw->weights[f];
+    }
+}
+
+/**
+ * @brief Draw the next command, first its family by weight and then one of its commands.
+ *
+ * @return The command index.
+ */
+static int next_command(struct weighted_draw* draw){
+    int pick = next_draw(&draw->state) % draw->total;
+    int f = 0;
+    while (pick >= draw->weights[f]) pick -= draw->weights[f++];
+
+    return draw->commands[f][next_draw(&draw->state) % draw->n_commands[f]];
+}
+
+/**
+ * @brief Print the histograms and write them, one row per query identifier, to the CSV report.
+ *
+ * @param histograms The histograms, one per query identifier.
+ * @param elapsed Duration of the replay, in seconds.
+ * @param csv The CSV report, or NULL.
+ */
+static void report_histograms(struct latency_histogram* histograms, double elapsed, FILE* csv){
+    printf("\n%-5s %10s %12s %12s %12s %12s\n", "Query", "Commands", "mean (us)", "p50 (us)", "p99 (us)", "max (us)");
+    for (int i = 0; i < N_IDS; i++){
+        struct latency_histogram* h = &histograms[i];
+        if (h->count == 0) continue;
+
+        char id[8];
+        snprintf(id, sizeof(id), "%d%s", i % 10 + 1, i >= 10 ? "F" : "");
+        double p50 = histogram_percentile(h, 50), p99 = histogram_percentile(h, 99);
+
+        printf("%-5s %10ld %12.1f %12.0f %12.0f %12.1f\n", id, h->count, h->total / h->count, p50, p99, h->max);
+
+        if (csv != NULL){
+            fprintf(csv, "%s,%ld,%.1f,%.3f,%.0f,%.0f,%.3f", id, h->count, h->count / elapsed, h->total / h->count, p50, p99, h->max);
+            for (int b = 0; b < REPLAY_BUCKETS; b++) fprintf(csv, ",%ld", h->buckets[b]);
+            fprintf(csv, "\n");
+        }
+    }
+
+    // Only the buckets used by some identifier are printed
+    int first = REPLAY_BUCKETS, last = -1;
+    for (int i = 0; i < N_IDS; i++){
+        for (int b = 0; b < REPLAY_BUCKETS; b++){
+            if (histograms[i].buckets[b] == 0) continue;
+            if (b < first) first = b;
+            if (b > last) last = b;
+        }
+    }
+
+    printf("\nLatency histogram, commands below each bound (us)\n%-5s", "Query");
+    for (int b = first; b <= last; b++){
+        if (b == REPLAY_BUCKETS - 1) printf(" %8s", "inf");
+        else printf(" %8ld", 1L << b);
+    }
+    printf("\n");
+
+    for (int i = 0; i < N_IDS; i++){
+        if (histograms[i].count == 0) continue;
+
+        char id[8];
+        snprintf(id, sizeof(id), "%d%s", i % 10 + 1, i >= 10 ? "F" : "");
+        printf("%-5s", id);
+        for (int b = first; b <= last; b++) printf(" %8ld", histograms[i].buckets[b]);
+        printf("\n");
+    }
+}
+
+int replay(char* pathD, char* pathI, double seconds, long commands, int mix){
+    COMMAND_MIX command_mix = read_command_mix(pathI);
+    if (command_mix == NULL || get_mix_size(command_mix) == 0){
+        printf("The provided command file is not valid.\n");
+        if (command_mix != NULL) free_command_mix(command_mix);
+        return -1;
+    }
+
+    USERS_C users_catalog = create_user_c();
+    FLIGHTS_C flights_catalog = create_flight_c();
+    RESERV_C reservations_catalog = create_reservations_c();
+    PASS_C passengers_catalog = create_passengers_c();
+    MANAGER manager_catalog = create_manager_c(users_catalog,flights_catalog,reservations_catalog,passengers_catalog);
+
+    if (set_catalogs(manager_catalog,pathD) == -1){
+        printf("The provided dataset is not valid.\n");
+        free_manager_c(manager_catalog);
+        free_command_mix(command_mix);
+        return -1;
+    }
+
+    struct weighted_draw draw;
+    init_draw(&draw, command_mix);
+
+    struct latency_histogram histograms[N_IDS] = {0};
+    int n = get_mix_size(command_mix);
+    long run = 0;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double elapsed = 0;
+
+    while (commands > 0 ? run < commands : elapsed < seconds){
+        int i = mix ? next_command(&draw) : run % n;
+
+        struct timespec query_start;
+        clock_gettime(CLOCK_MONOTONIC, &query_start);
+        RESULT result = parser_query(manager_catalog, get_mix_command(command_mix, i));
+        free_result(result);
+        double latency = elapsed_since(query_start);
+
+        add_latency(&histograms[histogram_index(command_mix, i)], latency * 1e6);
+        run++;
+        elapsed = elapsed_since(start);
+    }
+
+    printf("Replayed %ld commands in %.3f seconds: %.1f queries/s\n", run, elapsed, run / elapsed);
+
+    FILE* csv = fopen(REPLAY_CSV_PATH, "w");
+    if (csv != NULL){
+        fprintf(csv, "query,commands,queries_per_s,mean_us,p50_us,p99_us,max_us");
+        for (int b = 0; b < REPLAY_BUCKETS - 1; b++) fprintf(csv, ",lt_%ldus", 1L << b);
+        fprintf(csv, ",inf\n");
+    }
+    report_histograms(histograms, elapsed, csv);
+    if (csv != NULL) fclose(csv);
+
+    for (int f = 0; f < 10; f++) free(draw.commands[f]);
+    free_manager_c(manager_catalog);
+    free_command_mix(command_mix);
+
+    return 0;
+}
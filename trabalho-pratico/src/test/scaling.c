@@ -0,0 +1,222 @@
+/**
+ * @file scaling.c
+ * @brief Benchmark of how the load and the queries scale with the dataset size and thread count.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test/scaling.h"
+#include "test/generator.h"
+#include "test/command_mix.h"
+#include "catalogs/manager_c.h"
+#include "IO/interpreter.h"
+#include "IO/snapshot.h"
+#include "utils/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/**
+ * @brief Number of query families.
+ */
+#define N_FAMILIES 10
+
+/**
+ * @struct mix_run
+ * @brief A thread running the command mix and its measurements.
+ */
+struct mix_run {
+    MANAGER manager; /**< The catalogs. */
+    COMMAND_MIX mix; /**< The commands. */
+    double seconds[N_FAMILIES]; /**< Time spent in each query family. */
+    int commands[N_FAMILIES]; /**< Commands run of each query family. */
+};
+
+/**
+ * @brief Thread that runs every command of the mix once, timing each one.
+ */
+static void* run_mix(void* arg){
+    struct mix_run* run = arg;
+
+    for (int i = 0; i < get_mix_size(run->mix); i++){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        RESULT result = parser_query(run->manager, get_mix_command(run->mix, i));
+        double elapsed = elapsed_since(start);
+        free_result(result);
+
+        int family = get_mix_family(run->mix, i) - 1;
+        run->seconds[family] += elapsed;
+        run->commands[family]++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Load a dataset and measure the command mix from each number of threads.
+ *
+ * Runs in a child process, so that the peak memory of each scale is measured on its own.
+ *
+ * @param path Path of the dataset.
+ * @param scale Scale of the dataset.
+ * @param max_threads Largest number of query threads.
+ * @return 0 on success, -1 if the dataset or the commands can't be loaded.
+ */
+static int measure_scale(char* path, double scale, int max_threads){
+    char* commands_path = concat(path, "/commands.txt");
+    COMMAND_MIX mix = read_command_mix(commands_path);
+    free(commands_path);
+    if (mix == NULL) return -1;
+
+    USERS_C users_catalog = create_user_c();
+    FLIGHTS_C flights_catalog = create_flight_c();
+    RESERV_C reservations_catalog = create_reservations_c();
+    PASS_C passengers_catalog = create_passengers_c();
+    MANAGER manager_catalog = create_manager_c(users_catalog,flights_catalog,reservations_catalog,passengers_catalog);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int loaded = set_catalogs(manager_catalog, path);
+    double load = elapsed_since(start);
+
+    if (loaded == -1){
+        free_manager_c(manager_catalog);
+        free_command_mix(mix);
+        return -1;
+    }
+
+    // Builds the lazy indexes, which would otherwise be charged to the first thread count
+    struct mix_run warmup = {manager_catalog, mix, {0}, {0}};
+    run_mix(&warmup);
+
+    FILE* csv = fopen(SCALING_CSV_PATH, "a");
+
+    for (int n_threads = 1; n_threads <= max_threads; n_threads *= 2){
+        struct mix_run* runs = calloc(n_threads, sizeof(struct mix_run));
+        pthread_t* threads = malloc(sizeof(pthread_t) * n_threads);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < n_threads; i++){
+            runs[i].manager = manager_catalog;
+            runs[i].mix = mix;
+            pthread_create(&threads[i], NULL, run_mix, &runs[i]);
+        }
+        for (int i = 0; i < n_threads; i++) pthread_join(threads[i], NULL);
+        double wall = elapsed_since(start);
+
+        struct rusage r_usage;
+        getrusage(RUSAGE_SELF, &r_usage);
+        double throughput = (double)n_threads * get_mix_size(mix) / wall;
+
+        printf("%-6g %8d %7d %10.3f %10ld %10.0f", scale, get_mix_size(mix), n_threads, load, r_usage.ru_maxrss, throughput);
+        if (csv != NULL) fprintf(csv, "%g,%d,%d,%.6f,%ld,%.1f", scale, get_mix_size(mix), n_threads, load, r_usage.ru_maxrss, throughput);
+
+        for (int f = 0; f < N_FAMILIES; f++){
+            double seconds = 0;
+            int commands = 0;
+            for (int i = 0; i < n_threads; i++){
+                seconds += runs[i].seconds[f];
+                commands += runs[i].commands[f];
+            }
+
+            double mean = commands > 0 ? seconds / commands * 1e6 : 0;
+            printf(" %9.1f", mean);
+            if (csv != NULL) fprintf(csv, ",%.3f", mean);
+        }
+        printf("\n");
+        if (csv != NULL) fprintf(csv, "\n");
+
+        free(runs);
+        free(threads);
+    }
+
+    if (csv != NULL) fclose(csv);
+    free_manager_c(manager_catalog);
+    free_command_mix(mix);
+
+    return 0;
+}
+
+int scaling_bench(char* dir, double max_scale, int max_threads){
+    // The load is measured from the CSV files only: no snapshot is read, saved or removed
+    set_snapshot_enabled(0);
+
+    if (mkdir(dir, 0755) == -1 && errno != EEXIST){
+        perror("Error creating the datasets folder");
+        return -1;
+    }
+
+    FILE* csv = fopen(SCALING_CSV_PATH, "w");
+    if (csv == NULL){
+        printf("Could not create the scaling report.\n");
+        return -1;
+    }
+    fprintf(csv, "scale,commands,threads,load_s,peak_rss_kb,commands_per_s");
+    for (int f = 1; f <= N_FAMILIES; f++) fprintf(csv, ",q%d_us", f);
+    fprintf(csv, "\n");
+    fclose(csv);
+
+    for (double scale = SCALING_MIN_SCALE; scale <= max_scale; scale *= 2){
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/scale-%g", dir, scale);
+        char* commands_path = concat(path, "/commands.txt");
+
+        int generated = (mkdir(path, 0755) == 0 || errno == EEXIST) &&
+                        generate_dataset(path, scale, SCALING_SEED, GENERATOR_INVALID) == 0 &&
+                        generate_commands(commands_path, scale, SCALING_SEED, SCALING_COMMANDS) == 0;
+        free(commands_path);
+        if (!generated){
+            printf("Could not generate the dataset of scale %g\n", scale);
+            return -1;
+        }
+
+        printf("\n%-6s %8s %7s %10s %10s %10s", "Scale", "Commands", "Threads", "Load (s)", "RSS (KB)", "Cmd/s");
+        for (int f = 1; f <= N_FAMILIES; f++) printf(" %6s%-3d", "Q", f);
+        printf("\n");
+        fflush(stdout);
+
+        pid_t pid = fork();
+        if (pid == -1){
+            perror("Error starting the measurement");
+            return -1;
+        }
+        if (pid == 0){
+            int status = measure_scale(path, scale, max_threads);
+            fflush(stdout);
+            _exit(status == -1);
+        }
+
+        int status;
+        if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0){
+            printf("Could not load the dataset of scale %g\n", scale);
+            return -1;
+        }
+    }
+
+    printf("\nResults written to %s\n", SCALING_CSV_PATH);
+
+    return 0;
+}
@@ -25,7 +25,7 @@
 #include <time.h>
 #include <sys/resource.h>
 
-void test(char* pathD, char* pathI, char* pathO){
+int test(char* pathD, char* pathI, char* pathO, char* pathB){
     struct timespec start, end;
     double elapsed;
     clock_gettime(CLOCK_REALTIME, &start);
@@ -38,16 +38,17 @@ void test(char* pathD, char* pathI, char* pathO){
 
     if (set_catalogs(manager_catalog,pathD) == -1){
         printf("The provided dataset is not valid.\n");
-        return;
+        return -1;
     }
 
-    int n = execute_queries(manager_catalog,pathI, 1);
+    int n = execute_queries(manager_catalog,pathI, 1, OUTPUT_FILES);
 
     if (n == -1){
-        return;
+        return -1;
     }
 
-    compare_files(pathO, n);
+    int anomalies = compare_files(pathO);
+    int regressions = check_latency("Resultados/analysis.txt", pathB);
 
     clock_gettime(CLOCK_REALTIME, &end);
     elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
@@ -61,7 +62,10 @@ void test(char* pathD, char* pathI, char* pathO){
 
     replace_lines_at_start("Resultados/analysis.txt", time, memory);
 
-    //Tests to each query
+    //Tests to each query, which append their timings to analysisTest.txt
+    FILE* analysisTest = fopen("Resultados/analysisTest.txt", "w");
+    if (analysisTest != NULL) fclose(analysisTest);
+
     clock_gettime(CLOCK_REALTIME, &start);
 
     static queries_test queries[] = {query1_test, query2_test, query3_test,
@@ -86,6 +90,8 @@ void test(char* pathD, char* pathI, char* pathO){
     replace_lines_at_start("Resultados/analysisTest.txt", timeT, memoryT);
 
     free_manager_c(manager_catalog);
+
+    return anomalies != 0 || regressions != 0 ? -1 : 0;
 }
 
 
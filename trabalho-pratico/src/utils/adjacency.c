@@ -0,0 +1,77 @@
+/**
+ * @file adjacency.c
+ * @brief Compressed sparse row adjacency between dense entity indexes.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/adjacency.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct adjacency
+ * @brief An adjacency.
+ */
+struct adjacency {
+    size_t rows; /**< Number of rows. */
+    uint32_t* offsets; /**< Where the neighbors of each row start, with the number of edges at the end. */
+    uint32_t* neighbors; /**< The neighbors of every row. */
+};
+
+ADJACENCY create_adjacency(size_t rows, const ADJACENCY_EDGE* edges, size_t n_edges){
+    ADJACENCY new = malloc(sizeof(struct adjacency));
+    new->rows = rows;
+    new->offsets = calloc(rows + 1, sizeof(uint32_t));
+    new->neighbors = malloc(sizeof(uint32_t) * (n_edges > 0 ? n_edges : 1));
+
+    for (size_t i = 0; i < n_edges; i++) new->offsets[edges[i].row + 1]++;
+    for (size_t r = 0; r < rows; r++) new->offsets[r + 1] += new->offsets[r];
+
+    uint32_t* next = malloc(sizeof(uint32_t) * (rows > 0 ? rows : 1));
+    memcpy(next, new->offsets, sizeof(uint32_t) * rows);
+    for (size_t i = 0; i < n_edges; i++) new->neighbors[next[edges[i].row]++] = edges[i].neighbor;
+    free(next);
+
+    return new;
+}
+
+const uint32_t* get_adjacency_row(ADJACENCY adjacency, uint32_t row, uint32_t* degree){
+    *degree = adjacency->offsets[row + 1] - adjacency->offsets[row];
+    return adjacency->neighbors + adjacency->offsets[row];
+}
+
+size_t get_adjacency_rows(ADJACENCY adjacency){
+    return adjacency->rows;
+}
+
+size_t get_adjacency_edges(ADJACENCY adjacency){
+    return adjacency->offsets[adjacency->rows];
+}
+
+size_t adjacency_memory(ADJACENCY adjacency){
+    return sizeof(struct adjacency) + sizeof(uint32_t) * (adjacency->rows + 1 + get_adjacency_edges(adjacency));
+}
+
+void free_adjacency(ADJACENCY adjacency){
+    if (adjacency == NULL) return;
+
+    free(adjacency->offsets);
+    free(adjacency->neighbors);
+    free(adjacency);
+}
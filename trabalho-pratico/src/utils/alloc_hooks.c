@@ -0,0 +1,185 @@
+/**
+ * @file alloc_hooks.c
+ * @brief Allocator hooks that charge every allocation to a subsystem tag.
+ *
+ * Linked only into programa-bench, or into every executable with make ALLOC_STATS=1. Defining the
+ * allocator functions in the executable takes precedence over the C library ones, so the
+ * allocations made inside GLib and the C library are counted too.
+ *
+ * Each block starts with a header holding its size and tag, so that it is released from the tag
+ * it was charged to even when another subsystem frees it.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/alloc_stats.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+/**
+ * @struct alloc_header
+ * @brief The header before every block, 16 bytes so that blocks stay aligned.
+ */
+struct alloc_header {
+    uint64_t size; /**< Size requested. */
+    uint32_t offset; /**< Distance from the start of the underlying block to the user block. */
+    uint32_t tag; /**< Tag the block was charged to. */
+};
+
+/**
+ * @brief Size of the header.
+ */
+#define HEADER_SIZE sizeof(struct alloc_header)
+
+/**
+ * @brief Marks the hooks as linked.
+ */
+__attribute__((constructor)) static void enable_alloc_accounting(void){
+    alloc_accounting = 1;
+}
+
+/**
+ * @brief Get the header of a user block.
+ */
+static inline struct alloc_header* header_of(void* ptr){
+    return (struct alloc_header*)((char*)ptr - HEADER_SIZE);
+}
+
+/**
+ * @brief Write the header of a new block and charge it to the current tag.
+ *
+ * @param base The underlying block.
+ * @param offset Distance from the underlying block to the user block.
+ * @param size The size requested.
+ * @return The user block.
+ */
+static void* track(void* base, size_t offset, size_t size){
+    if (base == NULL) return NULL;
+
+    char* ptr = (char*)base + offset;
+    struct alloc_header* header = header_of(ptr);
+    header->size = size;
+    header->offset = offset;
+    header->tag = alloc_current_tag;
+    count_alloc(alloc_current_tag, size);
+
+    return ptr;
+}
+
+void* malloc(size_t size){
+    if (size > SIZE_MAX - HEADER_SIZE) return NULL;
+    return track(__libc_malloc(size + HEADER_SIZE), HEADER_SIZE, size);
+}
+
+void* calloc(size_t n, size_t size){
+    if (size != 0 && n > (SIZE_MAX - HEADER_SIZE) / size) return NULL;
+    return track(__libc_calloc(1, n * size + HEADER_SIZE), HEADER_SIZE, n * size);
+}
+
+void free(void* ptr){
+    if (ptr == NULL) return;
+
+    struct alloc_header* header = header_of(ptr);
+    count_free(header->tag, header->size);
+    __libc_free((char*)ptr - header->offset);
+}
+
+void* realloc(void* ptr, size_t size){
+    if (ptr == NULL) return malloc(size);
+    if (size == 0){
+        free(ptr);
+        return NULL;
+    }
+    if (size > SIZE_MAX - HEADER_SIZE) return NULL;
+
+    struct alloc_header* header = header_of(ptr);
+    size_t old_size = header->size;
+
+    // Aligned blocks can't be moved by the C library without losing their alignment
+    if (header->offset != HEADER_SIZE){
+        void* new = malloc(size);
+        if (new != NULL){
+            memcpy(new, ptr, old_size < size ? old_size : size);
+            free(ptr);
+        }
+        return new;
+    }
+
+    ALLOC_TAG old_tag = header->tag;
+    void* base = __libc_realloc((char*)ptr - HEADER_SIZE, size + HEADER_SIZE);
+    if (base == NULL) return NULL;
+
+    count_free(old_tag, old_size);
+    return track(base, HEADER_SIZE, size);
+}
+
+/**
+ * @brief Allocate an aligned block with room for the header before it.
+ *
+ * @param alignment The alignment, a power of two.
+ * @param size The size requested.
+ * @return The user block.
+ */
+static void* aligned(size_t alignment, size_t size){
+    if (alignment < HEADER_SIZE) alignment = HEADER_SIZE;
+    if (size > SIZE_MAX - alignment - HEADER_SIZE) return NULL;
+
+    char* base = __libc_malloc(size + alignment + HEADER_SIZE);
+    if (base == NULL) return NULL;
+
+    uintptr_t start = ((uintptr_t)base + HEADER_SIZE + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return track(base, start - (uintptr_t)base, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size){
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment % sizeof(void*) != 0) return EINVAL;
+
+    void* block = aligned(alignment, size);
+    if (block == NULL) return ENOMEM;
+
+    *ptr = block;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size){
+    return aligned(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size){
+    return aligned(alignment, size);
+}
+
+void* valloc(size_t size){
+    return aligned(sysconf(_SC_PAGESIZE), size);
+}
+
+void* pvalloc(size_t size){
+    size_t page = sysconf(_SC_PAGESIZE);
+    return aligned(page, (size + page - 1) & ~(page - 1));
+}
+
+size_t malloc_usable_size(void* ptr){
+    return ptr == NULL ? 0 : header_of(ptr)->size;
+}
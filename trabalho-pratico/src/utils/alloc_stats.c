@@ -0,0 +1,88 @@
+/**
+ * @file alloc_stats.c
+ * @brief This file contains the implementation of the allocation accounting by subsystem.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/alloc_stats.h"
+
+/**
+ * @struct alloc_counter
+ * @brief The allocations charged to a tag.
+ */
+struct alloc_counter {
+    long count; /**< Number of allocations. */
+    long bytes; /**< Bytes requested. */
+    long live; /**< Bytes allocated and not yet freed. */
+    long peak; /**< Highest value of live. */
+};
+
+int alloc_accounting = 0;
+__thread ALLOC_TAG alloc_current_tag = ALLOC_OTHER;
+
+static struct alloc_counter counters[ALLOC_N_TAGS];
+
+void count_alloc(ALLOC_TAG tag, size_t size){
+    struct alloc_counter* counter = &counters[tag];
+
+    __atomic_fetch_add(&counter->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&counter->bytes, (long)size, __ATOMIC_RELAXED);
+    long live = __atomic_add_fetch(&counter->live, (long)size, __ATOMIC_RELAXED);
+
+    long peak = __atomic_load_n(&counter->peak, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&counter->peak, &peak, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void count_free(ALLOC_TAG tag, size_t size){
+    __atomic_fetch_sub(&counters[tag].live, (long)size, __ATOMIC_RELAXED);
+}
+
+ALLOC_TAG set_alloc_tag(ALLOC_TAG tag){
+    ALLOC_TAG previous = alloc_current_tag;
+    alloc_current_tag = tag;
+    return previous;
+}
+
+void restore_alloc_tag(ALLOC_TAG* previous){
+    alloc_current_tag = *previous;
+}
+
+void get_alloc_totals(long* count, long* bytes){
+    *count = 0;
+    *bytes = 0;
+    for (int i = 0; i < ALLOC_N_TAGS; i++){
+        *count += __atomic_load_n(&counters[i].count, __ATOMIC_RELAXED);
+        *bytes += __atomic_load_n(&counters[i].bytes, __ATOMIC_RELAXED);
+    }
+}
+
+void write_alloc_stats(FILE* file){
+    static const char* names[] = {"other", "parser", "entities", "catalogs", "queries", "output", "interactive"};
+
+    if (!alloc_accounting) return;
+
+    fprintf(file, "Allocations by subsystem\n");
+    for (int i = 0; i < ALLOC_N_TAGS; i++){
+        fprintf(file, "%s: %ld allocations, %ld bytes, peak %ld bytes\n", names[i],
+                __atomic_load_n(&counters[i].count, __ATOMIC_RELAXED),
+                __atomic_load_n(&counters[i].bytes, __ATOMIC_RELAXED),
+                __atomic_load_n(&counters[i].peak, __ATOMIC_RELAXED));
+    }
+    fprintf(file, "\n");
+}
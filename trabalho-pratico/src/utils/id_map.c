@@ -0,0 +1,222 @@
+/**
+ * @file id_map.c
+ * @brief Map from entity IDs to values, indexed by number when the ID is canonical.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/id_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Smallest number of slots of the array, and how far past twice the IDs in it a number can go.
+ */
+#define ID_MAP_SLACK 1024
+
+/**
+ * @struct id_map_slot
+ * @brief A canonical ID and its value.
+ */
+struct id_map_slot {
+    char* key; /**< The ID, NULL when the slot is free. */
+    void* value; /**< The value. */
+};
+
+/**
+ * @struct id_map
+ * @brief An ID map.
+ */
+struct id_map {
+    const char* prefix; /**< Prefix of the canonical IDs. */
+    size_t prefix_length; /**< Length of the prefix. */
+    struct id_map_slot* slots; /**< Slot of each canonical ID, indexed by its number. */
+    size_t capacity; /**< Number of slots. */
+    size_t dense; /**< Number of IDs in the slots. */
+    STRING_MAP fallback; /**< The IDs that aren't in the slots. */
+    PERFECT_HASH frozen; /**< Perfect hash of the fallback map after freeze_id_map, NULL until then. */
+    GDestroyNotify free_key; /**< Frees a key, NULL when they are borrowed. */
+    GDestroyNotify free_value; /**< Frees a value, NULL when they are borrowed. */
+};
+
+/**
+ * @brief Encode a canonical ID as its number, given the length of the prefix.
+ */
+static int encode_key(const char* id, const char* prefix, size_t prefix_length, uint64_t* key){
+    if (strncmp(id, prefix, prefix_length) != 0) return 0;
+    id += prefix_length;
+
+    uint64_t number = 0;
+    for (int i = 0; i < ID_KEY_DIGITS; i++){
+        if (id[i] < '0' || id[i] > '9') return 0;
+        number = number * 10 + (id[i] - '0');
+    }
+    if (id[ID_KEY_DIGITS] != '\0') return 0;
+
+    *key = number;
+    return 1;
+}
+
+int encode_id_key(const char* id, const char* prefix, uint64_t* key){
+    return encode_key(id, prefix, strlen(prefix), key);
+}
+
+/**
+ * @brief Slot of an ID in the array, or NULL if it isn't there.
+ */
+static struct id_map_slot* find_slot(ID_MAP map, const char* key){
+    uint64_t number;
+    if (!encode_key(key, map->prefix, map->prefix_length, &number) || number >= map->capacity) return NULL;
+
+    struct id_map_slot* slot = &map->slots[number];
+    return slot->key != NULL ? slot : NULL;
+}
+
+/**
+ * @brief Grow the array so that it has a slot for a number.
+ */
+static void grow(ID_MAP map, uint64_t number){
+    size_t capacity = map->capacity;
+    while (capacity <= number) capacity *= 2;
+
+    map->slots = realloc(map->slots, sizeof(struct id_map_slot) * capacity);
+    memset(map->slots + map->capacity, 0, sizeof(struct id_map_slot) * (capacity - map->capacity));
+    map->capacity = capacity;
+}
+
+ID_MAP create_id_map(const char* prefix, GDestroyNotify free_key, GDestroyNotify free_value){
+    ID_MAP new = malloc(sizeof(struct id_map));
+
+    new->prefix = prefix;
+    new->prefix_length = strlen(prefix);
+    new->capacity = ID_MAP_SLACK;
+    new->slots = calloc(new->capacity, sizeof(struct id_map_slot));
+    new->dense = 0;
+    new->fallback = create_string_map(free_key, free_value);
+    new->frozen = NULL;
+    new->free_key = free_key;
+    new->free_value = free_value;
+
+    return new;
+}
+
+void id_map_insert(ID_MAP map, char* key, void* value){
+    uint64_t number;
+    int dense = encode_key(key, map->prefix, map->prefix_length, &number) &&
+                (number < map->capacity || number < map->dense * 2 + ID_MAP_SLACK) &&
+                (string_map_size(map->fallback) == 0 || !string_map_contains(map->fallback, key));
+
+    if (!dense){
+        free_perfect_hash(map->frozen);
+        map->frozen = NULL;
+        string_map_insert(map->fallback, key, value);
+        return;
+    }
+
+    if (number >= map->capacity) grow(map, number);
+    struct id_map_slot* slot = &map->slots[number];
+
+    if (slot->key != NULL){
+        if (map->free_value != NULL && slot->value != value) map->free_value(slot->value);
+        if (map->free_key != NULL && slot->key != key) map->free_key(key);
+        slot->value = value;
+        return;
+    }
+
+    slot->key = key;
+    slot->value = value;
+    map->dense++;
+}
+
+void* id_map_lookup(ID_MAP map, const char* key){
+    struct id_map_slot* slot = find_slot(map, key);
+    if (slot != NULL) return slot->value;
+
+    if (string_map_size(map->fallback) == 0) return NULL;
+    if (map->frozen != NULL) return lookup_perfect_hash(map->frozen, key);
+    return string_map_lookup(map->fallback, key);
+}
+
+int id_map_remove(ID_MAP map, const char* key){
+    struct id_map_slot* slot = find_slot(map, key);
+
+    if (slot == NULL){
+        free_perfect_hash(map->frozen);
+        map->frozen = NULL;
+        return string_map_remove(map->fallback, key);
+    }
+
+    char* old_key = slot->key;
+    void* old_value = slot->value;
+    slot->key = NULL;
+    slot->value = NULL;
+    map->dense--;
+
+    if (map->free_key != NULL) map->free_key(old_key);
+    if (map->free_value != NULL) map->free_value(old_value);
+    return 1;
+}
+
+size_t id_map_size(ID_MAP map){
+    return map->dense + string_map_size(map->fallback);
+}
+
+void freeze_id_map(ID_MAP map){
+    free_perfect_hash(map->frozen);
+    map->frozen = create_perfect_hash(map->fallback);
+}
+
+void id_map_iter_init(ID_MAP_ITER* iter, ID_MAP map){
+    iter->map = map;
+    iter->index = 0;
+    string_map_iter_init(&iter->fallback, map->fallback);
+}
+
+int id_map_iter_next(ID_MAP_ITER* iter, void** key, void** value){
+    ID_MAP map = iter->map;
+
+    while (iter->index < map->capacity){
+        struct id_map_slot* slot = &map->slots[iter->index++];
+        if (slot->key == NULL) continue;
+
+        *key = slot->key;
+        *value = slot->value;
+        return 1;
+    }
+
+    return string_map_iter_next(&iter->fallback, key, value);
+}
+
+size_t id_map_memory(ID_MAP map){
+    size_t memory = sizeof(struct id_map) + sizeof(struct id_map_slot) * map->capacity + string_map_memory(map->fallback);
+    if (map->frozen != NULL) memory += perfect_hash_memory(map->frozen);
+    return memory;
+}
+
+void free_id_map(ID_MAP map){
+    for (size_t i = 0; i < map->capacity; i++){
+        if (map->slots[i].key == NULL) continue;
+        if (map->free_key != NULL) map->free_key(map->slots[i].key);
+        if (map->free_value != NULL) map->free_value(map->slots[i].value);
+    }
+
+    free_perfect_hash(map->frozen);
+    free_string_map(map->fallback);
+    free(map->slots);
+    free(map);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file index_builder.c
+ * @brief Two phase builder of reverse indexes from string keys to dense values.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/index_builder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct index_builder
+ * @brief A reverse index being built.
+ */
+struct index_builder {
+    STRING_MAP rows; /**< Maps each key to its row plus one. */
+    GPtrArray* keys; /**< Key of each row, borrowed from rows. */
+    GArray* edges; /**< The (row, value) edges recorded. */
+    int copy_keys; /**< Whether the keys are copied. */
+};
+
+/**
+ * @struct reverse_index
+ * @brief A reverse index.
+ */
+struct reverse_index {
+    STRING_MAP rows; /**< Maps each key to its row plus one. */
+    GPtrArray* keys; /**< Key of each row, borrowed from rows. */
+    ADJACENCY values; /**< Values of each row. */
+    int copy_keys; /**< Whether the keys are owned by the index. */
+};
+
+INDEX_BUILDER create_index_builder(int copy_keys){
+    INDEX_BUILDER new = malloc(sizeof(struct index_builder));
+
+    new->rows = create_string_map(copy_keys ? free : NULL, NULL);
+    new->keys = g_ptr_array_new();
+    new->edges = g_array_new(FALSE, FALSE, sizeof(ADJACENCY_EDGE));
+    new->copy_keys = copy_keys;
+
+    return new;
+}
+
+uint32_t add_index_key(INDEX_BUILDER builder, char* key){
+    uint32_t row = GPOINTER_TO_UINT(string_map_lookup(builder->rows, key));
+    if (row != 0) return row - 1;
+
+    char* owned = builder->copy_keys ? strdup(key) : key;
+    string_map_insert(builder->rows, owned, GUINT_TO_POINTER(builder->keys->len + 1));
+    g_ptr_array_add(builder->keys, owned);
+    return builder->keys->len - 1;
+}
+
+void add_index_row_edge(INDEX_BUILDER builder, uint32_t row, uint32_t value){
+    ADJACENCY_EDGE edge = {row, value};
+    g_array_append_val(builder->edges, edge);
+}
+
+uint32_t add_index_edge(INDEX_BUILDER builder, char* key, uint32_t value){
+    uint32_t row = add_index_key(builder, key);
+    add_index_row_edge(builder, row, value);
+    return row;
+}
+
+uint32_t get_index_builder_keys(INDEX_BUILDER builder){
+    return builder->keys->len;
+}
+
+REVERSE_INDEX build_reverse_index(INDEX_BUILDER builder){
+    REVERSE_INDEX new = malloc(sizeof(struct reverse_index));
+
+    new->rows = builder->rows;
+    new->keys = builder->keys;
+    new->values = create_adjacency(builder->keys->len, (ADJACENCY_EDGE*)builder->edges->data, builder->edges->len);
+    new->copy_keys = builder->copy_keys;
+
+    g_array_free(builder->edges, TRUE);
+    free(builder);
+    return new;
+}
+
+INDEX_BUILDER thaw_reverse_index(REVERSE_INDEX index){
+    INDEX_BUILDER new = malloc(sizeof(struct index_builder));
+
+    new->rows = index->rows;
+    new->keys = index->keys;
+    new->edges = g_array_sized_new(FALSE, FALSE, sizeof(ADJACENCY_EDGE), get_adjacency_edges(index->values));
+    new->copy_keys = index->copy_keys;
+
+    for (uint32_t row = 0; row < index->keys->len; row++){
+        uint32_t count;
+        const uint32_t* values = get_adjacency_row(index->values, row, &count);
+        for (uint32_t i = 0; i < count; i++){
+            ADJACENCY_EDGE edge = {row, values[i]};
+            g_array_append_val(new->edges, edge);
+        }
+    }
+
+    free_adjacency(index->values);
+    free(index);
+    return new;
+}
+
+void free_index_builder(INDEX_BUILDER builder){
+    if (builder == NULL) return;
+
+    g_array_free(builder->edges, TRUE);
+    g_ptr_array_free(builder->keys, TRUE);
+    free_string_map(builder->rows);
+    free(builder);
+}
+
+const uint32_t* get_reverse_index_values(REVERSE_INDEX index, const char* key, uint32_t* count){
+    uint32_t row = GPOINTER_TO_UINT(string_map_lookup(index->rows, key));
+    if (row == 0){
+        *count = 0;
+        return NULL;
+    }
+
+    return get_adjacency_row(index->values, row - 1, count);
+}
+
+const uint32_t* get_reverse_index_row(REVERSE_INDEX index, uint32_t row, uint32_t* count){
+    return get_adjacency_row(index->values, row, count);
+}
+
+char* get_reverse_index_key(REVERSE_INDEX index, uint32_t row){
+    return g_ptr_array_index(index->keys, row);
+}
+
+uint32_t get_reverse_index_keys(REVERSE_INDEX index){
+    return index->keys->len;
+}
+
+size_t get_reverse_index_edges(REVERSE_INDEX index){
+    return get_adjacency_edges(index->values);
+}
+
+void report_reverse_index_memory(REVERSE_INDEX index, MEMORY_REPORT report){
+    add_memory(report, MEMORY_BUCKETS, string_map_memory(index->rows));
+    add_memory(report, MEMORY_ARRAYS, ptr_array_memory(index->keys) + adjacency_memory(index->values));
+
+    if (index->copy_keys){
+        size_t strings = 0;
+        for (guint i = 0; i < index->keys->len; i++) strings += string_memory(g_ptr_array_index(index->keys, i));
+        add_memory(report, MEMORY_STRINGS, strings);
+    }
+}
+
+void free_reverse_index(REVERSE_INDEX index){
+    if (index == NULL) return;
+
+    free_adjacency(index->values);
+    g_ptr_array_free(index->keys, TRUE);
+    free_string_map(index->rows);
+    free(index);
+}
@@ -0,0 +1,167 @@
+/**
+ * @file memory_report.c
+ * @brief Breakdown of the memory used by the catalogs after a load.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/memory_report.h"
+#include "catalogs/manager_c.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+/**
+ * @brief Maximum number of catalogs in a report.
+ */
+#define MAX_CATALOGS 8
+
+/**
+ * @brief Size of the struct behind a GPtrArray (data, length, allocated size, reference count,
+ * flags and free function).
+ */
+#define PTR_ARRAY_STRUCT_SIZE 32
+
+/**
+ * @struct memory_catalog
+ * @brief The memory used by a catalog.
+ */
+struct memory_catalog {
+    const char* name; /**< Name of the catalog. */
+    long entities; /**< Number of entities. */
+    size_t bytes[MEMORY_N_KINDS]; /**< Bytes of each kind. */
+};
+
+/**
+ * @struct memory_report
+ * @brief The memory used by each catalog.
+ */
+struct memory_report {
+    struct memory_catalog catalogs[MAX_CATALOGS]; /**< The catalogs. */
+    int n; /**< Number of catalogs. */
+};
+
+MEMORY_REPORT create_memory_report(void){
+    MEMORY_REPORT report = calloc(1, sizeof(struct memory_report));
+    return report;
+}
+
+void begin_memory_catalog(MEMORY_REPORT report, const char* name, long entities){
+    if (report->n == MAX_CATALOGS) return;
+
+    struct memory_catalog* catalog = &report->catalogs[report->n++];
+    catalog->name = name;
+    catalog->entities = entities;
+}
+
+void add_memory(MEMORY_REPORT report, MEMORY_KIND kind, size_t bytes){
+    if (report->n > 0) report->catalogs[report->n - 1].bytes[kind] += bytes;
+}
+
+size_t string_memory(const char* string){
+    return string == NULL ? 0 : strlen(string) + 1;
+}
+
+size_t hash_table_memory(GHashTable* table){
+    size_t entries = g_hash_table_size(table);
+    size_t buckets = 8;
+    while (buckets < entries + entries / 3) buckets *= 2;
+
+    return buckets * (2 * sizeof(gpointer) + sizeof(guint));
+}
+
+size_t ptr_array_memory(GPtrArray* array){
+    size_t storage = 16;
+    while (storage < array->len * sizeof(gpointer)) storage *= 2;
+
+    return PTR_ARRAY_STRUCT_SIZE + storage;
+}
+
+void write_memory_report(MEMORY_REPORT report, FILE* file){
+    static const char* kinds[] = {"buckets", "structs", "strings", "arrays", "day counts"};
+    size_t totals[MEMORY_N_KINDS] = {0};
+    size_t total = 0;
+
+    fprintf(file, "%-14s %10s", "Catalog", "Entities");
+    for (int k = 0; k < MEMORY_N_KINDS; k++) fprintf(file, " %12s", kinds[k]);
+    fprintf(file, " %12s %12s\n", "total", "per entity");
+
+    for (int i = 0; i < report->n; i++){
+        struct memory_catalog* catalog = &report->catalogs[i];
+        size_t sum = 0;
+
+        fprintf(file, "%-14s %10ld", catalog->name, catalog->entities);
+        for (int k = 0; k < MEMORY_N_KINDS; k++){
+            fprintf(file, " %12zu", catalog->bytes[k]);
+            sum += catalog->bytes[k];
+            totals[k] += catalog->bytes[k];
+        }
+        total += sum;
+        fprintf(file, " %12zu %12.1f\n", sum, catalog->entities > 0 ? (double)sum / catalog->entities : 0);
+
+        // Average bytes of each kind per entity, where compaction would pay off
+        fprintf(file, "%-14s %10s", "", "per entity");
+        for (int k = 0; k < MEMORY_N_KINDS; k++){
+            fprintf(file, " %12.1f", catalog->entities > 0 ? (double)catalog->bytes[k] / catalog->entities : 0);
+        }
+        fprintf(file, "\n");
+    }
+
+    fprintf(file, "%-14s %10s", "Total", "");
+    for (int k = 0; k < MEMORY_N_KINDS; k++) fprintf(file, " %12zu", totals[k]);
+    fprintf(file, " %12zu\n", total);
+}
+
+void free_memory_report(MEMORY_REPORT report){
+    free(report);
+}
+
+int memory_report(char* pathD){
+    USERS_C users_catalog = create_user_c();
+    FLIGHTS_C flights_catalog = create_flight_c();
+    RESERV_C reservations_catalog = create_reservations_c();
+    PASS_C passengers_catalog = create_passengers_c();
+    MANAGER manager_catalog = create_manager_c(users_catalog,flights_catalog,reservations_catalog,passengers_catalog);
+
+    if (set_catalogs(manager_catalog,pathD) == -1){
+        printf("The provided dataset is not valid.\n");
+        free_manager_c(manager_catalog);
+        return -1;
+    }
+
+    MEMORY_REPORT report = create_memory_report();
+    report_manager_c_memory(manager_catalog, report);
+
+    struct rusage r_usage;
+    getrusage(RUSAGE_SELF, &r_usage);
+
+    write_memory_report(report, stdout);
+    printf("\nEstimated bytes requested, without allocator overhead. Peak resident memory: %ld KB\n", r_usage.ru_maxrss);
+
+    FILE* file = fopen(MEMORY_REPORT_PATH, "w");
+    if (file != NULL){
+        write_memory_report(report, file);
+        fprintf(file, "\nEstimated bytes requested, without allocator overhead. Peak resident memory: %ld KB\n", r_usage.ru_maxrss);
+        fclose(file);
+    }
+
+    free_memory_report(report);
+    free_manager_c(manager_catalog);
+
+    return 0;
+}
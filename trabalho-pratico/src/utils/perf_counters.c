@@ -0,0 +1,158 @@
+/**
+ * @file perf_counters.c
+ * @brief Hardware performance counters around the queries and the load phases.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/perf_counters.h"
+#include "utils/utils.h"
+
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#ifdef PERF
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * @brief File descriptor of each counter, -1 when it isn't counted.
+ */
+static int counters[PERF_N_EVENTS] = {-1, -1, -1, -1};
+
+/**
+ * @brief Why no counter is available, NULL when one is.
+ */
+static const char* unavailable = NULL;
+
+/**
+ * @brief Makes sure the counters are only opened once.
+ */
+static pthread_once_t opened = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Open a counter for every event, keeping the ones the kernel and the hardware allow.
+ */
+static void open_counters(void){
+#ifdef PERF
+    static const uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                       PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    int error = 0;
+
+    for (int i = 0; i < PERF_N_EVENTS; i++){
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        counters[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counters[i] == -1) error = errno;
+    }
+
+    for (int i = 0; i < PERF_N_EVENTS; i++) if (counters[i] != -1) return;
+
+    if (error == EACCES || error == EPERM) unavailable = "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+    else if (error == ENOSYS) unavailable = "perf_event_open isn't supported by the kernel";
+    else unavailable = "no hardware counters";
+#else
+    unavailable = "built without PERF=1";
+#endif
+}
+
+/**
+ * @brief Read the current value of every available counter.
+ */
+static void read_counters(uint64_t* values){
+    for (int i = 0; i < PERF_N_EVENTS; i++){
+        values[i] = 0;
+        if (counters[i] != -1 && read(counters[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t)) values[i] = 0;
+    }
+}
+
+int perf_event_available(PERF_EVENT event){
+    pthread_once(&opened, open_counters);
+    return counters[event] != -1;
+}
+
+const char* perf_counters_unavailable(void){
+    pthread_once(&opened, open_counters);
+    return unavailable;
+}
+
+void start_perf_sample(PERF_SAMPLE* sample){
+    pthread_once(&opened, open_counters);
+    // The counters are never reset, so that samples can be nested
+    read_counters(sample->values);
+    clock_gettime(CLOCK_MONOTONIC, &sample->start);
+}
+
+void end_perf_sample(PERF_SAMPLE* sample){
+    sample->seconds = elapsed_since(sample->start);
+
+    uint64_t values[PERF_N_EVENTS];
+    read_counters(values);
+    for (int i = 0; i < PERF_N_EVENTS; i++) sample->values[i] = values[i] - sample->values[i];
+}
+
+void add_perf_sample(PERF_SAMPLE* total, const PERF_SAMPLE* sample){
+    total->seconds += sample->seconds;
+    for (int i = 0; i < PERF_N_EVENTS; i++) total->values[i] += sample->values[i];
+}
+
+void write_perf_table(FILE* file, const char* title, const char** names, const PERF_SAMPLE* samples,
+                      const int* counts, int n){
+    static const char* events[] = {"cycles", "instructions", "cache misses", "branch misses"};
+
+    fprintf(file, "%s\n", title);
+    if (perf_counters_unavailable() != NULL){
+        fprintf(file, "Hardware counters unavailable (%s), timing only\n", perf_counters_unavailable());
+    }
+
+    fprintf(file, "%-12s %8s %12s", "", "Samples", "Time (s)");
+    for (int e = 0; e < PERF_N_EVENTS; e++) if (perf_event_available(e)) fprintf(file, " %14s", events[e]);
+    if (perf_event_available(PERF_CYCLES) && perf_event_available(PERF_INSTRUCTIONS)) fprintf(file, " %6s", "IPC");
+    fprintf(file, "\n");
+
+    for (int i = 0; i < n; i++){
+        if (counts[i] == 0) continue;
+
+        const PERF_SAMPLE* sample = &samples[i];
+        fprintf(file, "%-12s %8d %12.6f", names[i], counts[i], sample->seconds);
+        for (int e = 0; e < PERF_N_EVENTS; e++) if (perf_event_available(e)) fprintf(file, " %14lu", (unsigned long)sample->values[e]);
+        if (perf_event_available(PERF_CYCLES) && perf_event_available(PERF_INSTRUCTIONS)){
+            double cycles = sample->values[PERF_CYCLES];
+            fprintf(file, " %6.2f", cycles > 0 ? sample->values[PERF_INSTRUCTIONS] / cycles : 0);
+        }
+        fprintf(file, "\n");
+    }
+    fprintf(file, "\n");
+}
+
+void write_perf_json(FILE* file, const PERF_SAMPLE* sample){
+    static const char* events[] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+
+    for (int e = 0; e < PERF_N_EVENTS; e++){
+        if (perf_event_available(e)) fprintf(file, ", \"%s\": %lu", events[e], (unsigned long)sample->values[e]);
+        else fprintf(file, ", \"%s\": null", events[e]);
+    }
+}
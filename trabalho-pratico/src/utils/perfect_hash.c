@@ -0,0 +1,188 @@
+/**
+ * @file perfect_hash.c
+ * @brief Minimal perfect hash over the string keys of a map that no longer changes.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/perfect_hash.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Size of a cache line, the alignment of the slots.
+ */
+#define CACHE_LINE 64
+
+/**
+ * @struct perfect_hash_slot
+ * @brief A key and its value.
+ */
+struct perfect_hash_slot {
+    const char* key; /**< The key, borrowed from the map. */
+    void* value; /**< The value, borrowed from the map. */
+};
+
+/**
+ * @struct perfect_hash
+ * @brief A minimal perfect hash.
+ */
+struct perfect_hash {
+    size_t n; /**< Number of keys, and of slots and buckets. */
+    int32_t* displacements; /**< Seed of each bucket, the slot as -(slot + 1) for single keys, 0 when empty. */
+    struct perfect_hash_slot* slots; /**< The slots, aligned to a cache line. */
+    size_t slots_size; /**< Size of the slots in bytes. */
+};
+
+/**
+ * @brief Slot of a key hash in a bucket with a given seed.
+ */
+static size_t seeded_slot(uint64_t h, int32_t seed, size_t n){
+    h += (uint64_t)seed * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h % n;
+}
+
+PERFECT_HASH create_perfect_hash(STRING_MAP table){
+    PERFECT_HASH new = calloc(1, sizeof(struct perfect_hash));
+    size_t n = string_map_size(table);
+    new->n = n;
+    if (n == 0) return new;
+
+    const char** keys = malloc(sizeof(char*) * n);
+    void** values = malloc(sizeof(void*) * n);
+    uint64_t* hashes = malloc(sizeof(uint64_t) * n);
+
+    STRING_MAP_ITER iter;
+    void *key, *value;
+    size_t i = 0;
+    string_map_iter_init(&iter, table);
+    while (string_map_iter_next(&iter, &key, &value)){
+        keys[i] = key;
+        values[i] = value;
+        hashes[i] = hash_string_key(key);
+        i++;
+    }
+
+    // Group the keys by bucket
+    size_t* starts = calloc(n + 1, sizeof(size_t));
+    size_t* members = malloc(sizeof(size_t) * n);
+    for (i = 0; i < n; i++) starts[hashes[i] % n + 1]++;
+    size_t largest = 0;
+    for (i = 0; i < n; i++){
+        if (starts[i + 1] > largest) largest = starts[i + 1];
+        starts[i + 1] += starts[i];
+    }
+    size_t* fill = malloc(sizeof(size_t) * n);
+    memcpy(fill, starts, sizeof(size_t) * n);
+    for (i = 0; i < n; i++) members[fill[hashes[i] % n]++] = i;
+
+    // Order the buckets from the largest to the smallest
+    size_t* by_size = calloc(largest + 2, sizeof(size_t));
+    size_t* order = fill;
+    for (i = 0; i < n; i++) by_size[largest - (starts[i + 1] - starts[i]) + 1]++;
+    for (size_t s = 0; s <= largest; s++) by_size[s + 1] += by_size[s];
+    for (i = 0; i < n; i++) order[by_size[largest - (starts[i + 1] - starts[i])]++] = i;
+
+    new->slots_size = (sizeof(struct perfect_hash_slot) * n + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    new->slots = aligned_alloc(CACHE_LINE, new->slots_size);
+    memset(new->slots, 0, new->slots_size);
+    new->displacements = calloc(n, sizeof(int32_t));
+
+    char* occupied = calloc(n, 1);
+    size_t* taken = malloc(sizeof(size_t) * largest);
+    size_t next_free = 0;
+
+    for (size_t b = 0; b < n; b++){
+        size_t bucket = order[b];
+        size_t size = starts[bucket + 1] - starts[bucket];
+        size_t* bucket_keys = members + starts[bucket];
+        if (size == 0) break;
+
+        if (size == 1){
+            while (occupied[next_free]) next_free++;
+            occupied[next_free] = 1;
+            new->slots[next_free].key = keys[bucket_keys[0]];
+            new->slots[next_free].value = values[bucket_keys[0]];
+            new->displacements[bucket] = -(int32_t)next_free - 1;
+            continue;
+        }
+
+        // The first seed that sends every key of the bucket to a different free slot
+        for (int32_t seed = 1; ; seed++){
+            size_t k;
+            for (k = 0; k < size; k++){
+                taken[k] = seeded_slot(hashes[bucket_keys[k]], seed, n);
+                if (occupied[taken[k]]) break;
+
+                size_t j = 0;
+                while (j < k && taken[j] != taken[k]) j++;
+                if (j < k) break;
+            }
+            if (k < size) continue;
+
+            for (k = 0; k < size; k++){
+                occupied[taken[k]] = 1;
+                new->slots[taken[k]].key = keys[bucket_keys[k]];
+                new->slots[taken[k]].value = values[bucket_keys[k]];
+            }
+            new->displacements[bucket] = seed;
+            break;
+        }
+    }
+
+    free(keys);
+    free(values);
+    free(hashes);
+    free(starts);
+    free(members);
+    free(fill);
+    free(by_size);
+    free(occupied);
+    free(taken);
+
+    return new;
+}
+
+void* lookup_perfect_hash(PERFECT_HASH hash, const char* key){
+    if (hash->n == 0) return NULL;
+
+    uint64_t h = hash_string_key(key);
+    int32_t displacement = hash->displacements[h % hash->n];
+    if (displacement == 0) return NULL;
+
+    size_t slot = displacement < 0 ? (size_t)(-(displacement + 1)) : seeded_slot(h, displacement, hash->n);
+    struct perfect_hash_slot* entry = &hash->slots[slot];
+
+    return strcmp(entry->key, key) == 0 ? entry->value : NULL;
+}
+
+size_t perfect_hash_memory(PERFECT_HASH hash){
+    return sizeof(struct perfect_hash) + sizeof(int32_t) * hash->n + hash->slots_size;
+}
+
+void free_perfect_hash(PERFECT_HASH hash){
+    if (hash == NULL) return;
+
+    free(hash->displacements);
+    free(hash->slots);
+    free(hash);
+}
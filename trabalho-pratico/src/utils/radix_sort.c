@@ -0,0 +1,104 @@
+/**
+ * @file radix_sort.c
+ * @brief Stable LSD radix sort of packed two word keys, used to order query results.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/radix_sort.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Up to this many keys, they are sorted by insertion.
+ */
+#define RADIX_CUTOFF 32
+
+/**
+ * @brief Number of byte digits of a key, those of the secondary word first.
+ */
+#define RADIX_DIGITS 16
+
+/**
+ * @brief Byte digit d of a key, counting from the least significant byte of the secondary word.
+ */
+static inline unsigned key_digit(const RADIX_KEY* key, int d){
+    uint64_t word = d < 8 ? key->secondary : key->primary;
+    return (word >> ((d & 7) * 8)) & 0xFF;
+}
+
+/**
+ * @brief Whether a key goes strictly before another.
+ */
+static inline int key_less(const RADIX_KEY* a, const RADIX_KEY* b){
+    return a->primary < b->primary || (a->primary == b->primary && a->secondary < b->secondary);
+}
+
+/**
+ * @brief Stable insertion sort, for arrays too small for the counting passes to pay off.
+ */
+static void insertion_sort(RADIX_KEY* keys, size_t n){
+    for (size_t i = 1; i < n; i++){
+        RADIX_KEY key = keys[i];
+        size_t j = i;
+        while (j > 0 && key_less(&key, &keys[j - 1])){
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = key;
+    }
+}
+
+void radix_sort(RADIX_KEY* keys, size_t n){
+    if (n <= RADIX_CUTOFF){
+        insertion_sort(keys, n);
+        return;
+    }
+
+    // The histograms of every digit are counted in one pass and take 32 KB of stack
+    size_t counts[RADIX_DIGITS][256] = {{0}};
+    for (size_t i = 0; i < n; i++){
+        for (int d = 0; d < RADIX_DIGITS; d++) counts[d][key_digit(&keys[i], d)]++;
+    }
+
+    RADIX_KEY* from = keys;
+    RADIX_KEY* to = malloc(sizeof(RADIX_KEY) * n);
+    RADIX_KEY* scratch = to;
+
+    for (int d = 0; d < RADIX_DIGITS; d++){
+        size_t* count = counts[d];
+
+        // Every key has the same byte here, so the pass would leave the order as it is
+        if (count[key_digit(&from[0], d)] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++){
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) to[count[key_digit(&from[i], d)]++] = from[i];
+
+        RADIX_KEY* t = from;
+        from = to;
+        to = t;
+    }
+
+    if (from != keys) memcpy(keys, from, sizeof(RADIX_KEY) * n);
+    free(scratch);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file selection.c
+ * @brief Partial selection: the first K elements of an order and the median, without a full sort.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/selection.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Below this many elements a range is sorted instead of partitioned.
+ */
+#define SELECTION_CUTOFF 16
+
+/**
+ * @brief Swap two elements of a given size.
+ */
+static void swap_elements(char* a, char* b, size_t size){
+    while (size-- > 0){
+        char t = *a;
+        *a++ = *b;
+        *b++ = t;
+    }
+}
+
+/**
+ * @brief Partition a range around a median of three pivot.
+ *
+ * @return The final position of the pivot, with no greater element before it and no smaller one after it.
+ */
+static size_t partition(char* base, size_t lo, size_t hi, size_t size, int (*compare)(const void*, const void*)){
+    size_t mid = lo + (hi - lo) / 2;
+    if (compare(base + mid * size, base + lo * size) < 0) swap_elements(base + mid * size, base + lo * size, size);
+    if (compare(base + hi * size, base + lo * size) < 0) swap_elements(base + hi * size, base + lo * size, size);
+    if (compare(base + hi * size, base + mid * size) < 0) swap_elements(base + hi * size, base + mid * size, size);
+
+    // The median goes to the end of the range, as the pivot
+    swap_elements(base + mid * size, base + hi * size, size);
+    char* pivot = base + hi * size;
+
+    size_t store = lo;
+    for (size_t i = lo; i < hi; i++){
+        if (compare(base + i * size, pivot) < 0){
+            swap_elements(base + i * size, base + store * size, size);
+            store++;
+        }
+    }
+    swap_elements(base + store * size, pivot, size);
+    return store;
+}
+
+/**
+ * @brief Put the k-th element of a range in its sorted position, with no greater element before it.
+ */
+static void select_kth(char* base, size_t lo, size_t hi, size_t k, size_t size, int (*compare)(const void*, const void*)){
+    int depth = 0;
+    for (size_t m = hi - lo + 1; m > 1; m >>= 1) depth += 2;
+
+    while (hi > lo){
+        if (hi - lo < SELECTION_CUTOFF || depth-- == 0){
+            qsort(base + lo * size, hi - lo + 1, size, compare);
+            return;
+        }
+
+        size_t p = partition(base, lo, hi, size, compare);
+        if (p == k) return;
+        if (k < p) hi = p - 1;
+        else lo = p + 1;
+    }
+}
+
+void select_top_k(void* base, size_t n, size_t size, size_t k, int (*compare)(const void*, const void*)){
+    if (k == 0 || n == 0) return;
+    if (k < n) select_kth(base, 0, n - 1, k - 1, size, compare);
+    else k = n;
+
+    qsort(base, k, size, compare);
+}
+
+/**
+ * @brief Compare two integers, as for qsort.
+ */
+static int compare_ints(const void* a, const void* b){
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+int median_of_ints(int* values, size_t n){
+    if (n == 0) return 0;
+
+    size_t middle = n / 2;
+    select_kth((char*)values, 0, n - 1, middle, sizeof(int), compare_ints);
+    if (n % 2 != 0) return values[middle];
+
+    // The other middle value is the greatest of those before it
+    int lower = values[0];
+    for (size_t i = 1; i < middle; i++) if (values[i] > lower) lower = values[i];
+    return (lower + values[middle]) / 2;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file string_map.c
+ * @brief Open addressing hash map with string keys, used by the catalogs.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/string_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Number of slots whose control bytes are compared at once.
+ */
+#define GROUP 16
+
+/**
+ * @brief Control byte of a slot that was never used.
+ */
+#define CTRL_EMPTY 0x80
+
+/**
+ * @brief Control byte of a slot whose key was removed.
+ */
+#define CTRL_DELETED 0xFE
+
+/**
+ * @struct string_map_slot
+ * @brief A key and its value.
+ */
+struct string_map_slot {
+    char* key; /**< The key. */
+    void* value; /**< The value. */
+    uint64_t hash; /**< Hash of the key, so that growing the map doesn't hash the keys again. */
+};
+
+/**
+ * @struct string_map
+ * @brief A string map.
+ */
+struct string_map {
+    unsigned char* ctrl; /**< Control byte of each slot: the fingerprint of its key, CTRL_EMPTY or CTRL_DELETED. */
+    struct string_map_slot* slots; /**< The slots. */
+    size_t capacity; /**< Number of slots, a power of two and a multiple of GROUP. */
+    size_t size; /**< Number of keys. */
+    size_t deleted; /**< Number of slots marked CTRL_DELETED. */
+    GDestroyNotify free_key; /**< Frees a key, NULL when they are borrowed. */
+    GDestroyNotify free_value; /**< Frees a value, NULL when they are borrowed. */
+};
+
+uint64_t hash_string_key(const char* key){
+    size_t length = strlen(key);
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ length;
+
+    // Eight bytes at a time, then the remaining ones
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8){
+        uint64_t word;
+        memcpy(&word, key + i, 8);
+        h = (h ^ word) * 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, key + i, length - i);
+    h = (h ^ tail) * 0x94d049bb133111ebULL;
+
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief Bit mask of the slots of a group whose control byte is 'byte'.
+ */
+static unsigned match_byte(const unsigned char* group, unsigned char byte){
+#ifdef __SSE2__
+    __m128i ctrl = _mm_load_si128((const __m128i*)group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < GROUP; i++) mask |= (unsigned)(group[i] == byte) << i;
+    return mask;
+#endif
+}
+
+/**
+ * @brief Bit mask of the slots of a group that are empty or deleted, the only control bytes with the high bit set.
+ */
+static unsigned match_free(const unsigned char* group){
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_load_si128((const __m128i*)group));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < GROUP; i++) mask |= (unsigned)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/**
+ * @brief Allocate the slots and control bytes of a map, all empty.
+ */
+static void allocate_slots(STRING_MAP map, size_t capacity){
+    map->capacity = capacity;
+    map->ctrl = aligned_alloc(GROUP, capacity);
+    memset(map->ctrl, CTRL_EMPTY, capacity);
+    map->slots = malloc(sizeof(struct string_map_slot) * capacity);
+    map->deleted = 0;
+}
+
+/**
+ * @brief Find the slot of a key.
+ *
+ * The groups are probed from the one given by the hash, in triangular steps that visit every group,
+ * and the search ends at the first group with an empty slot.
+ *
+ * @return The slot, or -1 if the key isn't in the map.
+ */
+static long find_slot(STRING_MAP map, const char* key, uint64_t h){
+    size_t groups = map->capacity / GROUP;
+    size_t group = (h >> 7) & (groups - 1);
+    unsigned char fingerprint = h & 0x7F;
+
+    for (size_t probe = 1; probe <= groups; probe++){
+        const unsigned char* ctrl = map->ctrl + group * GROUP;
+
+        unsigned mask = match_byte(ctrl, fingerprint);
+        while (mask != 0){
+            size_t slot = group * GROUP + __builtin_ctz(mask);
+            if (map->slots[slot].hash == h && strcmp(map->slots[slot].key, key) == 0) return slot;
+            mask &= mask - 1;
+        }
+        if (match_byte(ctrl, CTRL_EMPTY) != 0) return -1;
+
+        group = (group + probe) & (groups - 1);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Find the first free slot for a key that isn't in the map.
+ */
+static size_t find_free_slot(STRING_MAP map, uint64_t h){
+    size_t groups = map->capacity / GROUP;
+    size_t group = (h >> 7) & (groups - 1);
+
+    for (size_t probe = 1; ; probe++){
+        unsigned mask = match_free(map->ctrl + group * GROUP);
+        if (mask != 0) return group * GROUP + __builtin_ctz(mask);
+        group = (group + probe) & (groups - 1);
+    }
+}
+
+/**
+ * @brief Move every key to new slots, dropping the deleted ones.
+ */
+static void resize(STRING_MAP map, size_t capacity){
+    unsigned char* old_ctrl = map->ctrl;
+    struct string_map_slot* old_slots = map->slots;
+    size_t old_capacity = map->capacity;
+
+    allocate_slots(map, capacity);
+
+    for (size_t i = 0; i < old_capacity; i++){
+        if (old_ctrl[i] & 0x80) continue;
+
+        uint64_t h = old_slots[i].hash;
+        size_t slot = find_free_slot(map, h);
+        map->ctrl[slot] = h & 0x7F;
+        map->slots[slot] = old_slots[i];
+    }
+
+    free(old_ctrl);
+    free(old_slots);
+}
+
+STRING_MAP create_string_map(GDestroyNotify free_key, GDestroyNotify free_value){
+    STRING_MAP new = malloc(sizeof(struct string_map));
+
+    new->size = 0;
+    new->free_key = free_key;
+    new->free_value = free_value;
+    allocate_slots(new, GROUP);
+
+    return new;
+}
+
+void string_map_insert(STRING_MAP map, char* key, void* value){
+    uint64_t h = hash_string_key(key);
+    long found = find_slot(map, key, h);
+
+    if (found != -1){
+        struct string_map_slot* slot = &map->slots[found];
+        if (map->free_value != NULL && slot->value != value) map->free_value(slot->value);
+        if (map->free_key != NULL && slot->key != key) map->free_key(key);
+        slot->value = value;
+        return;
+    }
+
+    // At most 7/8 of the slots are used, counting the deleted ones
+    if ((map->size + map->deleted + 1) * 8 > map->capacity * 7){
+        resize(map, (map->size + 1) * 2 > map->capacity ? map->capacity * 2 : map->capacity);
+    }
+
+    size_t slot = find_free_slot(map, h);
+    if (map->ctrl[slot] == CTRL_DELETED) map->deleted--;
+    map->ctrl[slot] = h & 0x7F;
+    map->slots[slot].key = key;
+    map->slots[slot].value = value;
+    map->slots[slot].hash = h;
+    map->size++;
+}
+
+void* string_map_lookup(STRING_MAP map, const char* key){
+    long slot = find_slot(map, key, hash_string_key(key));
+    return slot == -1 ? NULL : map->slots[slot].value;
+}
+
+int string_map_contains(STRING_MAP map, const char* key){
+    return find_slot(map, key, hash_string_key(key)) != -1;
+}
+
+int string_map_remove(STRING_MAP map, const char* key){
+    long slot = find_slot(map, key, hash_string_key(key));
+    if (slot == -1) return 0;
+
+    char* old_key = map->slots[slot].key;
+    void* old_value = map->slots[slot].value;
+
+    // A lookup never goes past a group with an empty slot, so one can be left empty again
+    const unsigned char* group = map->ctrl + slot / GROUP * GROUP;
+    if (match_byte(group, CTRL_EMPTY) != 0) map->ctrl[slot] = CTRL_EMPTY;
+    else {
+        map->ctrl[slot] = CTRL_DELETED;
+        map->deleted++;
+    }
+    map->size--;
+
+    if (map->free_key != NULL) map->free_key(old_key);
+    if (map->free_value != NULL) map->free_value(old_value);
+    return 1;
+}
+
+size_t string_map_size(STRING_MAP map){
+    return map->size;
+}
+
+void string_map_iter_init(STRING_MAP_ITER* iter, STRING_MAP map){
+    iter->map = map;
+    iter->index = 0;
+}
+
+int string_map_iter_next(STRING_MAP_ITER* iter, void** key, void** value){
+    STRING_MAP map = iter->map;
+
+    while (iter->index < map->capacity){
+        size_t i = iter->index++;
+        if (map->ctrl[i] & 0x80) continue;
+
+        *key = map->slots[i].key;
+        *value = map->slots[i].value;
+        return 1;
+    }
+
+    return 0;
+}
+
+size_t string_map_memory(STRING_MAP map){
+    return sizeof(struct string_map) + map->capacity * (1 + sizeof(struct string_map_slot));
+}
+
+void free_string_map(STRING_MAP map){
+    for (size_t i = 0; i < map->capacity; i++){
+        if (map->ctrl[i] & 0x80) continue;
+        if (map->free_key != NULL) map->free_key(map->slots[i].key);
+        if (map->free_value != NULL) map->free_value(map->slots[i].value);
+    }
+
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file trace.c
+ * @brief This file contains the implementation of the per-thread trace buffers and of the Chrome trace export.
+ */
+
+/*
+ *   Copyright 2023  Hugo Abelheira, Luís França, Mariana Rocha
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "utils/trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+/**
+ * @struct trace_event
+ * @brief A finished scope.
+ */
+struct trace_event {
+    const char* name; /**< Name of the scope. */
+    uint64_t start; /**< When the scope was entered, in nanoseconds. */
+    uint64_t duration; /**< How long the scope took, in nanoseconds. */
+};
+
+/**
+ * @struct trace_buffer
+ * @brief The ring buffer of a thread.
+ *
+ * Only its thread writes to it, so recording an event takes no lock. When the thread exits, the
+ * ring is replaced with an array holding just the events it kept.
+ */
+struct trace_buffer {
+    struct trace_event* events; /**< The events. */
+    uint64_t capacity; /**< Number of events that fit in 'events', TRACE_BUFFER_SIZE while the thread runs. */
+    uint64_t n_events; /**< Number of events ever recorded, the last 'capacity' are kept. */
+    int tid; /**< Identifier of the thread in the trace. */
+    struct trace_buffer* next; /**< Next buffer in the list of every thread. */
+};
+
+static __thread struct trace_buffer* thread_buffer = NULL;
+static struct trace_buffer* buffers = NULL;
+static int n_buffers = 0;
+static pthread_mutex_t buffers_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t buffer_key;
+static pthread_once_t buffer_key_once = PTHREAD_ONCE_INIT;
+
+uint64_t trace_now(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+/**
+ * @brief Shrink the buffer of a thread that exits to the events it kept, oldest first.
+ *
+ * The buffer stays in the list, so that its events are still written, but a server that starts a
+ * thread per client doesn't keep a whole ring per connection.
+ *
+ * @param arg The buffer.
+ */
+static void release_trace_buffer(void* arg){
+    struct trace_buffer* buffer = arg;
+    uint64_t n = buffer->n_events < buffer->capacity ? buffer->n_events : buffer->capacity;
+    uint64_t oldest = buffer->n_events - n;
+
+    struct trace_event* events = malloc(sizeof(struct trace_event) * (n + 1));
+    for (uint64_t i = oldest; i < buffer->n_events; i++) events[i - oldest] = buffer->events[i % buffer->capacity];
+
+    pthread_mutex_lock(&buffers_lock);
+    free(buffer->events);
+    buffer->events = events;
+    buffer->capacity = n;
+    buffer->n_events = n;
+    pthread_mutex_unlock(&buffers_lock);
+}
+
+/**
+ * @brief Create the key whose destructor releases the buffer of each thread.
+ */
+static void create_buffer_key(void){
+    pthread_key_create(&buffer_key, release_trace_buffer);
+}
+
+/**
+ * @brief Create the buffer of the calling thread and add it to the list of every thread.
+ *
+ * @return The buffer.
+ */
+static struct trace_buffer* create_trace_buffer(void){
+    struct trace_buffer* buffer = malloc(sizeof(struct trace_buffer));
+    buffer->events = malloc(sizeof(struct trace_event) * TRACE_BUFFER_SIZE);
+    buffer->capacity = TRACE_BUFFER_SIZE;
+    buffer->n_events = 0;
+
+    pthread_once(&buffer_key_once, create_buffer_key);
+    pthread_setspecific(buffer_key, buffer);
+
+    pthread_mutex_lock(&buffers_lock);
+    buffer->tid = ++n_buffers;
+    buffer->next = buffers;
+    buffers = buffer;
+    pthread_mutex_unlock(&buffers_lock);
+
+    return buffer;
+}
+
+void record_trace_event(const char* name, uint64_t start, uint64_t end){
+    if (thread_buffer == NULL) thread_buffer = create_trace_buffer();
+
+    struct trace_event* event = &thread_buffer->events[thread_buffer->n_events % TRACE_BUFFER_SIZE];
+    event->name = name;
+    event->start = start;
+    event->duration = end - start;
+    thread_buffer->n_events++;
+}
+
+void end_trace_scope(struct trace_scope* scope){
+    record_trace_event(scope->name, scope->start, trace_now());
+}
+
+int write_trace(const char* path){
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return -1;
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+
+    int first = 1;
+    pthread_mutex_lock(&buffers_lock);
+    for (struct trace_buffer* buffer = buffers; buffer != NULL; buffer = buffer->next){
+        uint64_t n = buffer->n_events < buffer->capacity ? buffer->n_events : buffer->capacity;
+        uint64_t oldest = buffer->n_events - n;
+
+        for (uint64_t i = oldest; i < buffer->n_events; i++){
+            struct trace_event* event = &buffer->events[i % buffer->capacity];
+            fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    first ? "" : ",\n", event->name, buffer->tid, event->start / 1e3, event->duration / 1e3);
+            first = 0;
+        }
+    }
+    pthread_mutex_unlock(&buffers_lock);
+
+    fprintf(file, "\n]}\n");
+
+    return fclose(file) == 0 ? 0 : -1;
+}
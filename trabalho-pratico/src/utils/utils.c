@@ -27,8 +27,147 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <glib.h>
+#include <pthread.h>
+
+/**
+ * @brief Index builds not yet written to the analysis file.
+ */
+static struct {
+    const char* index; /**< Name of the index. */
+    double elapsed; /**< Build time in seconds. */
+} index_builds[16];
+static int n_index_builds = 0;
+static pthread_mutex_t index_builds_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void log_index_build(const char* index, double elapsed){
+    pthread_mutex_lock(&index_builds_lock);
+    if (n_index_builds < 16){
+        index_builds[n_index_builds].index = index;
+        index_builds[n_index_builds].elapsed = elapsed;
+        n_index_builds++;
+    }
+    pthread_mutex_unlock(&index_builds_lock);
+}
+
+void write_index_builds(FILE* file){
+    pthread_mutex_lock(&index_builds_lock);
+    for (int i = 0; i < n_index_builds; i++){
+        fprintf(file, "Index built: %s\n", index_builds[i].index);
+        fprintf(file, "Build time: %.6f seconds\n\n", index_builds[i].elapsed);
+    }
+    n_index_builds = 0;
+    pthread_mutex_unlock(&index_builds_lock);
+}
+
+double elapsed_since(struct timespec start){
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Error files restored from the catalog snapshot, in the order they are saved.
+ */
+static const char* snapshot_error_files[] = {"Resultados/users_errors.csv", "Resultados/flights_errors.csv",
+                                             "Resultados/reservations_errors.csv", "Resultados/passengers_errors.csv"};
+
+int save_snapshot(MANAGER manager_catalog, char* path1){
+    SNAPSHOT_KEY keys[SNAPSHOT_N_FILES];
+    get_snapshot_keys(path1, keys, 1);
+
+    FILE* file = create_snapshot_file(keys);
+    if (file == NULL) return -1;
+
+    save_manager_c(manager_catalog, file);
+
+    for (int i = 0; i < 4; i++){
+        char* buffer = NULL;
+        size_t size = 0;
+        FILE* error_file = fopen(snapshot_error_files[i], "r");
+        if (error_file != NULL){
+            fseek(error_file, 0, SEEK_END);
+            size = ftell(error_file);
+            rewind(error_file);
+            buffer = malloc(size + 1);
+            size = fread(buffer, 1, size, error_file);
+            fclose(error_file);
+        }
+        write_snapshot_bytes(file, buffer, size);
+        free(buffer);
+    }
+
+    return close_snapshot_file(file);
+}
+
+int load_snapshot(MANAGER manager_catalog, char* path1){
+    SNAPSHOT snapshot = open_snapshot(path1);
+    if (snapshot == NULL) return -1;
+
+    // A flipped bit could otherwise leave every length valid and load wrong data
+    if (verify_snapshot(snapshot) == -1){
+        close_snapshot(snapshot);
+        return -2;
+    }
+
+    int result = load_manager_c(manager_catalog, snapshot);
+
+    for (int i = 0; i < 4 && result == 0; i++){
+        size_t size;
+        const char* data = read_snapshot_bytes(snapshot, &size);
+        FILE* error_file = fopen(snapshot_error_files[i], "w");
+        if (error_file != NULL){
+            if (data != NULL) fwrite(data, 1, size, error_file);
+            fclose(error_file);
+        }
+    }
+
+    if (close_snapshot(snapshot) == -1) result = -1;
+
+    return result == 0 ? 0 : -2;
+}
+
+/**
+ * @brief Freeze the IDs of the loaded catalogs into perfect hashes, when built with FREEZE=1.
+ *
+ * @param manager_catalog The catalog manager.
+ * @param profile The load profile, which gets a "freeze" phase.
+ */
+static void freeze_catalogs(MANAGER manager_catalog, LOAD_PROFILE profile){
+#ifdef FREEZE
+    LOAD_PHASE phase = begin_load_phase(profile, "freeze");
+    freeze_manager_c(manager_catalog);
+    end_load_phase(phase);
+#else
+    (void)manager_catalog;
+    (void)profile;
+#endif
+}
 
 int set_catalogs(MANAGER manager_catalog, char* path1){
+    LOAD_PROFILE profile = create_load_profile();
+
+    LOAD_PHASE phase;
+    int snapshot = -1;
+
+    if (is_snapshot_enabled()){
+        phase = begin_load_phase(profile, "snapshot load");
+        snapshot = load_snapshot(manager_catalog, path1);
+        end_load_phase(phase);
+    }
+
+    if (snapshot == 0){
+        freeze_catalogs(manager_catalog, profile);
+        write_load_profile(profile, LOAD_PROFILE_PATH);
+        free_load_profile(profile);
+        return 0;
+    }
+    if (snapshot == -2){
+        // The catalogs may hold part of the snapshot, so the CSV files are loaded into new ones
+        fprintf(stderr, "Corrupted catalog snapshot, removing %s and loading the CSV files\n", SNAPSHOT_PATH);
+        remove(SNAPSHOT_PATH);
+        reset_manager_c(manager_catalog);
+    }
+
     FILE *flights_file, *passengers_file, *users_file, *reservations_file;
     FILE *flights_error_file, *passengers_error_file, *users_error_file, *reservations_error_file;
 
@@ -50,12 +189,22 @@ int set_catalogs(MANAGER manager_catalog, char* path1){
     reservations_error_file = fopen("Resultados/reservations_errors.csv", "w");
 
     USERS_C users = get_users_c(manager_catalog);
-    parseF(users_file, 12, build_user, users, users_error_file);
+    phase = begin_load_phase(profile, "users");
+    parseF(users_file, 12, verify_user, build_user, users, users_error_file, phase);
+    end_load_phase(phase);
 
     FLIGHTS_C flights = get_flights_c(manager_catalog);
-    parseF(flights_file, 13, build_flight, flights, flights_error_file);
-    parseF(reservations_file, 14, build_reservations, manager_catalog, reservations_error_file);
-    parseF(passengers_file, 2, build_passengers, manager_catalog, passengers_error_file);
+    phase = begin_load_phase(profile, "flights");
+    parseF(flights_file, 13, verify_flight, build_flight, flights, flights_error_file, phase);
+    end_load_phase(phase);
+
+    phase = begin_load_phase(profile, "reservations");
+    parseF(reservations_file, 14, verify_reservations, build_reservations, manager_catalog, reservations_error_file, phase);
+    end_load_phase(phase);
+
+    phase = begin_load_phase(profile, "passengers");
+    parseF(passengers_file, 2, verify_passengers, build_passengers, manager_catalog, passengers_error_file, phase);
+    end_load_phase(phase);
 
     free(flight_path);
     free(passenger_path);
@@ -86,6 +235,17 @@ int set_catalogs(MANAGER manager_catalog, char* path1){
     fclose(users_error_file);
     fclose(reservations_error_file);
 
+    // Only reached when the snapshot is missing, stale or corrupted
+    if (is_snapshot_enabled()){
+        phase = begin_load_phase(profile, "snapshot save");
+        save_snapshot(manager_catalog, path1);
+        end_load_phase(phase);
+    }
+
+    freeze_catalogs(manager_catalog, profile);
+    write_load_profile(profile, LOAD_PROFILE_PATH);
+    free_load_profile(profile);
+
     return 0;
 }
 
@@ -267,6 +427,22 @@ int get_number_of_nights(RESERV reserv){
 
 }
 
+long long pack_date(char* date){
+    long long packed = 0;
+    for (int i = 0; i < 10; i++){
+        if (isDigit(date[i])) packed = packed * 10 + (date[i] - '0');
+    }
+    return packed;
+}
+
+long long pack_datetime(char* date){
+    long long packed = pack_date(date);
+    for (int i = 11; i < 19; i++){
+        if (isDigit(date[i])) packed = packed * 10 + (date[i] - '0');
+    }
+    return packed;
+}
+
 char* int_to_string(int number){
     char* result = malloc(20 * sizeof(char));
     snprintf(result, 20, "%d", number);